@@ -1,6 +1,9 @@
 #include "pch.h"
 
+#include <cmath>
+
 #include "ActionExpression.h"
+#include "SimdMath.h"
 
 namespace FieaGameEngine
 {
@@ -26,6 +29,7 @@ namespace FieaGameEngine
 	void ActionExpression::SetExpression(const std::string& expression)
 	{
 		_expression = expression;
+		Compile();
 	}
 
 	const std::string& ActionExpression::Expression() const
@@ -35,7 +39,43 @@ namespace FieaGameEngine
 
 	int ActionExpression::Result() const
 	{
-		return _result;
+		if (_result.Type != Datum::DatumType::Integer)
+		{
+			throw runtime_error("Result is not an Integer");
+		}
+		return _result.Integer;
+	}
+
+	Datum::DatumType ActionExpression::ResultType() const
+	{
+		return _result.Type;
+	}
+
+	float ActionExpression::FloatResult() const
+	{
+		if (_result.Type != Datum::DatumType::Float)
+		{
+			throw runtime_error("Result is not a Float");
+		}
+		return _result.Float;
+	}
+
+	const glm::vec4& ActionExpression::VectorResult() const
+	{
+		if (_result.Type != Datum::DatumType::Vector)
+		{
+			throw runtime_error("Result is not a Vector");
+		}
+		return _result.Vector;
+	}
+
+	const glm::mat4& ActionExpression::MatrixResult() const
+	{
+		if (_result.Type != Datum::DatumType::Matrix)
+		{
+			throw runtime_error("Result is not a Matrix");
+		}
+		return _result.Matrix;
 	}
 
 	typename gsl::owner<ActionExpression*> ActionExpression::Clone() const
@@ -50,228 +90,418 @@ namespace FieaGameEngine
 			throw runtime_error("Empty expression");
 		}
 
-		Vector<std::string> tokenVector;
-		Stack<std::pair<std::string, int>> operatorStack;
-		Vector<std::string> outputQueue;
-		Stack<int> valueStack;
+		// The expression may have been written through its Datum (e.g. when loaded from Json)
+		if (!_isCompiled)
+		{
+			Compile();
+		}
 
-		// Separate Tokens by spaces into Token Vector
-		string expressionToken;
-		for (const char& c : _expression)
+		// The value stack was reserved to the program's depth when compiling, so this never allocates
+		_valueStack.Clear();
+		for (const Instruction& instruction : _program)
 		{
-			if (c == ' ')
+			switch (instruction.Type)
 			{
-				tokenVector.PushBack(expressionToken);
-				expressionToken = ""s;
+				case InstructionType::Operand:
+					_valueStack.PushBack(Load(ResolveOperand(instruction.Slot)));
+					break;
+
+				case InstructionType::Operator:
+				{
+					const size_t top = _valueStack.Size() - 1;
+					Apply(instruction.Code, _valueStack[top - 1], _valueStack[top]);
+					_valueStack.PopBack();
+					break;
+				}
+
+				case InstructionType::AssignOperator:
+				{
+					// Assignments always target the first operand of the expression
+					const size_t top = _valueStack.Size() - 1;
+					Datum& target = ResolveOperand(0_z);
+					Value value = Load(target);
+					Apply(instruction.Code, value, _valueStack[top]);
+					Store(target, value);
+					_valueStack[top - 1] = value;
+					_valueStack.PopBack();
+					break;
+				}
+
+				default:
+					assert(false);
 			}
-			else
+		}
+
+		_result = _valueStack.Back();
+	}
+
+	const ActionExpression::OperatorInfo* ActionExpression::FindOperator(std::string_view token)
+	{
+		for (const OperatorInfo& info : _operatorTable)
+		{
+			if (info.Token == token)
 			{
-				expressionToken += c;
+				return &info;
 			}
 		}
-		tokenVector.PushBack(expressionToken);
+		return nullptr;
+	}
 
-		// The Shunting Yard Algorithm
-		HashMap<string, int>::ConstIterator operatorMapIterator;
-		HashMap<string, int>::ConstIterator operatorMapEnd = _operators.end();
-		HashMap<string, int>::ConstIterator finalOperatorVectorIterator;
-		HashMap<string, int>::ConstIterator finalOperatorVectorEnd = _finalOperators.end();
+	void ActionExpression::Apply(OpCode code, Value& lhs, const Value& rhs)
+	{
+		using DatumType = Datum::DatumType;
 
-		string operatorString = "";
-		for (const string& token : tokenVector)
+		const bool lhsIsScalar = lhs.Type == DatumType::Integer || lhs.Type == DatumType::Float;
+		const bool rhsIsScalar = rhs.Type == DatumType::Integer || rhs.Type == DatumType::Float;
+
+		if (code == OpCode::Assign)
 		{
-			operatorMapIterator = _operators.Find(token);
-			finalOperatorVectorIterator = _finalOperators.Find(token);
-			if (operatorMapIterator != operatorMapEnd)
+			lhs = rhs;
+		}
+		else if (lhsIsScalar && rhsIsScalar)
+		{
+			ApplyScalar(code, lhs, rhs);
+		}
+		else if (code == OpCode::Equals || code == OpCode::NotEquals)
+		{
+			if (lhs.Type != rhs.Type)
 			{
-				while ((!operatorStack.IsEmpty()) && (operatorMapIterator->second <= operatorStack.Top().second))
-				{
-					outputQueue.PushBack(operatorStack.Top().first);
-					operatorStack.Pop();
-				}
-
-				operatorStack.Push(*operatorMapIterator);
+				throw runtime_error("Cannot compare operands of different types");
 			}
-			else if (finalOperatorVectorIterator != finalOperatorVectorEnd)
+
+			const bool isEqual = lhs.Type == DatumType::Vector ? lhs.Vector == rhs.Vector : lhs.Matrix == rhs.Matrix;
+			lhs.Type = DatumType::Integer;
+			lhs.Integer = (isEqual == (code == OpCode::Equals));
+		}
+		else if (lhs.Type == DatumType::Vector && rhs.Type == DatumType::Vector && code != OpCode::Mod)
+		{
+			switch (code)
 			{
-				operatorString = token;
+				case OpCode::Add:
+					lhs.Vector = SimdMath::Add(lhs.Vector, rhs.Vector);
+					break;
+				case OpCode::Subtract:
+					lhs.Vector = SimdMath::Subtract(lhs.Vector, rhs.Vector);
+					break;
+				case OpCode::Multiply:
+					lhs.Vector = SimdMath::Multiply(lhs.Vector, rhs.Vector);
+					break;
+				default:
+					lhs.Vector = SimdMath::Divide(lhs.Vector, rhs.Vector);
+					break;
 			}
-			else if (token == "(")
+		}
+		else if (lhs.Type == DatumType::Matrix && rhs.Type == DatumType::Matrix && (code == OpCode::Add || code == OpCode::Subtract || code == OpCode::Multiply))
+		{
+			switch (code)
 			{
-				operatorStack.Push(make_pair("(", -1));
+				case OpCode::Add:
+					lhs.Matrix = SimdMath::Add(lhs.Matrix, rhs.Matrix);
+					break;
+				case OpCode::Subtract:
+					lhs.Matrix = SimdMath::Subtract(lhs.Matrix, rhs.Matrix);
+					break;
+				default:
+					lhs.Matrix = SimdMath::Multiply(lhs.Matrix, rhs.Matrix);
+					break;
 			}
-			else if (token == ")")
+		}
+		else if (lhs.Type == DatumType::Matrix && rhs.Type == DatumType::Vector && code == OpCode::Multiply)
+		{
+			lhs.Vector = SimdMath::Multiply(lhs.Matrix, rhs.Vector);
+			lhs.Type = DatumType::Vector;
+		}
+		else if (lhsIsScalar != rhsIsScalar && (code == OpCode::Multiply || (code == OpCode::Divide && rhsIsScalar)))
+		{
+			// Scaling a Vector or Matrix by a scalar, in either order (dividing only by a scalar)
+			const Value& scalar = lhsIsScalar ? lhs : rhs;
+			float factor = scalar.Type == DatumType::Integer ? static_cast<float>(scalar.Integer) : scalar.Float;
+			if (code == OpCode::Divide)
 			{
-				while (operatorStack.Top().first != "(")
-				{
-					outputQueue.PushBack(operatorStack.Top().first);
-					operatorStack.Pop();
-
-					if (operatorStack.IsEmpty())
-					{
-						throw runtime_error("Left Parentheses Not Found");
-					}
-				}
+				factor = 1.0f / factor;
+			}
 
-				operatorStack.Pop();
+			Value result = lhsIsScalar ? rhs : lhs;
+			if (result.Type == DatumType::Vector)
+			{
+				result.Vector = SimdMath::Scale(result.Vector, factor);
 			}
 			else
 			{
-				outputQueue.PushBack(token);
+				result.Matrix = SimdMath::Scale(result.Matrix, factor);
 			}
+			lhs = result;
+		}
+		else
+		{
+			throw runtime_error("Operator cannot be applied to these operand types");
 		}
+	}
 
-		while (!operatorStack.IsEmpty())
+	void ActionExpression::ApplyScalar(OpCode code, Value& lhs, const Value& rhs)
+	{
+		using DatumType = Datum::DatumType;
+
+		if (lhs.Type == DatumType::Integer && rhs.Type == DatumType::Integer)
 		{
-			outputQueue.PushBack(operatorStack.Top().first);
-			operatorStack.Pop();
+			switch (code)
+			{
+				case OpCode::Add:
+					lhs.Integer += rhs.Integer;
+					break;
+				case OpCode::Subtract:
+					lhs.Integer -= rhs.Integer;
+					break;
+				case OpCode::Multiply:
+					lhs.Integer *= rhs.Integer;
+					break;
+				case OpCode::Divide:
+					lhs.Integer /= rhs.Integer;
+					break;
+				case OpCode::Mod:
+					lhs.Integer %= rhs.Integer;
+					break;
+				case OpCode::Equals:
+					lhs.Integer = lhs.Integer == rhs.Integer;
+					break;
+				case OpCode::NotEquals:
+					lhs.Integer = lhs.Integer != rhs.Integer;
+					break;
+				default:
+					assert(false);
+			}
+			return;
 		}
 
-		if (operatorString != "")
+		// Integers mixed with floats are promoted to float
+		const float left = lhs.Type == DatumType::Integer ? static_cast<float>(lhs.Integer) : lhs.Float;
+		const float right = rhs.Type == DatumType::Integer ? static_cast<float>(rhs.Integer) : rhs.Float;
+		lhs.Type = DatumType::Float;
+		switch (code)
 		{
-			outputQueue.PushBack(operatorString);
+			case OpCode::Add:
+				lhs.Float = left + right;
+				break;
+			case OpCode::Subtract:
+				lhs.Float = left - right;
+				break;
+			case OpCode::Multiply:
+				lhs.Float = left * right;
+				break;
+			case OpCode::Divide:
+				lhs.Float = left / right;
+				break;
+			case OpCode::Mod:
+				lhs.Float = std::fmod(left, right);
+				break;
+			case OpCode::Equals:
+				lhs.Type = DatumType::Integer;
+				lhs.Integer = left == right;
+				break;
+			case OpCode::NotEquals:
+				lhs.Type = DatumType::Integer;
+				lhs.Integer = left != right;
+				break;
+			default:
+				assert(false);
 		}
+	}
 
-		tokenVector.Clear();
+	ActionExpression::Value ActionExpression::Load(const Datum& datum)
+	{
+		if (datum.IsEmpty())
+		{
+			throw runtime_error("Attribute has no value");
+		}
 
-		// Reverse Polish
-		Datum* foundDatum = nullptr;
-		Datum* cachedDatum = nullptr;
-		ExpressionFunction func = nullptr;
-		ExpressionAssignFunction assignFunc = nullptr;
-		for (string token : outputQueue)
+		// The type and size are checked once above, the typed reads skip the per-get checks
+		Value value;
+		value.Type = datum.Type();
+		switch (datum.Type())
 		{
-			operatorMapIterator = _operators.Find(token);
-			finalOperatorVectorIterator = _finalOperators.Find(token);
-			if (operatorMapIterator != operatorMapEnd)
-			{
-				func = _expressionFunctionMap.Find(token)->second;
-				assert(func != nullptr);
+			case Datum::DatumType::Integer:
+				value.Integer = datum.TypedRef<int>().Front();
+				break;
+			case Datum::DatumType::Float:
+				value.Float = datum.TypedRef<float>().Front();
+				break;
+			case Datum::DatumType::Vector:
+				value.Vector = datum.TypedRef<glm::vec4>().Front();
+				break;
+			case Datum::DatumType::Matrix:
+				value.Matrix = datum.TypedRef<glm::mat4>().Front();
+				break;
+			default:
+				throw runtime_error("Attribute type cannot be used in an expression");
+		}
+		return value;
+	}
 
-				int rhs = valueStack.Top();
-				valueStack.Pop();
-				int lhs = valueStack.Top();
-				valueStack.Pop();
+	void ActionExpression::Store(Datum& datum, Value& value)
+	{
+		// Integers may be assigned to Float attributes, every other assignment must match the type
+		if (datum.Type() == Datum::DatumType::Float && value.Type == Datum::DatumType::Integer)
+		{
+			value.Float = static_cast<float>(value.Integer);
+			value.Type = Datum::DatumType::Float;
+		}
 
-				valueStack.Push((*this.*func)(lhs, rhs));
-			}
-			else if (finalOperatorVectorIterator != finalOperatorVectorEnd)
-			{
-				if (token == "==" or token == "!=")
-				{
-					func = _expressionFunctionMap.Find(token)->second;
-					assert(func != nullptr);
+		if (datum.Type() != value.Type)
+		{
+			throw runtime_error("Cannot assign a value of a different type to the attribute");
+		}
 
-					int rhs = valueStack.Top();
-					valueStack.Pop();
-					int lhs = valueStack.Top();
-					valueStack.Pop();
+		switch (value.Type)
+		{
+			case Datum::DatumType::Integer:
+				datum.TypedRef<int>().Front() = value.Integer;
+				break;
+			case Datum::DatumType::Float:
+				datum.TypedRef<float>().Front() = value.Float;
+				break;
+			case Datum::DatumType::Vector:
+				datum.TypedRef<glm::vec4>().Front() = value.Vector;
+				break;
+			default:
+				datum.TypedRef<glm::mat4>().Front() = value.Matrix;
+				break;
+		}
+	}
 
-					valueStack.Push((*this.*func)(lhs, rhs));
-				}
-				else
-				{
-					assignFunc = _expressionAssignFunctionMap.Find(token)->second;
-					assert(assignFunc != nullptr);
+	void ActionExpression::Compile()
+	{
+		_program.Clear();
+		_operands.Clear();
+		_valueStack.Clear();
+		_isCompiled = false;
 
-					int rhs = valueStack.Top();
-					valueStack.Pop();
-					int& lhs = cachedDatum->GetInteger();
-					valueStack.Pop();
+		if (_expression == "")
+		{
+			return;
+		}
 
+		// The Shunting Yard Algorithm over space separated tokens, emitting instructions
+		// instead of an output queue. A nullptr on the operator stack is a left parenthesis.
+		Vector<const OperatorInfo*> operatorStack;
+		const OperatorInfo* finalOperator = nullptr;
+		size_t depth = 0_z;
+		size_t maxDepth = 0_z;
 
-					valueStack.Push((*this.*assignFunc)(lhs, rhs));
-				}
-			}
-			else
-			{
-				foundDatum = Search(token);
+		const std::string_view expression = _expression;
+		size_t tokenBegin = 0_z;
+		while (tokenBegin <= expression.size())
+		{
+			size_t tokenEnd = std::min(expression.find(' ', tokenBegin), expression.size());
+			const std::string_view token = expression.substr(tokenBegin, tokenEnd - tokenBegin);
+			tokenBegin = tokenEnd + 1;
 
-				if (foundDatum == nullptr)
+			const OperatorInfo* info = FindOperator(token);
+			if (info != nullptr && !info->IsFinal)
+			{
+				while ((!operatorStack.IsEmpty()) && operatorStack.Back() != nullptr && (info->Precedence <= operatorStack.Back()->Precedence))
 				{
-					throw runtime_error("Attribute was not Found, make sure it's correct.");
+					EmitOperator(*operatorStack.Back(), depth);
+					operatorStack.PopBack();
 				}
 
-				if (cachedDatum == nullptr)
+				operatorStack.PushBack(info);
+			}
+			else if (info != nullptr)
+			{
+				finalOperator = info;
+			}
+			else if (token == "(")
+			{
+				operatorStack.PushBack(nullptr);
+			}
+			else if (token == ")")
+			{
+				while (operatorStack.IsEmpty() || operatorStack.Back() != nullptr)
 				{
-					cachedDatum = foundDatum;
+					if (operatorStack.IsEmpty())
+					{
+						throw runtime_error("Left Parentheses Not Found");
+					}
+
+					EmitOperator(*operatorStack.Back(), depth);
+					operatorStack.PopBack();
 				}
 
-				valueStack.Push(foundDatum->GetInteger());
+				operatorStack.PopBack();
+			}
+			else
+			{
+				EmitOperand(token);
+				maxDepth = std::max(maxDepth, ++depth);
 			}
 		}
 
-		_result = valueStack.Top();
-	}
-
-	int ActionExpression::Add(int lhs, int rhs)
-	{
-		return (lhs + rhs);
-	}
-
-	int ActionExpression::Subtract(int lhs, int rhs)
-	{
-		return (lhs - rhs);
-	}
+		while (!operatorStack.IsEmpty())
+		{
+			if (operatorStack.Back() == nullptr)
+			{
+				throw runtime_error("Right Parentheses Not Found");
+			}
 
-	int ActionExpression::Multiply(int lhs, int rhs)
-	{
-		return (lhs * rhs);
-	}
+			EmitOperator(*operatorStack.Back(), depth);
+			operatorStack.PopBack();
+		}
 
-	int ActionExpression::Divide(int lhs, int rhs)
-	{
-		return (lhs / rhs);
-	}
+		if (finalOperator != nullptr)
+		{
+			EmitOperator(*finalOperator, depth);
+		}
 
-	int ActionExpression::Mod(int lhs, int rhs)
-	{
-		return (lhs % rhs);
-	}
+		if (depth == 0_z)
+		{
+			throw runtime_error("Expression has no operands");
+		}
 
-	int ActionExpression::Equals(int lhs, int rhs)
-	{
-		return (lhs == rhs);
+		_valueStack.Reserve(maxDepth);
+		_isCompiled = true;
 	}
 
-	int ActionExpression::NotEquals(int lhs, int rhs)
+	void ActionExpression::EmitOperand(std::string_view token)
 	{
-		return (lhs != rhs);
-	}
+		Symbol name(token);
 
-	int ActionExpression::Assign(int& lhs, int rhs)
-	{
-		lhs = rhs;
-		return lhs;
-	}
+		// Repeated operands share a slot, so each attribute is searched once per Update
+		size_t slot = 0_z;
+		for (; slot < _operands.Size(); ++slot)
+		{
+			if (_operands[slot].Name == name)
+			{
+				break;
+			}
+		}
 
-	int ActionExpression::AddAssign(int& lhs, int rhs)
-	{
-		lhs += rhs;
-		return lhs;
-	}
+		if (slot == _operands.Size())
+		{
+			_operands.PushBack(Operand{ std::move(name), CachedSearch() });
+		}
 
-	int ActionExpression::SubtractAssign(int& lhs, int rhs)
-	{
-		lhs -= rhs;
-		return lhs;
+		_program.PushBack(Instruction{ InstructionType::Operand, OpCode::None, static_cast<std::uint32_t>(slot) });
 	}
 
-	int ActionExpression::MultiplyAssign(int& lhs, int rhs)
+	void ActionExpression::EmitOperator(const OperatorInfo& info, size_t& depth)
 	{
-		lhs *= rhs;
-		return lhs;
-	}
+		if (depth < 2_z)
+		{
+			throw runtime_error("Operator is missing an operand");
+		}
+		--depth;
 
-	int ActionExpression::DivideAssign(int& lhs, int rhs)
-	{
-		lhs /= rhs;
-		return lhs;
+		_program.PushBack(Instruction{ info.Type, info.Code, 0 });
 	}
 
-	int ActionExpression::ModAssign(int& lhs, int rhs)
+	Datum& ActionExpression::ResolveOperand(size_t slot)
 	{
-		lhs = lhs % rhs;
-		return lhs;
+		Operand& operand = _operands[slot];
+		Datum* datum = operand.Search.Search(*this, operand.Name);
+		if (datum == nullptr)
+		{
+			throw runtime_error("Attribute was not Found, make sure it's correct.");
+		}
+		return *datum;
 	}
 }
@@ -1,20 +1,27 @@
 #pragma once
 
+#include <string_view>
+
 #include "IAction.h"
-#include "Stack.h"
+#include "CachedSearch.h"
 
 namespace FieaGameEngine
 {
 	/// <summary>
 	/// Action Expression is the Action class that is able to take in a string in the form of a
-	/// mathematical expression and do the correct and corresponding expression using int. It does 
-	/// all the computations on attributes that it must search to fulfil the expression. It must use
-	/// int and returns an int. If the result is meant to be a bool you can cast it to a bool as the
-	/// result will be either 1 or 0. Each Attribute must be separated by a space.
+	/// mathematical expression and do the correct and corresponding expression. It does 
+	/// all the computations on attributes that it must search to fulfil the expression. Attributes
+	/// may be Integer, Float, Vector or Matrix; integers mixed with floats are promoted to float,
+	/// vectors and matrices may be scaled by scalars and matrices may multiply vectors. Comparisons
+	/// result in an int that is either 1 or 0. Each Attribute must be separated by a space.
+	/// The expression is compiled into reverse polish bytecode once, when it is set (or by the first
+	/// Update when it was written through its Datum, e.g. loaded from Json), so Update only runs the
+	/// bytecode over cached operands. Changing a compiled expression must go through SetExpression.
 	/// </summary>
 	class ActionExpression final : public IAction
 	{
 		RTTI_DECLARATIONS(ActionExpression, IAction)
+		friend class ExpressionBatch;
 
 	public:
 		/// <summary>
@@ -28,9 +35,10 @@ namespace FieaGameEngine
 		~ActionExpression() = default;
 
 		/// <summary>
-		/// Sets the expression of the action to fulfil
+		/// Sets the expression of the action to fulfil and compiles it.
 		/// </summary>
 		/// <param name="expression">new expression</param>
+		/// <exception cref="runtime_error">Expression is malformed</exception>
 		void SetExpression(const std::string& expression);
 		/// <summary>
 		/// Expression being fulfilled by this Action
@@ -42,7 +50,31 @@ namespace FieaGameEngine
 		/// Retrieves the result of the latest expression that was performed.
 		/// </summary>
 		/// <returns>result of the expression.</returns>
+		/// <exception cref="runtime_error">Result is not an Integer</exception>
 		int Result() const;
+		/// <summary>
+		/// Type of the result of the latest expression that was performed.
+		/// </summary>
+		/// <returns>Integer, Float, Vector or Matrix</returns>
+		Datum::DatumType ResultType() const;
+		/// <summary>
+		/// Retrieves the Float result of the latest expression that was performed.
+		/// </summary>
+		/// <returns>result of the expression.</returns>
+		/// <exception cref="runtime_error">Result is not a Float</exception>
+		float FloatResult() const;
+		/// <summary>
+		/// Retrieves the Vector result of the latest expression that was performed.
+		/// </summary>
+		/// <returns>result of the expression.</returns>
+		/// <exception cref="runtime_error">Result is not a Vector</exception>
+		const glm::vec4& VectorResult() const;
+		/// <summary>
+		/// Retrieves the Matrix result of the latest expression that was performed.
+		/// </summary>
+		/// <returns>result of the expression.</returns>
+		/// <exception cref="runtime_error">Result is not a Matrix</exception>
+		const glm::mat4& MatrixResult() const;
 
 		/// <summary>
 		/// Updates all Actions in ActionExpression to fulfil the expression set
@@ -63,64 +95,97 @@ namespace FieaGameEngine
 		static const Vector<Signature> Signatures();
 
 	private:
-		std::string _expression;
-		int _result = 0;
-
-		int Add(int lhs, int rhs);
-		int Subtract(int lhs, int rhs);
-		int Multiply(int lhs, int rhs);
-		int Divide(int lhs, int rhs);
-		int Mod(int lhs, int rhs);
-		int Equals(int lhs, int rhs);
-		int NotEquals(int lhs, int rhs);
-
-		using ExpressionFunction = int(ActionExpression::*)(int, int);
-		using ExpressionFunctionMap = HashMap<std::string, ExpressionFunction>;
-		const ExpressionFunctionMap _expressionFunctionMap = {
-			std::make_pair("+", &ActionExpression::Add),
-			std::make_pair("-", &ActionExpression::Subtract),
-			std::make_pair("*", &ActionExpression::Multiply),
-			std::make_pair("/", &ActionExpression::Divide),
-			std::make_pair("%", &ActionExpression::Mod),
-			std::make_pair("==", &ActionExpression::Equals),
-			std::make_pair("!=", &ActionExpression::NotEquals)
+		enum class InstructionType : std::uint8_t
+		{
+			Operand,
+			Operator,
+			AssignOperator
 		};
 
-		int Assign(int& lhs, int rhs);
-		int AddAssign(int& lhs, int rhs);
-		int SubtractAssign(int& lhs, int rhs);
-		int MultiplyAssign(int& lhs, int rhs);
-		int DivideAssign(int& lhs, int rhs);
-		int ModAssign(int& lhs, int rhs);
-
-		using ExpressionAssignFunction = int(ActionExpression::*)(int&, int);
-		using ExpressionAssignFunctionMap = HashMap<std::string, ExpressionAssignFunction>;
-		const ExpressionAssignFunctionMap _expressionAssignFunctionMap = {
-			std::make_pair("=", &ActionExpression::Assign),
-			std::make_pair("+=", &ActionExpression::AddAssign),
-			std::make_pair("-=", &ActionExpression::SubtractAssign),
-			std::make_pair("*=", &ActionExpression::MultiplyAssign),
-			std::make_pair("/=", &ActionExpression::DivideAssign),
-			std::make_pair("%=", &ActionExpression::ModAssign)
+		enum class OpCode : std::uint8_t
+		{
+			None,
+			Add,
+			Subtract,
+			Multiply,
+			Divide,
+			Mod,
+			Equals,
+			NotEquals,
+			Assign
 		};
 
-		inline static const HashMap<std::string, int> _operators = {
-			std::make_pair("+", 0),			// Add
-			std::make_pair("-", 0),			// Substract
-			std::make_pair("*", 1),			// Multiply
-			std::make_pair("/", 1),			// Divide	
-			std::make_pair("%", 1)			// Mod
+		struct OperatorInfo final
+		{
+			std::string_view Token;
+			InstructionType Type;
+			OpCode Code;
+			int Precedence;
+			bool IsFinal;			///< applied after the rest of the expression
 		};
-		inline static const HashMap<std::string, int> _finalOperators = {
-			std::make_pair("=", 0),			// Assign
-			std::make_pair("+=", 0),		// AddAssign
-			std::make_pair("-=", 0),		// SubstractAssign
-			std::make_pair("*=", 0),		// MultiplyAssign
-			std::make_pair("/=", 0),		// DivideAssign
-			std::make_pair("%=", 0),		// ModAssign
-			std::make_pair("==", 0),		// Equals
-			std::make_pair("!=", 0)			// NotEquals
+
+		inline static constexpr OperatorInfo _operatorTable[] =
+		{
+			{ "+", InstructionType::Operator, OpCode::Add, 0, false },
+			{ "-", InstructionType::Operator, OpCode::Subtract, 0, false },
+			{ "*", InstructionType::Operator, OpCode::Multiply, 1, false },
+			{ "/", InstructionType::Operator, OpCode::Divide, 1, false },
+			{ "%", InstructionType::Operator, OpCode::Mod, 1, false },
+			{ "==", InstructionType::Operator, OpCode::Equals, 0, true },
+			{ "!=", InstructionType::Operator, OpCode::NotEquals, 0, true },
+			{ "=", InstructionType::AssignOperator, OpCode::Assign, 0, true },
+			{ "+=", InstructionType::AssignOperator, OpCode::Add, 0, true },
+			{ "-=", InstructionType::AssignOperator, OpCode::Subtract, 0, true },
+			{ "*=", InstructionType::AssignOperator, OpCode::Multiply, 0, true },
+			{ "/=", InstructionType::AssignOperator, OpCode::Divide, 0, true },
+			{ "%=", InstructionType::AssignOperator, OpCode::Mod, 0, true }
+		};
+
+		struct Instruction final
+		{
+			InstructionType Type;
+			OpCode Code;
+			std::uint32_t Slot;
 		};
+
+		struct Operand final
+		{
+			Symbol Name;
+			CachedSearch Search;
+		};
+
+		struct Value final
+		{
+			Value() : Integer(0) { };
+
+			Datum::DatumType Type{ Datum::DatumType::Integer };
+			union
+			{
+				int Integer;
+				float Float;
+				glm::vec4 Vector;
+				glm::mat4 Matrix;
+			};
+		};
+
+		static const OperatorInfo* FindOperator(std::string_view token);
+		static void Apply(OpCode code, Value& lhs, const Value& rhs);
+		static void ApplyScalar(OpCode code, Value& lhs, const Value& rhs);
+		static Value Load(const Datum& datum);
+		static void Store(Datum& datum, Value& value);
+
+		void Compile();
+		void EmitOperand(std::string_view token);
+		void EmitOperator(const OperatorInfo& info, size_t& depth);
+		Datum& ResolveOperand(size_t slot);
+
+		std::string _expression;
+		Value _result;
+
+		bool _isCompiled{ false };
+		Vector<Instruction> _program;
+		Vector<Operand> _operands;
+		Vector<Value> _valueStack;
 	};
 
 	ConcreteFactory(ActionExpression, Scope);
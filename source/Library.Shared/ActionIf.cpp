@@ -12,11 +12,11 @@ namespace FieaGameEngine
 	ActionIf::ActionIf() :
 		IAction(ActionIf::TypeIdClass())
 	{
-		assert(_orderVector.At(trueClauseIndex)->first == "Then");
-		assert(_orderVector.At(trueClauseIndex)->second.Type() == Datum::DatumType::Table);
+		assert(_table[trueClauseIndex].first.Name() == "Then");
+		assert(_table[trueClauseIndex].second.Type() == Datum::DatumType::Table);
 
-		assert(_orderVector.At(falseClauseIndex)->first == "Else");
-		assert(_orderVector.At(falseClauseIndex)->second.Type() == Datum::DatumType::Table);
+		assert(_table[falseClauseIndex].first.Name() == "Else");
+		assert(_table[falseClauseIndex].second.Type() == Datum::DatumType::Table);
 	}
 
 	const Vector<Signature> ActionIf::Signatures()
@@ -48,7 +48,7 @@ namespace FieaGameEngine
 
 		if (!_target.empty())
 		{
-			Datum* datum = Search(_target);
+			Datum* datum = _targetSearch.Search(*this, _target);
 			if (datum == nullptr) throw std::runtime_error("ActionIf Update - Target Does Not Exist");
 			clauseIndex = datum->GetInteger() ? trueClauseIndex : falseClauseIndex;
 		}
@@ -57,7 +57,7 @@ namespace FieaGameEngine
 			clauseIndex = _condition ? trueClauseIndex : falseClauseIndex;
 		}
 
-		Datum& datum = _orderVector[clauseIndex]->second;
+		Datum& datum = _table[clauseIndex].second;
 		Scope& scope = datum.GetScope();
 		assert(scope.Is("ActionList"));
 		ActionList* actionList = static_cast<ActionList*>(&scope);
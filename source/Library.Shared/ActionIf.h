@@ -2,6 +2,7 @@
 
 #include "IAction.h"
 #include "ActionList.h"
+#include "CachedSearch.h"
 
 namespace FieaGameEngine
 {
@@ -68,6 +69,7 @@ namespace FieaGameEngine
 	private:
 		std::string _target;
 		bool _condition{ false };
+		CachedSearch _targetSearch;
 
 		const static int trueClauseIndex{ 3 };
 		const static int falseClauseIndex{ 4 };
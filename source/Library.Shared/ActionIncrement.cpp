@@ -48,7 +48,7 @@ namespace FieaGameEngine
 	{
 		worldState.Action = this;
 
-		Datum* datum = Search(_target);
+		Datum* datum = _targetSearch.Search(*this, _target);
 		if (datum == nullptr) throw std::runtime_error("ActionIncrement Update - Target Does Not Exist");
 		switch (datum->Type())
 		{
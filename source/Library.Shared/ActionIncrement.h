@@ -1,6 +1,7 @@
 #pragma once
 
 #include "IAction.h"
+#include "CachedSearch.h"
 
 namespace FieaGameEngine
 {
@@ -77,6 +78,7 @@ namespace FieaGameEngine
 	private:
 		std::string _target;
 		int _step = 1;
+		CachedSearch _targetSearch;
 	};
 
 	ConcreteFactory(ActionIncrement, Scope)
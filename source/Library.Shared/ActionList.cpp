@@ -77,6 +77,6 @@ namespace FieaGameEngine
 
 	Datum& ActionList::Actions() const
 	{
-		return _orderVector[actionsIndex]->second;
+		return Entry(actionsIndex).second;
 	}
 }
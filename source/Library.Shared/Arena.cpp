@@ -0,0 +1,139 @@
+#include "pch.h"
+
+#include <cstdlib>
+#include <cstdint>
+
+#include "Arena.h"
+
+using namespace std;
+
+namespace FieaGameEngine
+{
+	Arena::Arena(size_t chunkSize) :
+		_chunkSize{ chunkSize }
+	{
+		if (chunkSize == 0_z)
+		{
+			throw runtime_error("Chunk size must be greater than 0.");
+		}
+	}
+
+	Arena::Arena(Arena&& other) noexcept :
+		_chunks{ other._chunks }, _current{ other._current }, _end{ other._end },
+		_chunkSize{ other._chunkSize }, _size{ other._size }, _capacity{ other._capacity }
+	{
+		other._chunks = nullptr;
+		other._current = nullptr;
+		other._end = nullptr;
+		other._size = 0_z;
+		other._capacity = 0_z;
+	}
+
+	Arena& Arena::operator=(Arena&& other) noexcept
+	{
+		if (this != &other)
+		{
+			FreeChunks(_chunks);
+
+			_chunks = other._chunks;
+			_current = other._current;
+			_end = other._end;
+			_chunkSize = other._chunkSize;
+			_size = other._size;
+			_capacity = other._capacity;
+
+			other._chunks = nullptr;
+			other._current = nullptr;
+			other._end = nullptr;
+			other._size = 0_z;
+			other._capacity = 0_z;
+		}
+		return *this;
+	}
+
+	Arena::~Arena()
+	{
+		FreeChunks(_chunks);
+	}
+
+	void* Arena::Allocate(size_t size, size_t alignment)
+	{
+		assert(alignment != 0_z && (alignment & (alignment - 1_z)) == 0_z);
+
+		std::uintptr_t address = (reinterpret_cast<std::uintptr_t>(_current) + alignment - 1_z) & ~(alignment - 1_z);
+		if (_current == nullptr || address + size > reinterpret_cast<std::uintptr_t>(_end))
+		{
+			AddChunk(std::max(_chunkSize, size + alignment));
+			address = (reinterpret_cast<std::uintptr_t>(_current) + alignment - 1_z) & ~(alignment - 1_z);
+		}
+
+		_current = reinterpret_cast<std::byte*>(address + size);
+		_size += size;
+		return reinterpret_cast<void*>(address);
+	}
+
+	void Arena::Reset()
+	{
+		if (_chunks == nullptr)
+		{
+			return;
+		}
+
+		// Keep the oldest chunk, it is the one a steady workload keeps needing
+		Chunk* first = _chunks;
+		while (first->Next != nullptr)
+		{
+			first = first->Next;
+		}
+
+		Chunk* chunk = _chunks;
+		while (chunk != first)
+		{
+			Chunk* next = chunk->Next;
+			free(chunk);
+			chunk = next;
+		}
+
+		_chunks = first;
+		_current = reinterpret_cast<std::byte*>(first + 1);
+		_end = _current + first->Size;
+		_size = 0_z;
+		_capacity = first->Size;
+	}
+
+	size_t Arena::Size() const
+	{
+		return _size;
+	}
+
+	size_t Arena::Capacity() const
+	{
+		return _capacity;
+	}
+
+	void Arena::AddChunk(size_t size)
+	{
+		Chunk* chunk = static_cast<Chunk*>(malloc(sizeof(Chunk) + size));
+		if (chunk == nullptr)
+		{
+			throw runtime_error("Arena could not allocate a chunk.");
+		}
+
+		chunk->Next = _chunks;
+		chunk->Size = size;
+		_chunks = chunk;
+		_current = reinterpret_cast<std::byte*>(chunk + 1);
+		_end = _current + size;
+		_capacity += size;
+	}
+
+	void Arena::FreeChunks(Chunk* chunk)
+	{
+		while (chunk != nullptr)
+		{
+			Chunk* next = chunk->Next;
+			free(chunk);
+			chunk = next;
+		}
+	}
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+
+#include "SizeLiteral.h"
+
+namespace FieaGameEngine
+{
+	/// <summary>
+	/// Arena is a region allocator: memory is carved sequentially out of large chunks and is never
+	/// freed individually, only all at once by Reset or the destructor. A Scope constructed with an
+	/// Arena takes its child Scopes, its table storage and its Datum buffers from it, so building
+	/// and tearing down a large tree costs a few chunk allocations instead of one malloc and free per
+	/// node. Objects placed in an Arena still have their destructors run; the Arena only owns memory.
+	/// The Arena must outlive everything allocated from it.
+	/// </summary>
+	class Arena final
+	{
+	public:
+		/// <summary>
+		/// Constructs an empty arena. No memory is allocated until the first Allocate.
+		/// </summary>
+		/// <param name="chunkSize">size in bytes of the chunks requested from the heap</param>
+		/// <exception cref="runtime_error">Chunk size is 0</exception>
+		explicit Arena(size_t chunkSize = _defaultChunkSize);
+		Arena(const Arena&) = delete;
+		Arena(Arena&& other) noexcept;
+		Arena& operator=(const Arena&) = delete;
+		Arena& operator=(Arena&& other) noexcept;
+		/// <summary>
+		/// Frees every chunk.
+		/// </summary>
+		~Arena();
+
+		/// <summary>
+		/// Allocates size bytes. Requests larger than the chunk size get a chunk of their own.
+		/// </summary>
+		/// <param name="size">number of bytes</param>
+		/// <param name="alignment">alignment of the returned memory, a power of two</param>
+		/// <returns>pointer to the allocated memory</returns>
+		/// <exception cref="runtime_error">A new chunk could not be allocated</exception>
+		void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+		/// <summary>
+		/// Releases every allocation at once. The first chunk is kept for reuse.
+		/// Everything allocated from the arena must have been destroyed already.
+		/// </summary>
+		void Reset();
+
+		/// <summary>
+		/// Number of bytes handed out since construction or the last Reset.
+		/// </summary>
+		/// <returns>bytes allocated</returns>
+		size_t Size() const;
+		/// <summary>
+		/// Number of bytes held in chunks.
+		/// </summary>
+		/// <returns>bytes reserved from the heap</returns>
+		size_t Capacity() const;
+
+	private:
+		struct Chunk final
+		{
+			Chunk* Next;
+			size_t Size;
+		};
+
+		void AddChunk(size_t size);
+		static void FreeChunks(Chunk* chunk);
+
+		inline static constexpr size_t _defaultChunkSize{ 64 * 1024 };
+
+		Chunk* _chunks{ nullptr };
+		std::byte* _current{ nullptr };
+		std::byte* _end{ nullptr };
+		size_t _chunkSize;
+		size_t _size{ 0 };
+		size_t _capacity{ 0 };
+	};
+}
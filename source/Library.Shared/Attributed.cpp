@@ -11,7 +11,7 @@ namespace FieaGameEngine
 
 	Attributed::Attributed(RTTI::IdType typeId)
 	{
-		(*this)["this"s] = this;
+		(*this)[_thisSymbol] = this;
 		Populate(typeId);
 	}
 
@@ -47,21 +47,21 @@ namespace FieaGameEngine
 	Attributed::Attributed(const Attributed& other) :
 		Scope(other)
 	{
-		(*this)["this"s] = this;
+		(*this)[_thisSymbol] = this;
 		UpdateExternalStorage(other.TypeIdInstance());
 	}
 
 	Attributed::Attributed(Attributed&& other) noexcept :
 		Scope(std::move(other))
 	{
-		(*this)["this"s] = this;
+		(*this)[_thisSymbol] = this;
 		UpdateExternalStorage(other.TypeIdInstance());
 	}
 
 	Attributed& Attributed::operator=(const Attributed& other)
 	{
 		Scope::operator=(other);
-		(*this)["this"s] = this;
+		(*this)[_thisSymbol] = this;
 		UpdateExternalStorage(other.TypeIdInstance());
 		return *this;
 	}
@@ -69,20 +69,20 @@ namespace FieaGameEngine
 	Attributed& Attributed::operator=(Attributed&& other) noexcept
 	{
 		Scope::operator=(std::move(other));
-		(*this)["this"s] = this;
+		(*this)[_thisSymbol] = this;
 		UpdateExternalStorage(other.TypeIdInstance());
 		return *this;
 	}
 
 	void Attributed::UpdateExternalStorage(RTTI::IdType typeId)
 	{
-		Vector<Signature> signatures = TypeManager::GetSignaturesForType(typeId);
+		const Vector<Signature>& signatures = TypeManager::GetSignaturesForType(typeId);
 		size_t prescribedSignatureCount = signatures.Size() + 1; // +1 for "this"
 
 		for (size_t i = 1; i < prescribedSignatureCount; ++i)
 		{
 			const Signature& signature = signatures[i - 1];
-			auto& [key, datum] = *(_orderVector[i]);
+			auto& [key, datum] = _table[i];
 
 			assert(signature.Name == key);
 			assert(signature.Type == datum.Type());
@@ -103,20 +103,26 @@ namespace FieaGameEngine
 
 	bool Attributed::IsAttribute(const std::string& name) const
 	{
-		return _map.ContainsKey(name);
+		return Find(name) != nullptr;
 	}
 
 	bool Attributed::IsPrescribedAttribute(const std::string& name) const
 	{
-		if (name == "this"s)
+		const std::uintptr_t id = SymbolTable::FindId(name);
+		if (id == 0)
+		{
+			return false;
+		}
+
+		if (id == _thisSymbol.Id())
 		{
 			return true;
 		}
 
-		auto signatures = TypeManager::GetSignaturesForType(TypeIdInstance());
-		for (auto signature : signatures)
+		const auto& signatures = TypeManager::GetSignaturesForType(TypeIdInstance());
+		for (const auto& signature : signatures)
 		{
-			if (signature.Name == name)
+			if (signature.Name.Id() == id)
 			{
 				return true;
 			}
@@ -138,20 +144,26 @@ namespace FieaGameEngine
 		return Scope::Append(name);
 	}
 
-	const Vector<Scope::PairType*>& Attributed::Attributes() const
+	Vector<Scope::PairType*> Attributed::Attributes() const
 	{
-		return _orderVector;
+		Vector<PairType*> attributes(_table.Size());
+		for (size_t i = 0; i < _table.Size(); ++i)
+		{
+			attributes.PushBack(&Entry(i));
+		}
+
+		return attributes;
 	}
 
 	Vector<Scope::PairType*> Attributed::PrescribedAttributes() const
 	{
-		const auto signatures = TypeManager::GetSignaturesForType(TypeIdInstance());
+		const auto& signatures = TypeManager::GetSignaturesForType(TypeIdInstance());
 
 		size_t prescribedAttributeCount = signatures.Size() + 1; // +1 for the "this" attribute
 		Vector<PairType*> prescribedAttributes(prescribedAttributeCount);
 		for (size_t i = 0; i < prescribedAttributeCount; ++i)
 		{
-			prescribedAttributes.PushBack(_orderVector[i]);
+			prescribedAttributes.PushBack(&Entry(i));
 		}
 
 		return prescribedAttributes;
@@ -159,13 +171,13 @@ namespace FieaGameEngine
 
 	Vector<Scope::PairType*> Attributed::AuxiliaryAttributes() const
 	{
-		const auto signatures = TypeManager::GetSignaturesForType(TypeIdInstance());
+		const auto& signatures = TypeManager::GetSignaturesForType(TypeIdInstance());
 
 		size_t auxiliaryAttributeBeginIndex = signatures.Size() + 1; // +1 for the "this" attribute
-		Vector<PairType*> auxiliaryAttributes(_orderVector.Size() - auxiliaryAttributeBeginIndex);
-		for (size_t i = auxiliaryAttributeBeginIndex; i < _orderVector.Size(); ++i)
+		Vector<PairType*> auxiliaryAttributes(_table.Size() - auxiliaryAttributeBeginIndex);
+		for (size_t i = auxiliaryAttributeBeginIndex; i < _table.Size(); ++i)
 		{
-			auxiliaryAttributes.PushBack(_orderVector[i]);
+			auxiliaryAttributes.PushBack(&Entry(i));
 		}
 
 		return auxiliaryAttributes;
@@ -81,7 +81,7 @@ namespace FieaGameEngine
 		/// Accessor method of all attributes.
 		/// </summary>
 		/// <returns>All attributes of this attributed object</returns>
-		const Vector<Scope::PairType*>& Attributes() const;
+		Vector<Scope::PairType*> Attributes() const;
 		/// <summary>
 		/// Accessor method of prescribed attributes.
 		/// </summary>
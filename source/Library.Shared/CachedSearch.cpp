@@ -0,0 +1,59 @@
+#include "pch.h"
+
+#include "CachedSearch.h"
+
+using namespace std;
+
+namespace FieaGameEngine
+{
+	Datum* CachedSearch::Search(Scope& scope, const std::string& name)
+	{
+		if (_name.Name() != name)
+		{
+			_name = Symbol(name);
+			_scope = nullptr;
+		}
+		return Search(scope, _name);
+	}
+
+	Datum* CachedSearch::Search(Scope& scope, const Symbol& name)
+	{
+		if (_scope != &scope || _name != name || _generation != NewestGeneration(scope, _foundScope))
+		{
+			Scope* foundScope = nullptr;
+			_name = name;
+			_datum = scope.Search(name, foundScope);
+			_scope = &scope;
+			_foundScope = foundScope;
+			_generation = NewestGeneration(scope, foundScope);
+		}
+		return _datum;
+	}
+
+	void CachedSearch::Reset()
+	{
+		_scope = nullptr;
+		_foundScope = nullptr;
+		_datum = nullptr;
+		_generation = 0;
+	}
+
+	std::uint64_t CachedSearch::NewestGeneration(const Scope& scope, const Scope* foundScope)
+	{
+		// Only the Scopes from the searching one up to where the name was found (or the root) affect the result.
+		// A changed chain passes through a Scope with a newer generation before it could miss foundScope.
+		std::uint64_t newest = 0;
+		for (const Scope* current = &scope; current != nullptr; current = current->GetParent())
+		{
+			if (current->Generation() > newest)
+			{
+				newest = current->Generation();
+			}
+			if (current == foundScope)
+			{
+				break;
+			}
+		}
+		return newest;
+	}
+}
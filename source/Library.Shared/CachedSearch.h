@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "Scope.h"
+#include "Symbol.h"
+
+namespace FieaGameEngine
+{
+	/// <summary>
+	/// CachedSearch remembers the result of a Scope::Search for a name, so that
+	/// repeated searches for the same name from the same Scope skip walking the parent chain.
+	/// The result is kept together with the newest generation of the Scopes the search walked and is
+	/// searched again only when the name or the searching Scope changes, or one of those Scopes gets a
+	/// newer generation (an Append, Adopt, Orphan, Clear or move of that Scope).
+	/// Copies re-search on first use since they search from a different Scope.
+	/// </summary>
+	class CachedSearch final
+	{
+	public:
+		/// <summary>
+		/// Searches for the name from the given Scope, reusing the previous result if it is still valid.
+		/// </summary>
+		/// <param name="scope">scope to search from</param>
+		/// <param name="name">name to search for</param>
+		/// <returns>Address of the most-closely nested Datum, or nullptr.</returns>
+		Datum* Search(Scope& scope, const std::string& name);
+		/// <summary>
+		/// Searches for the symbol from the given Scope, reusing the previous result if it is still valid.
+		/// </summary>
+		/// <param name="scope">scope to search from</param>
+		/// <param name="name">symbol to search for</param>
+		/// <returns>Address of the most-closely nested Datum, or nullptr.</returns>
+		Datum* Search(Scope& scope, const Symbol& name);
+		/// <summary>
+		/// Forgets the remembered result, so that the next Search searches again.
+		/// </summary>
+		void Reset();
+
+	private:
+		static std::uint64_t NewestGeneration(const Scope& scope, const Scope* foundScope);
+
+		Symbol _name;
+		const Scope* _scope{ nullptr };
+		const Scope* _foundScope{ nullptr };
+		Datum* _datum{ nullptr };
+		std::uint64_t _generation{ 0 };
+	};
+}
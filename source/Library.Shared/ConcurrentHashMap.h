@@ -0,0 +1,248 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <tuple>
+#include <utility>
+
+#include "DefaultHash.h"
+#include "DefaultEquality.h"
+#include "SizeLiteral.h"
+#include "Vector.h"
+
+namespace FieaGameEngine
+{
+	/// <summary>
+	/// ConcurrentHashMap is an unordered map that many threads can read and write at the same time.
+	/// Keys are spread over a fixed number of shards. Each shard is a chained table with its own writer
+	/// lock, so writers only contend when they land in the same shard. Find never locks: new links are
+	/// published with release stores, and a shard that grows builds a new bucket array and swaps it in,
+	/// leaving the old one untouched for readers still walking it.
+	/// Entries are never moved, so pointers to them stay valid until they are removed. Removed entries and
+	/// replaced bucket arrays are kept until Reclaim, Clear or the destructor, none of which may run while
+	/// another thread is using the map.
+	/// </summary>
+	/// <typeparam name="TKey">Key that will be hashed to access map</typeparam>
+	/// <typeparam name="TValue">Value to be stored at key</typeparam>
+	/// <typeparam name="THash">Functor hashing a key to a size_t, called from several threads at once</typeparam>
+	/// <typeparam name="TEq">Functor comparing two keys for equality, called from several threads at once</typeparam>
+	template <typename TKey, typename TValue, typename THash = DefaultHash<TKey>, typename TEq = DefaultEquality<TKey>>
+	class ConcurrentHashMap final
+	{
+	public:
+		using PairType = std::pair<const TKey, TValue>;
+		using HashFunctor = THash;
+		using EqualityFunctor = TEq;
+
+		/// <summary>
+		/// Creates new instance of ConcurrentHashMap container. Requires a size > 0.
+		/// The buckets are split evenly between the shards.
+		/// </summary>
+		/// <param name="size">Number of buckets</param>
+		/// <param name="hashFunctor">function to use to hash keys</param>
+		/// <param name="equalityFunctor">function to use to check for key equality</param>
+		/// <exception cref="runtime_error">size cannot be zero</exception>
+		ConcurrentHashMap(size_t size = 16_z, HashFunctor hashFunctor = HashFunctor{}, EqualityFunctor equalityFunctor = EqualityFunctor{});
+		/// <summary>
+		/// ConcurrentHashMap initializer list constructor with default functors
+		/// </summary>
+		/// <param name="list">initializer list</param>
+		ConcurrentHashMap(std::initializer_list<PairType> list);
+		ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+		ConcurrentHashMap(ConcurrentHashMap&&) = delete;
+		ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+		ConcurrentHashMap& operator=(ConcurrentHashMap&&) = delete;
+		/// <summary>
+		/// Destroys every entry, including the ones removed but not yet reclaimed.
+		/// </summary>
+		~ConcurrentHashMap();
+
+		/// <summary>
+		/// Is ConcurrentHashMap empty? Only a snapshot while other threads insert or remove.
+		/// </summary>
+		/// <returns>true if the map is empty false otherwise</returns>
+		bool IsEmpty() const;
+		/// <summary>
+		/// Size of the ConcurrentHashMap. Only a snapshot while other threads insert or remove.
+		/// </summary>
+		/// <returns>the amount of elements of the container</returns>
+		size_t Size() const;
+		/// <summary>
+		/// Bucket size of the ConcurrentHashMap, summed over the shards
+		/// </summary>
+		/// <returns>the number of buckets</returns>
+		size_t BucketSize() const;
+
+		/// <summary>
+		/// Finds the entry with the given key without taking any lock.
+		/// </summary>
+		/// <param name="key">key to find in the map</param>
+		/// <returns>pointer to the entry with that key, or nullptr if not found</returns>
+		PairType* Find(const TKey& key);
+		/// <summary>
+		/// Finds the entry with the given key without taking any lock.
+		/// </summary>
+		/// <param name="key">key to find in the map</param>
+		/// <returns>pointer to the entry with that key, or nullptr if not found</returns>
+		const PairType* Find(const TKey& key) const;
+		/// <summary>
+		/// Find with a key of another type, e.g. a string literal or std::string_view for a std::string key.
+		/// Only available when both functors are transparent.
+		/// </summary>
+		/// <param name="key">key to find in the map</param>
+		/// <returns>pointer to the entry with that key, or nullptr if not found</returns>
+		template <typename TLookup> requires TransparentFunctor<THash> && TransparentFunctor<TEq>
+		PairType* Find(const TLookup& key);
+		/// <summary>
+		/// Find with a key of another type. Only available when both functors are transparent.
+		/// </summary>
+		/// <param name="key">key to find in the map</param>
+		/// <returns>pointer to the entry with that key, or nullptr if not found</returns>
+		template <typename TLookup> requires TransparentFunctor<THash> && TransparentFunctor<TEq>
+		const PairType* Find(const TLookup& key) const;
+		/// <summary>
+		/// Inserts a copy of entry if its key is not in the map yet.
+		/// </summary>
+		/// <param name="entry">entry to insert</param>
+		/// <returns>pair of pointer to the entry with that key and bool if entry was inserted</returns>
+		std::pair<PairType*, bool> Insert(const PairType& entry);
+		/// <summary>
+		/// Inserts an entry for key with a value constructed in place from the arguments passed in,
+		/// if key is not in the map yet. Nothing is constructed, copied or moved otherwise.
+		/// </summary>
+		/// <param name="key">key of the entry</param>
+		/// <param name="args">arguments forwarded to the constructor of TValue</param>
+		/// <returns>pair of pointer to the entry with that key and bool if the entry was inserted</returns>
+		template <typename... Args>
+		std::pair<PairType*, bool> TryEmplace(const TKey& key, Args&&... args);
+		/// <summary>
+		/// Inserts an entry for key with a value constructed in place from the arguments passed in,
+		/// if key is not in the map yet. The key is only moved from if the entry is inserted.
+		/// </summary>
+		/// <param name="key">key of the entry</param>
+		/// <param name="args">arguments forwarded to the constructor of TValue</param>
+		/// <returns>pair of pointer to the entry with that key and bool if the entry was inserted</returns>
+		template <typename... Args>
+		std::pair<PairType*, bool> TryEmplace(TKey&& key, Args&&... args);
+
+		/// <summary>
+		/// Unlinks the entry with the given key, if there is one. Threads that already found the entry can
+		/// keep using it; it is destroyed by the next Reclaim or Clear.
+		/// </summary>
+		/// <param name="key">key entry to remove from the map</param>
+		void Remove(const TKey& key);
+		/// <summary>
+		/// Destroys every entry. Must not run while another thread is using the map.
+		/// </summary>
+		void Clear();
+		/// <summary>
+		/// Frees the entries and bucket arrays that Remove and growing left behind.
+		/// Must not run while another thread is using the map.
+		/// </summary>
+		void Reclaim();
+		/// <summary>
+		/// Rebuilds every shard with an even share of bucketSize buckets.
+		/// </summary>
+		/// <param name="bucketSize">new total number of buckets</param>
+		/// <exception cref="runtime_error">bucket size cannot be zero</exception>
+		void Resize(size_t bucketSize);
+
+		/// <summary>
+		/// returns a Boolean indicating the presence of a key within the map.
+		/// </summary>
+		/// <param name="key">key to find</param>
+		/// <returns>true if key is within the map, false otherwise</returns>
+		bool ContainsKey(const TKey& key) const;
+		/// <summary>
+		/// ContainsKey with a key of another type. Only available when both functors are transparent.
+		/// </summary>
+		/// <param name="key">key to find</param>
+		/// <returns>true if key is within the map, false otherwise</returns>
+		template <typename TLookup> requires TransparentFunctor<THash> && TransparentFunctor<TEq>
+		bool ContainsKey(const TLookup& key) const;
+		/// <summary>
+		/// Access to the value in the map. If the map has no entry associated with
+		/// the key then it will create a default entry.
+		/// </summary>
+		/// <returns>reference to the value at the given key</returns>
+		TValue& operator[](const TKey& key);
+		/// <summary>
+		/// Access to the data in the container at the given key.
+		/// </summary>
+		/// <returns>reference to the value at the given key</returns>
+		/// <exception cref="runtime_error">thrown if there is no key in container</exception>
+		TValue& At(const TKey& key);
+		/// <summary>
+		/// access to the (constant) data in the container at the key.
+		/// </summary>
+		/// <returns>constant reference to the value at the given key</returns>
+		/// <exception cref="runtime_error">thrown if there is no key in container</exception>
+		const TValue& At(const TKey& key) const;
+
+		/// <summary>
+		/// Calls function with every entry, without taking any lock. Entries inserted or removed by other
+		/// threads during the call may or may not be visited.
+		/// </summary>
+		/// <param name="function">callable taking a const PairType&</param>
+		template <typename TFunction>
+		void ForEach(TFunction function) const;
+
+	private:
+		struct Entry final
+		{
+			template <typename... Args>
+			Entry(size_t hash, Args&&... args);
+
+			size_t Hash;
+			PairType Pair;
+		};
+
+		struct Link final
+		{
+			Entry* Value;
+			std::atomic<Link*> Next;
+		};
+
+		struct Table final
+		{
+			explicit Table(size_t bucketCount);
+			Table(const Table&) = delete;
+			Table& operator=(const Table&) = delete;
+			~Table();
+
+			void Publish(Entry& entry);
+
+			size_t BucketCount;
+			std::atomic<Link*>* Buckets;
+		};
+
+		struct alignas(64) Shard final
+		{
+			std::mutex Mutex;
+			std::atomic<Table*> Current;
+			std::atomic<size_t> Size;
+			Vector<Table*> RetiredTables;
+			Vector<Link*> RetiredLinks;
+			Vector<Entry*> RetiredEntries;
+		};
+
+		static size_t BucketsPerShard(size_t bucketSize);
+		static size_t BucketIndex(size_t hash, size_t bucketCount);
+
+		template <typename TLookup>
+		const PairType* FindEntry(const TLookup& key) const;
+		template <typename TKeyArg, typename... Args>
+		std::pair<PairType*, bool> TryEmplaceKey(TKeyArg&& key, Args&&... args);
+		Table* Rehash(Shard& shard, size_t bucketCount);
+		void ReclaimShard(Shard& shard);
+		void DestroyShard(Shard& shard);
+
+		inline static constexpr size_t _shardCount{ 16 };
+
+		Shard _shards[_shardCount];
+		[[msvc::no_unique_address]] HashFunctor _hashFunctor;
+		[[msvc::no_unique_address]] EqualityFunctor _equalityFunctor;
+	};
+}
+
+#include "ConcurrentHashMap.inl"
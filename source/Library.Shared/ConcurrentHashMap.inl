@@ -0,0 +1,408 @@
+#include "pch.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "ConcurrentHashMap.h"
+
+namespace FieaGameEngine
+{
+#pragma region Entry
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template<typename... Args>
+	inline ConcurrentHashMap<TKey, TValue, THash, TEq>::Entry::Entry(size_t hash, Args&&... args) :
+		Hash(hash), Pair(std::forward<Args>(args)...)
+	{
+	}
+#pragma endregion
+
+#pragma region Table
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline ConcurrentHashMap<TKey, TValue, THash, TEq>::Table::Table(size_t bucketCount) :
+		BucketCount(bucketCount), Buckets(new std::atomic<Link*>[bucketCount]())
+	{
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline ConcurrentHashMap<TKey, TValue, THash, TEq>::Table::~Table()
+	{
+		// A table owns its links but not the entries they point to
+		for (size_t i = 0_z; i < BucketCount; ++i)
+		{
+			Link* link = Buckets[i].load(std::memory_order_relaxed);
+			while (link != nullptr)
+			{
+				Link* next = link->Next.load(std::memory_order_relaxed);
+				delete link;
+				link = next;
+			}
+		}
+		delete[] Buckets;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline void ConcurrentHashMap<TKey, TValue, THash, TEq>::Table::Publish(Entry& entry)
+	{
+		// The link is fully built before the release store, so a reader that sees it also sees the entry
+		std::atomic<Link*>& bucket = Buckets[BucketIndex(entry.Hash, BucketCount)];
+		bucket.store(new Link{ &entry, bucket.load(std::memory_order_relaxed) }, std::memory_order_release);
+	}
+#pragma endregion
+
+#pragma region ConcurrentHashMap
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline ConcurrentHashMap<TKey, TValue, THash, TEq>::ConcurrentHashMap(size_t size, HashFunctor hashFunctor, EqualityFunctor equalityFunctor) :
+		_hashFunctor{ hashFunctor }, _equalityFunctor{ equalityFunctor }
+	{
+		if (size == 0)
+		{
+			throw std::runtime_error("ConcurrentHashMap can NOT be initialized with a size of ZERO.");
+		}
+
+		const size_t bucketCount = BucketsPerShard(size);
+		for (Shard& shard : _shards)
+		{
+			shard.Current.store(new Table(bucketCount), std::memory_order_relaxed);
+		}
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline ConcurrentHashMap<TKey, TValue, THash, TEq>::ConcurrentHashMap(std::initializer_list<PairType> list) :
+		ConcurrentHashMap{ std::max(list.size(), 1_z) }
+	{
+		for (const auto& pair : list)
+		{
+			Insert(pair);
+		}
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline ConcurrentHashMap<TKey, TValue, THash, TEq>::~ConcurrentHashMap()
+	{
+		for (Shard& shard : _shards)
+		{
+			DestroyShard(shard);
+			delete shard.Current.load(std::memory_order_relaxed);
+		}
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline bool ConcurrentHashMap<TKey, TValue, THash, TEq>::IsEmpty() const
+	{
+		return Size() == 0_z;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline size_t ConcurrentHashMap<TKey, TValue, THash, TEq>::Size() const
+	{
+		size_t size = 0_z;
+		for (const Shard& shard : _shards)
+		{
+			size += shard.Size.load(std::memory_order_relaxed);
+		}
+		return size;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline size_t ConcurrentHashMap<TKey, TValue, THash, TEq>::BucketSize() const
+	{
+		size_t bucketSize = 0_z;
+		for (const Shard& shard : _shards)
+		{
+			bucketSize += shard.Current.load(std::memory_order_acquire)->BucketCount;
+		}
+		return bucketSize;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename ConcurrentHashMap<TKey, TValue, THash, TEq>::PairType* ConcurrentHashMap<TKey, TValue, THash, TEq>::Find(const TKey& key)
+	{
+		return const_cast<PairType*>(FindEntry(key));
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline const typename ConcurrentHashMap<TKey, TValue, THash, TEq>::PairType* ConcurrentHashMap<TKey, TValue, THash, TEq>::Find(const TKey& key) const
+	{
+		return FindEntry(key);
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename TLookup> requires TransparentFunctor<THash> && TransparentFunctor<TEq>
+	inline typename ConcurrentHashMap<TKey, TValue, THash, TEq>::PairType* ConcurrentHashMap<TKey, TValue, THash, TEq>::Find(const TLookup& key)
+	{
+		return const_cast<PairType*>(FindEntry(key));
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename TLookup> requires TransparentFunctor<THash> && TransparentFunctor<TEq>
+	inline const typename ConcurrentHashMap<TKey, TValue, THash, TEq>::PairType* ConcurrentHashMap<TKey, TValue, THash, TEq>::Find(const TLookup& key) const
+	{
+		return FindEntry(key);
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline std::pair<typename ConcurrentHashMap<TKey, TValue, THash, TEq>::PairType*, bool> ConcurrentHashMap<TKey, TValue, THash, TEq>::Insert(const PairType& entry)
+	{
+		return TryEmplaceKey(entry.first, entry.second);
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename... Args>
+	inline std::pair<typename ConcurrentHashMap<TKey, TValue, THash, TEq>::PairType*, bool> ConcurrentHashMap<TKey, TValue, THash, TEq>::TryEmplace(const TKey& key, Args&&... args)
+	{
+		return TryEmplaceKey(key, std::forward<Args>(args)...);
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename... Args>
+	inline std::pair<typename ConcurrentHashMap<TKey, TValue, THash, TEq>::PairType*, bool> ConcurrentHashMap<TKey, TValue, THash, TEq>::TryEmplace(TKey&& key, Args&&... args)
+	{
+		return TryEmplaceKey(std::move(key), std::forward<Args>(args)...);
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline void ConcurrentHashMap<TKey, TValue, THash, TEq>::Remove(const TKey& key)
+	{
+		const size_t hash = _hashFunctor(key);
+		Shard& shard = _shards[hash % _shardCount];
+		std::lock_guard<std::mutex> lock(shard.Mutex);
+
+		Table* table = shard.Current.load(std::memory_order_relaxed);
+		std::atomic<Link*>* previous = &table->Buckets[BucketIndex(hash, table->BucketCount)];
+		for (Link* link = previous->load(std::memory_order_relaxed); link != nullptr; link = link->Next.load(std::memory_order_relaxed))
+		{
+			if (link->Value->Hash == hash && _equalityFunctor(link->Value->Pair.first, key))
+			{
+				// The unlinked link still points at the rest of the chain, so readers standing on it carry on
+				previous->store(link->Next.load(std::memory_order_relaxed), std::memory_order_release);
+				shard.RetiredLinks.PushBack(link);
+				shard.RetiredEntries.PushBack(link->Value);
+				shard.Size.fetch_sub(1_z, std::memory_order_relaxed);
+				return;
+			}
+			previous = &link->Next;
+		}
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline void ConcurrentHashMap<TKey, TValue, THash, TEq>::Clear()
+	{
+		for (Shard& shard : _shards)
+		{
+			std::lock_guard<std::mutex> lock(shard.Mutex);
+			DestroyShard(shard);
+
+			Table* table = shard.Current.load(std::memory_order_relaxed);
+			shard.Current.store(new Table(table->BucketCount), std::memory_order_release);
+			delete table;
+		}
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline void ConcurrentHashMap<TKey, TValue, THash, TEq>::Reclaim()
+	{
+		for (Shard& shard : _shards)
+		{
+			std::lock_guard<std::mutex> lock(shard.Mutex);
+			ReclaimShard(shard);
+		}
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline void ConcurrentHashMap<TKey, TValue, THash, TEq>::Resize(size_t bucketSize)
+	{
+		if (bucketSize == 0)
+		{
+			throw std::runtime_error("ConcurrentHashMap can NOT be resized to a size of ZERO.");
+		}
+
+		const size_t bucketCount = BucketsPerShard(bucketSize);
+		for (Shard& shard : _shards)
+		{
+			std::lock_guard<std::mutex> lock(shard.Mutex);
+			Rehash(shard, bucketCount);
+		}
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline bool ConcurrentHashMap<TKey, TValue, THash, TEq>::ContainsKey(const TKey& key) const
+	{
+		return FindEntry(key) != nullptr;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename TLookup> requires TransparentFunctor<THash> && TransparentFunctor<TEq>
+	inline bool ConcurrentHashMap<TKey, TValue, THash, TEq>::ContainsKey(const TLookup& key) const
+	{
+		return FindEntry(key) != nullptr;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline TValue& ConcurrentHashMap<TKey, TValue, THash, TEq>::operator[](const TKey& key)
+	{
+		return TryEmplace(key).first->second;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline TValue& ConcurrentHashMap<TKey, TValue, THash, TEq>::At(const TKey& key)
+	{
+		PairType* entry = Find(key);
+		if (entry == nullptr)
+		{
+			throw std::runtime_error("No Value associated with key passed in to ConcurrentHashMap.At()");
+		}
+		return entry->second;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline const TValue& ConcurrentHashMap<TKey, TValue, THash, TEq>::At(const TKey& key) const
+	{
+		const PairType* entry = Find(key);
+		if (entry == nullptr)
+		{
+			throw std::runtime_error("No Value associated with key passed in to ConcurrentHashMap.At()");
+		}
+		return entry->second;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename TFunction>
+	inline void ConcurrentHashMap<TKey, TValue, THash, TEq>::ForEach(TFunction function) const
+	{
+		for (const Shard& shard : _shards)
+		{
+			const Table* table = shard.Current.load(std::memory_order_acquire);
+			for (size_t i = 0_z; i < table->BucketCount; ++i)
+			{
+				for (const Link* link = table->Buckets[i].load(std::memory_order_acquire); link != nullptr; link = link->Next.load(std::memory_order_acquire))
+				{
+					function(static_cast<const PairType&>(link->Value->Pair));
+				}
+			}
+		}
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline size_t ConcurrentHashMap<TKey, TValue, THash, TEq>::BucketsPerShard(size_t bucketSize)
+	{
+		return std::max(1_z, (bucketSize + _shardCount - 1_z) / _shardCount);
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline size_t ConcurrentHashMap<TKey, TValue, THash, TEq>::BucketIndex(size_t hash, size_t bucketCount)
+	{
+		// The low bits picked the shard, so the bucket comes from the rest
+		return (hash / _shardCount) % bucketCount;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename TLookup>
+	inline const typename ConcurrentHashMap<TKey, TValue, THash, TEq>::PairType* ConcurrentHashMap<TKey, TValue, THash, TEq>::FindEntry(const TLookup& key) const
+	{
+		const size_t hash = _hashFunctor(key);
+		const Table* table = _shards[hash % _shardCount].Current.load(std::memory_order_acquire);
+
+		const std::atomic<Link*>& bucket = table->Buckets[BucketIndex(hash, table->BucketCount)];
+		for (const Link* link = bucket.load(std::memory_order_acquire); link != nullptr; link = link->Next.load(std::memory_order_acquire))
+		{
+			const Entry* entry = link->Value;
+			if (entry->Hash == hash && _equalityFunctor(entry->Pair.first, key))
+			{
+				return &entry->Pair;
+			}
+		}
+		return nullptr;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename TKeyArg, typename... Args>
+	inline std::pair<typename ConcurrentHashMap<TKey, TValue, THash, TEq>::PairType*, bool> ConcurrentHashMap<TKey, TValue, THash, TEq>::TryEmplaceKey(TKeyArg&& key, Args&&... args)
+	{
+		const size_t hash = _hashFunctor(key);
+		Shard& shard = _shards[hash % _shardCount];
+		std::lock_guard<std::mutex> lock(shard.Mutex);
+
+		Table* table = shard.Current.load(std::memory_order_relaxed);
+		const std::atomic<Link*>& bucket = table->Buckets[BucketIndex(hash, table->BucketCount)];
+		for (Link* link = bucket.load(std::memory_order_relaxed); link != nullptr; link = link->Next.load(std::memory_order_relaxed))
+		{
+			if (link->Value->Hash == hash && _equalityFunctor(link->Value->Pair.first, key))
+			{
+				return std::make_pair(&link->Value->Pair, false);
+			}
+		}
+
+		const size_t size = shard.Size.load(std::memory_order_relaxed) + 1_z;
+		if (size > table->BucketCount)
+		{
+			table = Rehash(shard, table->BucketCount * 2_z);
+		}
+
+		Entry* entry = new Entry(hash, std::piecewise_construct, std::forward_as_tuple(std::forward<TKeyArg>(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+		table->Publish(*entry);
+		shard.Size.store(size, std::memory_order_relaxed);
+
+		return std::make_pair(&entry->Pair, true);
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename ConcurrentHashMap<TKey, TValue, THash, TEq>::Table* ConcurrentHashMap<TKey, TValue, THash, TEq>::Rehash(Shard& shard, size_t bucketCount)
+	{
+		// Readers may still be walking the current table, so it is left as is and retired
+		Table* table = shard.Current.load(std::memory_order_relaxed);
+		Table* rehashed = new Table(bucketCount);
+		for (size_t i = 0_z; i < table->BucketCount; ++i)
+		{
+			for (Link* link = table->Buckets[i].load(std::memory_order_relaxed); link != nullptr; link = link->Next.load(std::memory_order_relaxed))
+			{
+				rehashed->Publish(*link->Value);
+			}
+		}
+
+		shard.Current.store(rehashed, std::memory_order_release);
+		shard.RetiredTables.PushBack(table);
+		return rehashed;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline void ConcurrentHashMap<TKey, TValue, THash, TEq>::ReclaimShard(Shard& shard)
+	{
+		for (Table* table : shard.RetiredTables)
+		{
+			delete table;
+		}
+		for (Link* link : shard.RetiredLinks)
+		{
+			delete link;
+		}
+		for (Entry* entry : shard.RetiredEntries)
+		{
+			delete entry;
+		}
+
+		shard.RetiredTables.Clear();
+		shard.RetiredLinks.Clear();
+		shard.RetiredEntries.Clear();
+		shard.RetiredTables.ShrinkToFit();
+		shard.RetiredLinks.ShrinkToFit();
+		shard.RetiredEntries.ShrinkToFit();
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline void ConcurrentHashMap<TKey, TValue, THash, TEq>::DestroyShard(Shard& shard)
+	{
+		// Every live entry is linked from the current table exactly once
+		Table* table = shard.Current.load(std::memory_order_relaxed);
+		for (size_t i = 0_z; i < table->BucketCount; ++i)
+		{
+			for (Link* link = table->Buckets[i].load(std::memory_order_relaxed); link != nullptr; link = link->Next.load(std::memory_order_relaxed))
+			{
+				delete link->Value;
+			}
+		}
+
+		ReclaimShard(shard);
+		shard.Size.store(0_z, std::memory_order_relaxed);
+	}
+#pragma endregion
+}
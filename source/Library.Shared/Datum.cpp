@@ -1,12 +1,191 @@
 #include "pch.h"
 
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <string_view>
+
 #include "Datum.h"
+#include "Arena.h"
 
 using namespace glm;
 using namespace std;
+using namespace std::string_view_literals;
 
 namespace FieaGameEngine
 {
+	namespace
+	{
+		/// <summary>
+		/// Writes values into a caller buffer with std::to_chars, in the format of glm::to_string.
+		/// </summary>
+		class CharsWriter final
+		{
+		public:
+			CharsWriter(char* buffer, size_t length) :
+				_current{ buffer }, _begin{ buffer }, _end{ buffer + length }
+			{
+			}
+
+			void Write(std::string_view text)
+			{
+				if (static_cast<size_t>(_end - _current) < text.size())
+				{
+					throw runtime_error("Buffer is too small.");
+				}
+				std::memcpy(_current, text.data(), text.size());
+				_current += text.size();
+			}
+
+			void Write(int value)
+			{
+				Check(std::to_chars(_current, _end, value));
+			}
+
+			void Write(float value)
+			{
+				// Same as printf's %f, which std::to_string and glm::to_string use
+				Check(std::to_chars(_current, _end, value, std::chars_format::fixed, 6));
+			}
+
+			void Write(const vec4& value, std::string_view prefix)
+			{
+				Write(prefix);
+				Write("("sv);
+				for (int i = 0; i < 4; ++i)
+				{
+					if (i > 0) Write(", "sv);
+					Write(value[i]);
+				}
+				Write(")"sv);
+			}
+
+			size_t Size() const
+			{
+				return static_cast<size_t>(_current - _begin);
+			}
+
+		private:
+			void Check(std::to_chars_result result)
+			{
+				if (result.ec != std::errc())
+				{
+					throw runtime_error("Buffer is too small.");
+				}
+				_current = result.ptr;
+			}
+
+			char* _current;
+			char* _begin;
+			char* _end;
+		};
+
+		/// <summary>
+		/// Reads values with std::from_chars, accepting what sscanf's "%i" and "%f" accept: whitespace
+		/// between tokens, a sign, and for integers a "0x" (hexadecimal) or "0" (octal) prefix.
+		/// Like sscanf, reading stops at the first character that is not part of the value.
+		/// </summary>
+		class CharsReader final
+		{
+		public:
+			explicit CharsReader(std::string_view text) :
+				_current{ text.data() }, _end{ text.data() + text.size() }
+			{
+			}
+
+			int ReadInteger()
+			{
+				const bool isNegative = ReadSign();
+
+				unsigned int magnitude{};
+				std::from_chars_result result{ _current, std::errc::invalid_argument };
+				if (HasHexPrefix())
+				{
+					result = std::from_chars(_current + 2, _end, magnitude, 16);
+				}
+				if (result.ec != std::errc())
+				{
+					// "0x" without hex digits is read as 0, like "%i" does
+					result = std::from_chars(_current, _end, magnitude, (_current != _end && *_current == '0') ? 8 : 10);
+				}
+				if (result.ec != std::errc())
+				{
+					throw runtime_error("Text is not a number.");
+				}
+				_current = result.ptr;
+				return static_cast<int>(isNegative ? 0u - magnitude : magnitude);
+			}
+
+			float ReadFloat()
+			{
+				const bool isNegative = ReadSign();
+
+				float value{};
+				const bool isHex = HasHexPrefix();
+				std::from_chars_result result = std::from_chars(isHex ? _current + 2 : _current, _end, value, isHex ? std::chars_format::hex : std::chars_format::general);
+				if (result.ec != std::errc())
+				{
+					throw runtime_error("Text is not a number.");
+				}
+				_current = result.ptr;
+				return isNegative ? -value : value;
+			}
+
+			vec4 ReadVector(std::string_view prefix)
+			{
+				vec4 value;
+				Expect(prefix);
+				Expect("("sv);
+				for (int i = 0; i < 4; ++i)
+				{
+					if (i > 0) Expect(","sv);
+					value[i] = ReadFloat();
+				}
+				Expect(")"sv);
+				return value;
+			}
+
+			void Expect(std::string_view token)
+			{
+				SkipWhitespace();
+				if (static_cast<size_t>(_end - _current) < token.size() || std::string_view(_current, token.size()) != token)
+				{
+					throw runtime_error("Text is not in the expected format.");
+				}
+				_current += token.size();
+			}
+
+		private:
+			bool ReadSign()
+			{
+				SkipWhitespace();
+				const bool isNegative = _current != _end && *_current == '-';
+				if (_current != _end && (*_current == '+' || *_current == '-')) ++_current;
+				if (_current != _end && (*_current == '+' || *_current == '-'))
+				{
+					throw runtime_error("Text is not a number.");
+				}
+				return isNegative;
+			}
+
+			bool HasHexPrefix() const
+			{
+				return _end - _current > 2 && _current[0] == '0' && (_current[1] == 'x' || _current[1] == 'X');
+			}
+
+			void SkipWhitespace()
+			{
+				while (_current != _end && std::isspace(static_cast<unsigned char>(*_current)))
+				{
+					++_current;
+				}
+			}
+
+			const char* _current;
+			const char* _end;
+		};
+	}
+
 	Datum::Datum(Datum::DatumType type) :
 		_type(type)
 	{
@@ -115,7 +294,7 @@ namespace FieaGameEngine
 	}
 
 	Datum::Datum(const Datum& other) :
-		_type(other._type), _size(other._size), _isExternal(other._isExternal)
+		_type(other._type), _isExternal(other._isExternal)
 	{
 		if (other._size > 0)
 		{
@@ -129,24 +308,40 @@ namespace FieaGameEngine
 				Reserve(other._capacity);
 				CopyFunctor func = _copyFunctors[static_cast<int>(_type)];
 				assert(func != nullptr);
-				(this->*func)(other._data, _size);
+				(this->*func)(other._data, other._size);
 			}
+			_size = other._size;
 		}
 	}
 
 	Datum::Datum(Datum&& other) noexcept :
-		_type(other._type), _data(other._data), _size(other._size), _capacity(other._capacity)
+		_type(other._type), _data(other._data), _size(other._size), _capacity(other._capacity), _isExternal(other._isExternal), _arena(other._arena),
+		_shared(other._shared.load(std::memory_order_acquire)), _isShareable(other._isShareable)
 	{
+		if (other.IsInline())
+		{
+			_data.vp = _inline;
+			other.MoveElements(_inline);
+		}
+
 		other._type = DatumType::Unknown;
 		other._data.vp = nullptr;
 		other._size = 0_z;
 		other._capacity = 0_z;
+		other._isExternal = false;
+		other._shared.store(nullptr, std::memory_order_release);
+		other._isShareable = true;
 	}
 
 	Datum& Datum::operator=(const Datum& other)
 	{
 		if (this != &other)
 		{
+			if (_shared.load(std::memory_order_acquire) != nullptr)
+			{
+				ReleaseShared();
+			}
+
 			_type = other._type;
 			_isExternal = other._isExternal;
 			if (other._isExternal)
@@ -236,6 +431,7 @@ namespace FieaGameEngine
 	Datum& Datum::operator=(const int& value)
 	{
 		SetType(DatumType::Integer);
+		Unshare();
 		if (_size != 1_z) Resize(1_z);
 		*_data.i = value;
 		return *this;
@@ -244,6 +440,7 @@ namespace FieaGameEngine
 	Datum& Datum::operator=(const float& value)
 	{
 		SetType(DatumType::Float);
+		Unshare();
 		if (_size != 1_z) Resize(1_z);
 		*_data.f = value;
 		return *this;
@@ -252,6 +449,7 @@ namespace FieaGameEngine
 	Datum& Datum::operator=(const glm::vec4& value)
 	{
 		SetType(DatumType::Vector);
+		Unshare();
 		if (_size != 1_z) Resize(1_z);
 		*_data.v = value;
 		return *this;
@@ -260,6 +458,7 @@ namespace FieaGameEngine
 	Datum& Datum::operator=(const glm::mat4& value)
 	{
 		SetType(DatumType::Matrix);
+		Unshare();
 		if (_size != 1_z) Resize(1_z);
 		*_data.m = value;
 		return *this;
@@ -276,6 +475,7 @@ namespace FieaGameEngine
 	Datum& Datum::operator=(const std::string& value)
 	{
 		SetType(DatumType::String);
+		Unshare();
 		if (_size != 1_z) Resize(1_z);
 		*_data.s = value;
 		return *this;
@@ -284,6 +484,7 @@ namespace FieaGameEngine
 	Datum& Datum::operator=(RTTI* const& value)
 	{
 		SetType(DatumType::Pointer);
+		Unshare();
 		if (_size != 1_z) Resize(1_z);
 		*_data.p = value;
 		return *this;
@@ -298,11 +499,23 @@ namespace FieaGameEngine
 			_data = other._data;
 			_size = other._size;
 			_capacity = other._capacity;
+			_isExternal = other._isExternal;
+			_arena = other._arena;
+			_shared.store(other._shared.load(std::memory_order_acquire), std::memory_order_release);
+			_isShareable = other._isShareable;
+			if (other.IsInline())
+			{
+				_data.vp = _inline;
+				other.MoveElements(_inline);
+			}
 
 			other._type = DatumType::Unknown;
 			other._data.vp = nullptr;
 			other._size = 0_z;
 			other._capacity = 0_z;
+			other._isExternal = false;
+			other._shared.store(nullptr, std::memory_order_release);
+			other._isShareable = true;
 		}
 		return *this;
 	}
@@ -312,7 +525,10 @@ namespace FieaGameEngine
 		if (!_isExternal)
 		{
 			Clear();
-			free(_data.vp);
+			if (!IsInline())
+			{
+				Free(_data.vp);
+			}
 		}
 	}
 
@@ -354,6 +570,53 @@ namespace FieaGameEngine
 		return _isExternal == false && _size == 0;
 	}
 
+	bool Datum::IsShared() const
+	{
+		const SharedStorage* shared = _shared.load(std::memory_order_acquire);
+		return shared != nullptr && shared->References.load(std::memory_order_acquire) > 1_z;
+	}
+
+	void Datum::Share(const Datum& other)
+	{
+		const SharedStorage* current = _shared.load(std::memory_order_acquire);
+		if (this == &other || (current != nullptr && current == other._shared.load(std::memory_order_acquire)))
+		{
+			return;
+		}
+
+		const bool isShareable = !_isExternal && !other._isExternal && other._isShareable && other._arena == nullptr &&
+			other._size > 0_z && !other.IsInline() && other._type != DatumType::Table && other._type != DatumType::Unknown;
+		if (!isShareable)
+		{
+			*this = other;
+			return;
+		}
+
+		Datum::~Datum();
+		SharedStorage* shared = other._shared.load(std::memory_order_acquire);
+		if (shared == nullptr)
+		{
+			// Copies of the same prototype may race to install its header, the losers use the winner's
+			SharedStorage* created = new SharedStorage;
+			if (other._shared.compare_exchange_strong(shared, created, std::memory_order_acq_rel, std::memory_order_acquire))
+			{
+				shared = created;
+			}
+			else
+			{
+				delete created;
+			}
+		}
+		shared->References.fetch_add(1_z, std::memory_order_relaxed);
+
+		_type = other._type;
+		_data = other._data;
+		_size = other._size;
+		_capacity = other._size;
+		_shared.store(shared, std::memory_order_release);
+		_isShareable = true;
+	}
+
 	void Datum::Reserve(size_t capacity)
 	{
 		if (_isExternal)
@@ -364,16 +627,179 @@ namespace FieaGameEngine
 		{
 			throw runtime_error("Cannot Reserve with an unknown type.");
 		}
+		Unshare();
 
 		if (_capacity < capacity)
 		{
 			size_t size = _sizeMap[static_cast<int>(_type)];
-			void* data = realloc(_data.vp, capacity * size);
+			if (capacity * size <= _inlineSize && (_data.vp == nullptr || IsInline()))
+			{
+				_data.vp = _inline;
+			}
+			else if (IsInline())
+			{
+				void* data = Allocate(capacity * size);
+				MoveElements(data);
+				_data.vp = data;
+			}
+			else
+			{
+				Reallocate(capacity);
+			}
+			_capacity = capacity;
+		}
+	}
+
+	void Datum::ShrinkToFit()
+	{
+		if (_isExternal)
+		{
+			throw runtime_error("Cannot ShrinkToFit with external storage.");
+		}
+		Unshare();
+
+		if (_data.vp != nullptr && !IsInline())
+		{
+			if (_size == 0_z)
+			{
+				Free(_data.vp);
+				_data.vp = nullptr;
+			}
+			else if (_size * _sizeMap[static_cast<int>(_type)] <= _inlineSize)
+			{
+				void* data = _data.vp;
+				MoveElements(_inline);
+				Free(data);
+				_data.vp = _inline;
+			}
+			else
+			{
+				Reallocate(_size);
+			}
+		}
+		_capacity = _size;
+	}
+
+	void Datum::Reallocate(size_t capacity)
+	{
+		const size_t size = capacity * _sizeMap[static_cast<int>(_type)];
+		if (_type == DatumType::String || _arena != nullptr)
+		{
+			// Strings are not trivially relocatable and arenas cannot grow a block in place,
+			// so the elements are moved into a new block
+			void* data = Allocate(size);
+			MoveElements(data);
+			Free(_data.vp);
+			_data.vp = data;
+		}
+		else
+		{
+			void* data = realloc(_data.vp, size);
 			assert(data != nullptr);
 			_data.vp = data;
-			_capacity = capacity;
 		}
 	}
+
+	void* Datum::Allocate(size_t size)
+	{
+		if (_arena != nullptr)
+		{
+			return _arena->Allocate(size);
+		}
+
+		void* data = malloc(size);
+		assert(data != nullptr);
+		return data;
+	}
+
+	void Datum::Free(void* data)
+	{
+		// Arena memory is released all at once by the arena
+		if (_arena == nullptr)
+		{
+			free(data);
+		}
+	}
+	void Datum::UnshareStorage()
+	{
+		SharedStorage* shared = _shared.load(std::memory_order_acquire);
+		assert(shared != nullptr);
+
+		if (_arena == nullptr && shared->References.load(std::memory_order_acquire) == 1_z)
+		{
+			// Every other copy has let go, the buffer is this datum's alone again
+			delete shared;
+			_shared.store(nullptr, std::memory_order_release);
+			return;
+		}
+
+		// Copy while still holding a reference, so no other owner can free the values being copied
+		const DatumValue data = _data;
+		const size_t size = _size;
+
+		_shared.store(nullptr, std::memory_order_release);
+		_data.vp = nullptr;
+		_size = 0_z;
+		_capacity = 0_z;
+		Reserve(size);
+		CopyFunctor func = _copyFunctors[static_cast<int>(_type)];
+		assert(func != nullptr);
+		(this->*func)(data, size);
+		_size = size;
+
+		ReleaseSharedStorage(shared, data, _type, size);
+	}
+
+	void Datum::ReleaseShared()
+	{
+		SharedStorage* shared = _shared.load(std::memory_order_acquire);
+		assert(shared != nullptr);
+
+		ReleaseSharedStorage(shared, _data, _type, _size);
+		_shared.store(nullptr, std::memory_order_release);
+		_data.vp = nullptr;
+		_size = 0_z;
+		_capacity = 0_z;
+	}
+
+	void Datum::ReleaseSharedStorage(SharedStorage* shared, DatumValue data, DatumType type, size_t size)
+	{
+		if (shared->References.fetch_sub(1_z, std::memory_order_acq_rel) == 1_z)
+		{
+			if (type == DatumType::String)
+			{
+				for (size_t i = 0_z; i < size; ++i)
+				{
+					data.s[i].~basic_string();
+				}
+			}
+			free(data.vp);
+			delete shared;
+		}
+	}
+
+	bool Datum::IsInline() const
+	{
+		return _data.vp == static_cast<const void*>(_inline);
+	}
+
+	void Datum::MoveElements(void* destination)
+	{
+		if (_type == DatumType::String)
+		{
+			std::string* strings = static_cast<std::string*>(destination);
+			for (size_t i = 0_z; i < _size; ++i)
+			{
+				new(strings + i)string(std::move(_data.s[i]));
+				_data.s[i].~string();
+			}
+		}
+		else if (_size > 0_z)
+		{
+			memcpy(destination, _data.vp, _size * _sizeMap[static_cast<int>(_type)]);
+		}
+	}
+
 	void Datum::Resize(size_t size)
 	{
 		if (_isExternal)
@@ -384,6 +810,7 @@ namespace FieaGameEngine
 		{
 			throw runtime_error("Cannot Resize with an unknown type.");
 		}
+		Unshare();
 
 		if (size < _size)
 		{
@@ -413,6 +840,12 @@ namespace FieaGameEngine
 		{
 			throw runtime_error("Cannot Clear with external storage.");
 		}
+		if (_shared.load(std::memory_order_acquire) != nullptr)
+		{
+			// Nothing to keep, so the shared buffer is let go instead of copied
+			ReleaseShared();
+			return;
+		}
 		if (_type == DatumType::String)
 		{
 			for (size_t i = 0_z; i < _size; ++i)
@@ -654,29 +1087,34 @@ namespace FieaGameEngine
 		{
 			throw out_of_range("Index out of range, is index the length of the Datum?");
 		}
+		Unshare();
 	}
 
 	int& Datum::GetInteger(size_t index)
 	{
 		GetHelper(DatumType::Integer, index);
+		Expose();
 		return _data.i[index];
 	}
 
 	float& Datum::GetFloat(size_t index)
 	{
 		GetHelper(DatumType::Float, index);
+		Expose();
 		return _data.f[index];
 	}
 
 	vec4& Datum::GetVector(size_t index)
 	{
 		GetHelper(DatumType::Vector, index);
+		Expose();
 		return _data.v[index];
 	}
 
 	mat4& Datum::GetMatrix(size_t index)
 	{
 		GetHelper(DatumType::Matrix, index);
+		Expose();
 		return _data.m[index];
 	}
 
@@ -689,12 +1127,14 @@ namespace FieaGameEngine
 	string& Datum::GetString(size_t index)
 	{
 		GetHelper(DatumType::String, index);
+		Expose();
 		return _data.s[index];
 	}
 
 	RTTI*& Datum::GetPointer(size_t index)
 	{
 		GetHelper(DatumType::Pointer, index);
+		Expose();
 		return _data.p[index];
 	}
 
@@ -755,43 +1195,27 @@ namespace FieaGameEngine
 
 	const int Datum::FromStringToInt(const std::string& str) const
 	{
-		int i;
-		sscanf_s(str.c_str(), "%i", &i);
-		return i;
+		return ParseInteger(str);
 	}
 
 	const float Datum::FromStringToFloat(const std::string& str) const
 	{
-		float f;
-		sscanf_s(str.c_str(), "%f", &f);
-		return f;
+		return ParseFloat(str);
 	}
 
 	const glm::vec4 Datum::FromStringToVector(const std::string& str) const
 	{
-		glm::vec4 v;
-		sscanf_s(str.c_str(), "vec4(%f, %f, %f, %f)", &v[0], &v[1], &v[2], &v[3]);
-		return v;
+		return ParseVector(str);
 	}
 
 	const glm::mat4 Datum::FromStringToMatrix(const std::string& str) const
 	{
-		glm::mat4 m;
-		sscanf_s(str.c_str(), "mat4x4((%f, %f, %f, %f), (%f, %f, %f, %f), (%f, %f, %f, %f), (%f, %f, %f, %f))",
-			&(m[0][0]), &(m[0][1]), &(m[0][2]), &(m[0][3]), &(m[1][0]), &(m[1][1]), &(m[1][2]), &(m[1][3]),
-			&(m[2][0]), &(m[2][1]), &(m[2][2]), &(m[2][3]), &(m[3][0]), &(m[3][1]), &(m[3][2]), &(m[3][3]));
-		return m;
+		return ParseMatrix(str);
 	}
 
 	void Datum::SetFromString(const std::string& str, size_t index)
 	{
-		if (_type == DatumType::Unknown || _type == DatumType::Pointer)
-		{
-			throw std::runtime_error("Cannot SetFromString with an unknown or pointer type");
-		}
-		SetFromStringFunctor func = _setFromStringFunctors[static_cast<int>(_type)];
-		assert(func != nullptr);
-		(this->*func)(str, index);
+		FromChars(str, index);
 	}
 
 	std::string Datum::ToString(size_t index) const
@@ -805,6 +1229,122 @@ namespace FieaGameEngine
 		return (this->*func)(index);
 	}
 
+	size_t Datum::ToChars(char* buffer, size_t length, size_t index) const
+	{
+		if (_type == DatumType::Unknown || _type == DatumType::Table)
+		{
+			throw std::runtime_error("Cannot ToChars with an unknown or table type");
+		}
+		ToCharsFunctor func = _toCharsFunctors[static_cast<int>(_type)];
+		assert(func != nullptr);
+		return (this->*func)(buffer, length, index);
+	}
+
+	void Datum::FromChars(std::string_view text, size_t index)
+	{
+		if (_type == DatumType::Unknown || _type == DatumType::Table || _type == DatumType::Pointer)
+		{
+			throw std::runtime_error("Cannot SetFromString with an unknown, table or pointer type");
+		}
+		SetFromStringFunctor func = _setFromStringFunctors[static_cast<int>(_type)];
+		assert(func != nullptr);
+		(this->*func)(text, index);
+	}
+
+	void Datum::PushBackFromChars(std::string_view text)
+	{
+		if (_type == DatumType::Unknown || _type == DatumType::Table || _type == DatumType::Pointer)
+		{
+			throw std::runtime_error("Cannot PushBackFromString with an unknown, table or pointer type");
+		}
+		PushBackFromStringFunctor func = _pushBackFromStringFunctors[static_cast<int>(_type)];
+		assert(func != nullptr);
+		(this->*func)(text);
+	}
+
+#pragma region Text Conversion
+	size_t Datum::ToCharsIntegers(char* buffer, size_t length, size_t index) const
+	{
+		CharsWriter writer(buffer, length);
+		writer.Write(GetInteger(index));
+		return writer.Size();
+	}
+
+	size_t Datum::ToCharsFloats(char* buffer, size_t length, size_t index) const
+	{
+		CharsWriter writer(buffer, length);
+		writer.Write(GetFloat(index));
+		return writer.Size();
+	}
+
+	size_t Datum::ToCharsVectors(char* buffer, size_t length, size_t index) const
+	{
+		CharsWriter writer(buffer, length);
+		writer.Write(GetVector(index), "vec4"sv);
+		return writer.Size();
+	}
+
+	size_t Datum::ToCharsMatrixes(char* buffer, size_t length, size_t index) const
+	{
+		const mat4& matrix = GetMatrix(index);
+		CharsWriter writer(buffer, length);
+		writer.Write("mat4x4("sv);
+		for (int column = 0; column < 4; ++column)
+		{
+			if (column > 0) writer.Write(", "sv);
+			writer.Write(matrix[column], ""sv);
+		}
+		writer.Write(")"sv);
+		return writer.Size();
+	}
+
+	size_t Datum::ToCharsStrings(char* buffer, size_t length, size_t index) const
+	{
+		CharsWriter writer(buffer, length);
+		writer.Write(GetString(index));
+		return writer.Size();
+	}
+
+	size_t Datum::ToCharsPointers(char* buffer, size_t length, size_t index) const
+	{
+		CharsWriter writer(buffer, length);
+		writer.Write(GetPointer(index)->ToString());
+		return writer.Size();
+	}
+
+	int Datum::ParseInteger(std::string_view text)
+	{
+		CharsReader reader(text);
+		return reader.ReadInteger();
+	}
+
+	float Datum::ParseFloat(std::string_view text)
+	{
+		CharsReader reader(text);
+		return reader.ReadFloat();
+	}
+
+	vec4 Datum::ParseVector(std::string_view text)
+	{
+		CharsReader reader(text);
+		return reader.ReadVector("vec4"sv);
+	}
+
+	mat4 Datum::ParseMatrix(std::string_view text)
+	{
+		CharsReader reader(text);
+		mat4 value;
+		reader.Expect("mat4x4("sv);
+		for (int column = 0; column < 4; ++column)
+		{
+			if (column > 0) reader.Expect(","sv);
+			value[column] = reader.ReadVector(""sv);
+		}
+		reader.Expect(")"sv);
+		return value;
+	}
+#pragma endregion
+
 	void Datum::PopBack()
 	{
 		if (_isExternal)
@@ -815,6 +1355,7 @@ namespace FieaGameEngine
 		{
 			throw std::runtime_error("Cannot PopBack on an unknown datum type.");
 		}
+		Unshare();
 		if (!IsEmpty())
 		{
 			--_size;
@@ -828,36 +1369,42 @@ namespace FieaGameEngine
 	int& Datum::FrontInteger()
 	{
 		FrontHelper(DatumType::Integer);
+		Expose();
 		return _data.i[0_z];
 	}
 
 	float& Datum::FrontFloat()
 	{
 		FrontHelper(DatumType::Float);
+		Expose();
 		return _data.f[0_z];
 	}
 
 	vec4& Datum::FrontVector()
 	{
 		FrontHelper(DatumType::Vector);
+		Expose();
 		return _data.v[0_z];
 	}
 
 	mat4& Datum::FrontMatrix()
 	{
 		FrontHelper(DatumType::Matrix);
+		Expose();
 		return _data.m[0_z];
 	}
 
 	string& Datum::FrontString()
 	{
 		FrontHelper(DatumType::String);
+		Expose();
 		return _data.s[0_z];
 	}
 
 	RTTI*& Datum::FrontPointer()
 	{
 		FrontHelper(DatumType::Pointer);
+		Expose();
 		return _data.p[0_z];
 	}
 
@@ -911,36 +1458,42 @@ namespace FieaGameEngine
 	int& Datum::BackInteger()
 	{
 		BackHelper(DatumType::Integer);
+		Expose();
 		return _data.i[_size - 1_z];
 	}
 
 	float& Datum::BackFloat()
 	{
 		BackHelper(DatumType::Float);
+		Expose();
 		return _data.f[_size - 1_z];
 	}
 
 	vec4& Datum::BackVector()
 	{
 		BackHelper(DatumType::Vector);
+		Expose();
 		return _data.v[_size - 1_z];
 	}
 
 	mat4& Datum::BackMatrix()
 	{
 		BackHelper(DatumType::Matrix);
+		Expose();
 		return _data.m[_size - 1_z];
 	}
 
 	string& Datum::BackString()
 	{
 		BackHelper(DatumType::String);
+		Expose();
 		return _data.s[_size - 1_z];
 	}
 
 	RTTI*& Datum::BackPointer()
 	{
 		BackHelper(DatumType::Pointer);
+		Expose();
 		return _data.p[_size - 1_z];
 	}
 
@@ -1002,6 +1555,7 @@ namespace FieaGameEngine
 		{
 			throw out_of_range("Index out of range.");
 		}
+		Unshare();
 
 		if (_type == DatumType::String)
 		{
@@ -1020,4 +1574,207 @@ namespace FieaGameEngine
 		--_size;
 	}
 
+	void Datum::RemoveAtSwap(size_t index)
+	{
+		if (_isExternal)
+		{
+			throw std::runtime_error("Cannot remove from a Datum with external storage");
+		}
+
+		if (index >= _size)
+		{
+			throw out_of_range("Index out of range.");
+		}
+		Unshare();
+
+		const size_t last = _size - 1_z;
+		if (_type == DatumType::String)
+		{
+			if (index != last)
+			{
+				_data.s[index] = std::move(_data.s[last]);
+			}
+			_data.s[last].~basic_string();
+		}
+		else if (index != last)
+		{
+			const auto elementSize = _sizeMap[static_cast<size_t>(_type)];
+			uint8_t* data = reinterpret_cast<uint8_t*>(_data.vp);
+			memcpy(data + index * elementSize, data + last * elementSize, elementSize);
+		}
+		--_size;
+	}
+
+#pragma region Bulk Access
+	span<int> Datum::Integers()
+	{
+		Expose();
+		return SpanHelper<int>(DatumType::Integer);
+	}
+
+	span<const int> Datum::Integers() const
+	{
+		return SpanHelper<const int>(DatumType::Integer);
+	}
+
+	span<float> Datum::Floats()
+	{
+		Expose();
+		return SpanHelper<float>(DatumType::Float);
+	}
+
+	span<const float> Datum::Floats() const
+	{
+		return SpanHelper<const float>(DatumType::Float);
+	}
+
+	span<vec4> Datum::Vectors()
+	{
+		Expose();
+		return SpanHelper<vec4>(DatumType::Vector);
+	}
+
+	span<const vec4> Datum::Vectors() const
+	{
+		return SpanHelper<const vec4>(DatumType::Vector);
+	}
+
+	span<mat4> Datum::Matrixes()
+	{
+		Expose();
+		return SpanHelper<mat4>(DatumType::Matrix);
+	}
+
+	span<const mat4> Datum::Matrixes() const
+	{
+		return SpanHelper<const mat4>(DatumType::Matrix);
+	}
+
+	span<string> Datum::Strings()
+	{
+		Expose();
+		return SpanHelper<string>(DatumType::String);
+	}
+
+	span<const string> Datum::Strings() const
+	{
+		return SpanHelper<const string>(DatumType::String);
+	}
+
+	span<RTTI*> Datum::Pointers()
+	{
+		Expose();
+		return SpanHelper<RTTI*>(DatumType::Pointer);
+	}
+
+	span<RTTI* const> Datum::Pointers() const
+	{
+		return SpanHelper<RTTI* const>(DatumType::Pointer);
+	}
+
+	void Datum::Append(span<const int> values)
+	{
+		AppendHelper(DatumType::Integer, values);
+	}
+
+	void Datum::Append(span<const float> values)
+	{
+		AppendHelper(DatumType::Float, values);
+	}
+
+	void Datum::Append(span<const vec4> values)
+	{
+		AppendHelper(DatumType::Vector, values);
+	}
+
+	void Datum::Append(span<const mat4> values)
+	{
+		AppendHelper(DatumType::Matrix, values);
+	}
+
+	void Datum::Append(span<const string> values)
+	{
+		AppendHelper(DatumType::String, values);
+	}
+
+	void Datum::Append(span<RTTI* const> values)
+	{
+		AppendHelper(DatumType::Pointer, values);
+	}
+
+	void Datum::Assign(span<const int> values)
+	{
+		AssignHelper(DatumType::Integer, values);
+	}
+
+	void Datum::Assign(span<const float> values)
+	{
+		AssignHelper(DatumType::Float, values);
+	}
+
+	void Datum::Assign(span<const vec4> values)
+	{
+		AssignHelper(DatumType::Vector, values);
+	}
+
+	void Datum::Assign(span<const mat4> values)
+	{
+		AssignHelper(DatumType::Matrix, values);
+	}
+
+	void Datum::Assign(span<const string> values)
+	{
+		AssignHelper(DatumType::String, values);
+	}
+
+	void Datum::Assign(span<RTTI* const> values)
+	{
+		AssignHelper(DatumType::Pointer, values);
+	}
+
+	size_t Datum::RemoveAll(const int& value)
+	{
+		return RemoveAllHelper(DatumType::Integer, value);
+	}
+
+	size_t Datum::RemoveAll(const float& value)
+	{
+		return RemoveAllHelper(DatumType::Float, value);
+	}
+
+	size_t Datum::RemoveAll(const vec4& value)
+	{
+		return RemoveAllHelper(DatumType::Vector, value);
+	}
+
+	void Datum::Fill(const int& value)
+	{
+		FillHelper(DatumType::Integer, value);
+	}
+
+	void Datum::Fill(const float& value)
+	{
+		FillHelper(DatumType::Float, value);
+	}
+
+	void Datum::Fill(const vec4& value)
+	{
+		FillHelper(DatumType::Vector, value);
+	}
+
+	void Datum::Fill(const mat4& value)
+	{
+		FillHelper(DatumType::Matrix, value);
+	}
+
+	void Datum::Fill(const string& value)
+	{
+		FillHelper(DatumType::String, value);
+	}
+
+	void Datum::Fill(RTTI* const& value)
+	{
+		FillHelper(DatumType::Pointer, value);
+	}
+#pragma endregion
 }
\ No newline at end of file
@@ -2,30 +2,46 @@
 
 #include <glm/glm.hpp>
 #include <glm/gtx/string_cast.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <span>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <initializer_list>
 
 #include "DefaultIncrement.h"
 #include "DefaultEquality.h"
 #include "HashMap.h"
 #include "RTTI.h"
+#include "SimdMath.h"
 #include "SizeLiteral.h"
 
 namespace FieaGameEngine
 {
 	class Scope;
 	class Attributed;
+	class Arena;
+	class ScopeTable;
+	template <typename T>
+	class TypedDatumRef;
 
 	/// <summary>
 	/// Datum is a vector of values. The values given in Datum have a single type - either
 	/// a primitive type or a user-defined type. It is able to represent a reference to
 	/// a Scope, and so the pair forms a recursive data structure, able to represent arbitrary
 	/// data structure topologies akin to classes in an object-oriented programming language. 
+	/// Small internal arrays (a single int, float, vec4, pointer or string) are stored inside the
+	/// Datum itself and need no heap allocation.
 	/// </summary>
 	class Datum final
 	{
 		friend Scope;
 		friend Attributed;
+		friend ScopeTable;
+		template <typename T>
+		friend class TypedDatumRef;
 
 	public:
 		/// <summary>
@@ -280,6 +296,22 @@ namespace FieaGameEngine
 		/// </summary>
 		/// <returns>isExternal</returns>
 		bool IsExternal() const;
+		/// <summary>
+		/// Does the datum still read its values from a buffer shared with other datums (see Share)?
+		/// </summary>
+		/// <returns>true if the buffer is shared</returns>
+		bool IsShared() const;
+		/// <summary>
+		/// Makes this datum a copy-on-write copy of other. Both datums read the same buffer until either
+		/// one is modified, which then copies the values into a buffer of its own. Prefab instances made by
+		/// copying a Scope share their prototype's values this way and only pay for the ones they change.
+		/// Falls back to an ordinary copy when the buffer cannot be shared: external, inline or arena storage,
+		/// tables, or a buffer a mutable reference (Get, Front, Back, spans, TypedRef) was handed out from.
+		/// Several threads may share the same datum at once (e.g. spawning one prefab from worker
+		/// threads) as long as none of them modifies it meanwhile.
+		/// </summary>
+		/// <param name="other">datum to share with</param>
+		void Share(const Datum& other);
 
 		/// <summary>
 		/// is datum empty?
@@ -289,6 +321,7 @@ namespace FieaGameEngine
 
 		/// <summary>
 		/// Reserves capacity amount of memory to later initialize when needed.
+		/// Capacities that fit in the Datum's inline buffer do not allocate.
 		/// </summary>
 		/// <param name="capacity">how much capacity to reserve for Datum</param>
 		/// <exception cref="runtime_error">Exception thrown if datum has unknown type.</exception>
@@ -300,6 +333,11 @@ namespace FieaGameEngine
 		/// <param name="size">size to resize to</param>
 		/// <exception cref="runtime_error">Exception thrown if datum has unknown type.</exception>
 		void Resize(size_t size);
+		/// <summary>
+		/// Shrinks capacity down to size, moving the elements back inside the Datum when they fit.
+		/// </summary>
+		/// <exception cref="runtime_error">Exception thrown if datum has external storage.</exception>
+		void ShrinkToFit();
 
 		/// <summary>
 		/// Completely clears the datum vector of its data leaving it empty, does not affect its capacity.
@@ -641,6 +679,35 @@ namespace FieaGameEngine
 		/// <exception cref="runtime_error">cannot convert to string with an unknown type</exception>
 		std::string ToString(size_t index = 0) const;
 
+		/// <summary>
+		/// Writes the same text as ToString into buffer without allocating (except for pointers,
+		/// whose text comes from RTTI::ToString). No terminating null is written.
+		/// </summary>
+		/// <param name="buffer">buffer to write to</param>
+		/// <param name="length">size of the buffer</param>
+		/// <param name="index">index of value to write</param>
+		/// <returns>number of characters written</returns>
+		/// <exception cref="runtime_error">cannot convert an unknown or table type, or the buffer is too small</exception>
+		/// <exception cref="out_of_range">exception thrown if index out of bounds</exception>
+		size_t ToChars(char* buffer, size_t length, size_t index = 0) const;
+		/// <summary>
+		/// Parses text in the format written by ToChars and assigns it to the element at index,
+		/// without building a temporary string.
+		/// </summary>
+		/// <param name="text">text to parse</param>
+		/// <param name="index">index to set</param>
+		/// <exception cref="runtime_error">cannot set from text with an unknown, table or pointer type</exception>
+		/// <exception cref="runtime_error">text does not start with a valid value of the datum's type</exception>
+		/// <exception cref="out_of_range">exception thrown if index out of bounds</exception>
+		void FromChars(std::string_view text, size_t index = 0);
+		/// <summary>
+		/// Parses text in the format written by ToChars and pushes it to the back of the datum.
+		/// </summary>
+		/// <param name="text">text to parse</param>
+		/// <exception cref="runtime_error">cannot push from text with an unknown, table or pointer type</exception>
+		/// <exception cref="runtime_error">text does not start with a valid value of the datum's type</exception>
+		void PushBackFromChars(std::string_view text);
+
 
 		template<typename IncrementFunctor = FieaGameEngine::DefaultIncrement>
 		void PushBackFromString(const std::string& str);
@@ -990,6 +1057,36 @@ namespace FieaGameEngine
 		/// <param name="value">value to find and remove</param>
 		/// <returns>true if remove was successful false otherwise</returns>
 		void RemoveAt(size_t index);
+		/// <summary>
+		/// Removes the element at index by moving the last element into its place. Constant time,
+		/// but the order of the remaining elements is not preserved.
+		/// </summary>
+		/// <param name="index">index of the element to remove</param>
+		/// <exception cref="runtime_error">throws exception if datum is external</exception>
+		/// <exception cref="out_of_range">throws exception if index is out of range</exception>
+		void RemoveAtSwap(size_t index);
+
+		/// <summary>
+		/// Removes every int equal to value in one branch-free pass, keeping the order of the rest.
+		/// </summary>
+		/// <param name="value">value to remove</param>
+		/// <returns>number of elements removed</returns>
+		/// <exception cref="runtime_error">throws exception if datum is external, unknown or not same type</exception>
+		size_t RemoveAll(const int& value);
+		/// <summary>
+		/// Removes every float equal to value in one branch-free pass, keeping the order of the rest.
+		/// </summary>
+		/// <param name="value">value to remove</param>
+		/// <returns>number of elements removed</returns>
+		/// <exception cref="runtime_error">throws exception if datum is external, unknown or not same type</exception>
+		size_t RemoveAll(const float& value);
+		/// <summary>
+		/// Removes every vector equal to value in one branch-free pass, keeping the order of the rest.
+		/// </summary>
+		/// <param name="value">value to remove</param>
+		/// <returns>number of elements removed</returns>
+		/// <exception cref="runtime_error">throws exception if datum is external, unknown or not same type</exception>
+		size_t RemoveAll(const glm::vec4& value);
 
 		/// <summary>
 		/// Finds and returns index of int passed in, if not found it returns Size().
@@ -1100,6 +1197,212 @@ namespace FieaGameEngine
 		template<typename EqualityFunctor = DefaultEquality<RTTI*>>
 		const size_t IndexOf(RTTI* const& value, EqualityFunctor equalityFunctor = EqualityFunctor{}) const;
 
+#pragma region Bulk Access
+		/// <summary>
+		/// Typed view of every int in the datum. The type is checked once, so loops over the span
+		/// run without per-element checks. The span is invalidated by anything that reallocates the datum.
+		/// </summary>
+		/// <returns>span over the ints of the datum</returns>
+		/// <exception cref="runtime_error">throws exception if datum is unknown or not same type</exception>
+		std::span<int> Integers();
+		/// <summary>
+		/// Const typed view of every int in the datum.
+		/// </summary>
+		/// <returns>span over the ints of the datum</returns>
+		/// <exception cref="runtime_error">throws exception if datum is unknown or not same type</exception>
+		std::span<const int> Integers() const;
+		/// <summary>
+		/// Typed view of every float in the datum. The type is checked once, so loops over the span
+		/// run without per-element checks. The span is invalidated by anything that reallocates the datum.
+		/// </summary>
+		/// <returns>span over the floats of the datum</returns>
+		/// <exception cref="runtime_error">throws exception if datum is unknown or not same type</exception>
+		std::span<float> Floats();
+		/// <summary>
+		/// Const typed view of every float in the datum.
+		/// </summary>
+		/// <returns>span over the floats of the datum</returns>
+		/// <exception cref="runtime_error">throws exception if datum is unknown or not same type</exception>
+		std::span<const float> Floats() const;
+		/// <summary>
+		/// Typed view of every vec4 in the datum. The type is checked once, so loops over the span
+		/// run without per-element checks. The span is invalidated by anything that reallocates the datum.
+		/// </summary>
+		/// <returns>span over the vec4s of the datum</returns>
+		/// <exception cref="runtime_error">throws exception if datum is unknown or not same type</exception>
+		std::span<glm::vec4> Vectors();
+		/// <summary>
+		/// Const typed view of every vec4 in the datum.
+		/// </summary>
+		/// <returns>span over the vec4s of the datum</returns>
+		/// <exception cref="runtime_error">throws exception if datum is unknown or not same type</exception>
+		std::span<const glm::vec4> Vectors() const;
+		/// <summary>
+		/// Typed view of every mat4 in the datum. The type is checked once, so loops over the span
+		/// run without per-element checks. The span is invalidated by anything that reallocates the datum.
+		/// </summary>
+		/// <returns>span over the mat4s of the datum</returns>
+		/// <exception cref="runtime_error">throws exception if datum is unknown or not same type</exception>
+		std::span<glm::mat4> Matrixes();
+		/// <summary>
+		/// Const typed view of every mat4 in the datum.
+		/// </summary>
+		/// <returns>span over the mat4s of the datum</returns>
+		/// <exception cref="runtime_error">throws exception if datum is unknown or not same type</exception>
+		std::span<const glm::mat4> Matrixes() const;
+		/// <summary>
+		/// Typed view of every string in the datum. The type is checked once, so loops over the span
+		/// run without per-element checks. The span is invalidated by anything that reallocates the datum.
+		/// </summary>
+		/// <returns>span over the strings of the datum</returns>
+		/// <exception cref="runtime_error">throws exception if datum is unknown or not same type</exception>
+		std::span<std::string> Strings();
+		/// <summary>
+		/// Const typed view of every string in the datum.
+		/// </summary>
+		/// <returns>span over the strings of the datum</returns>
+		/// <exception cref="runtime_error">throws exception if datum is unknown or not same type</exception>
+		std::span<const std::string> Strings() const;
+		/// <summary>
+		/// Typed view of every pointer in the datum. The type is checked once, so loops over the span
+		/// run without per-element checks. The span is invalidated by anything that reallocates the datum.
+		/// </summary>
+		/// <returns>span over the pointers of the datum</returns>
+		/// <exception cref="runtime_error">throws exception if datum is unknown or not same type</exception>
+		std::span<RTTI*> Pointers();
+		/// <summary>
+		/// Const typed view of every pointer in the datum.
+		/// </summary>
+		/// <returns>span over the pointers of the datum</returns>
+		/// <exception cref="runtime_error">throws exception if datum is unknown or not same type</exception>
+		std::span<RTTI* const> Pointers() const;
+		/// <summary>
+		/// Appends every int of the range, reserving once for all of them. Sets the type if it is unknown.
+		/// </summary>
+		/// <param name="values">values to append, they may view this datum</param>
+		/// <exception cref="runtime_error">throws exception if datum is external or not same type</exception>
+		void Append(std::span<const int> values);
+		/// <summary>
+		/// Appends every float of the range, reserving once for all of them. Sets the type if it is unknown.
+		/// </summary>
+		/// <param name="values">values to append, they may view this datum</param>
+		/// <exception cref="runtime_error">throws exception if datum is external or not same type</exception>
+		void Append(std::span<const float> values);
+		/// <summary>
+		/// Appends every vec4 of the range, reserving once for all of them. Sets the type if it is unknown.
+		/// </summary>
+		/// <param name="values">values to append, they may view this datum</param>
+		/// <exception cref="runtime_error">throws exception if datum is external or not same type</exception>
+		void Append(std::span<const glm::vec4> values);
+		/// <summary>
+		/// Appends every mat4 of the range, reserving once for all of them. Sets the type if it is unknown.
+		/// </summary>
+		/// <param name="values">values to append, they may view this datum</param>
+		/// <exception cref="runtime_error">throws exception if datum is external or not same type</exception>
+		void Append(std::span<const glm::mat4> values);
+		/// <summary>
+		/// Appends every string of the range, reserving once for all of them. Sets the type if it is unknown.
+		/// </summary>
+		/// <param name="values">values to append, they may view this datum</param>
+		/// <exception cref="runtime_error">throws exception if datum is external or not same type</exception>
+		void Append(std::span<const std::string> values);
+		/// <summary>
+		/// Appends every pointer of the range, reserving once for all of them. Sets the type if it is unknown.
+		/// </summary>
+		/// <param name="values">values to append, they may view this datum</param>
+		/// <exception cref="runtime_error">throws exception if datum is external or not same type</exception>
+		void Append(std::span<RTTI* const> values);
+		/// <summary>
+		/// Replaces the contents of the datum with the ints of the range. Sets the type if it is unknown.
+		/// </summary>
+		/// <param name="values">values to assign, they may view this datum</param>
+		/// <exception cref="runtime_error">throws exception if datum is external or not same type</exception>
+		void Assign(std::span<const int> values);
+		/// <summary>
+		/// Replaces the contents of the datum with the floats of the range. Sets the type if it is unknown.
+		/// </summary>
+		/// <param name="values">values to assign, they may view this datum</param>
+		/// <exception cref="runtime_error">throws exception if datum is external or not same type</exception>
+		void Assign(std::span<const float> values);
+		/// <summary>
+		/// Replaces the contents of the datum with the vec4s of the range. Sets the type if it is unknown.
+		/// </summary>
+		/// <param name="values">values to assign, they may view this datum</param>
+		/// <exception cref="runtime_error">throws exception if datum is external or not same type</exception>
+		void Assign(std::span<const glm::vec4> values);
+		/// <summary>
+		/// Replaces the contents of the datum with the mat4s of the range. Sets the type if it is unknown.
+		/// </summary>
+		/// <param name="values">values to assign, they may view this datum</param>
+		/// <exception cref="runtime_error">throws exception if datum is external or not same type</exception>
+		void Assign(std::span<const glm::mat4> values);
+		/// <summary>
+		/// Replaces the contents of the datum with the strings of the range. Sets the type if it is unknown.
+		/// </summary>
+		/// <param name="values">values to assign, they may view this datum</param>
+		/// <exception cref="runtime_error">throws exception if datum is external or not same type</exception>
+		void Assign(std::span<const std::string> values);
+		/// <summary>
+		/// Replaces the contents of the datum with the pointers of the range. Sets the type if it is unknown.
+		/// </summary>
+		/// <param name="values">values to assign, they may view this datum</param>
+		/// <exception cref="runtime_error">throws exception if datum is external or not same type</exception>
+		void Assign(std::span<RTTI* const> values);
+		/// <summary>
+		/// Sets every int of the datum to value. Works on external storage.
+		/// </summary>
+		/// <param name="value">value to set every element to</param>
+		/// <exception cref="runtime_error">throws exception if datum is unknown or not same type</exception>
+		void Fill(const int& value);
+		/// <summary>
+		/// Sets every float of the datum to value. Works on external storage.
+		/// </summary>
+		/// <param name="value">value to set every element to</param>
+		/// <exception cref="runtime_error">throws exception if datum is unknown or not same type</exception>
+		void Fill(const float& value);
+		/// <summary>
+		/// Sets every vec4 of the datum to value. Works on external storage.
+		/// </summary>
+		/// <param name="value">value to set every element to</param>
+		/// <exception cref="runtime_error">throws exception if datum is unknown or not same type</exception>
+		void Fill(const glm::vec4& value);
+		/// <summary>
+		/// Sets every mat4 of the datum to value. Works on external storage.
+		/// </summary>
+		/// <param name="value">value to set every element to</param>
+		/// <exception cref="runtime_error">throws exception if datum is unknown or not same type</exception>
+		void Fill(const glm::mat4& value);
+		/// <summary>
+		/// Sets every string of the datum to value. Works on external storage.
+		/// </summary>
+		/// <param name="value">value to set every element to</param>
+		/// <exception cref="runtime_error">throws exception if datum is unknown or not same type</exception>
+		void Fill(const std::string& value);
+		/// <summary>
+		/// Sets every pointer of the datum to value. Works on external storage.
+		/// </summary>
+		/// <param name="value">value to set every element to</param>
+		/// <exception cref="runtime_error">throws exception if datum is unknown or not same type</exception>
+		void Fill(RTTI* const& value);
+		/// <summary>
+		/// Statically typed handle to the datum, checked once here. Indexing and iterating the handle are
+		/// unchecked in release builds (asserted in debug builds), so code reading the same datum many
+		/// times pays for the type check only once. Unlike a span, the handle stays valid when the datum
+		/// reallocates. T is one of int, float, glm::vec4, glm::mat4, std::string or RTTI*.
+		/// </summary>
+		/// <returns>typed handle to the datum</returns>
+		/// <exception cref="runtime_error">throws exception if datum is unknown or not same type</exception>
+		template <typename T>
+		TypedDatumRef<T> TypedRef();
+		/// <summary>
+		/// Const statically typed handle to the datum, checked once here.
+		/// </summary>
+		/// <returns>typed handle to the datum</returns>
+		/// <exception cref="runtime_error">throws exception if datum is unknown or not same type</exception>
+		template <typename T>
+		TypedDatumRef<const T> TypedRef() const;
+#pragma endregion
+
 		static const HashMap<std::string, DatumType> DatumTypeMap;
 
 
@@ -1120,6 +1423,34 @@ namespace FieaGameEngine
 		size_t _size{ 0_z };
 		size_t _capacity{ 0_z};
 		bool _isExternal = false;
+		// Where heap buffers come from, nullptr for malloc. It follows the buffer when the datum is moved.
+		Arena* _arena{ nullptr };
+
+		struct SharedStorage final
+		{
+			std::atomic<size_t> References{ 1 };
+		};
+
+		// Header of a buffer shared by copy-on-write copies, nullptr while the datum owns its buffer.
+		// Shared buffers always come from the heap. Const copies install it, possibly from several threads.
+		mutable std::atomic<SharedStorage*> _shared{ nullptr };
+		// Cleared once a mutable reference into the buffer has been handed out, the buffer is never shared after that
+		bool _isShareable{ true };
+
+		inline static constexpr size_t _inlineSize = sizeof(std::string) > sizeof(glm::vec4) ? sizeof(std::string) : sizeof(glm::vec4);
+		inline static constexpr size_t _inlineAlignment = alignof(std::string) > alignof(glm::vec4) ? alignof(std::string) : alignof(glm::vec4);
+		alignas(_inlineAlignment) std::byte _inline[_inlineSize];
+
+		bool IsInline() const;
+		void MoveElements(void* destination);
+		void Reallocate(size_t capacity);
+		void* Allocate(size_t size);
+		void Free(void* data);
+		void Unshare();
+		void Expose();
+		void UnshareStorage();
+		void ReleaseShared();
+		static void ReleaseSharedStorage(SharedStorage* shared, DatumValue data, DatumType type, size_t size);
 
 		void Set(Scope& value, size_t index = 0);
 		template<typename IncrementFunctor = DefaultIncrement>
@@ -1131,7 +1462,19 @@ namespace FieaGameEngine
 		template<typename IncrementFunctor = DefaultIncrement>
 		void PushBackHelper(DatumType type, IncrementFunctor incrementFunctor = IncrementFunctor{});
 		void FrontHelper(DatumType type) const;
+		template<typename T>
+		std::span<T> SpanHelper(DatumType type) const;
+		template<typename T>
+		void AppendHelper(DatumType type, std::span<const T> values);
+		template<typename T>
+		void AssignHelper(DatumType type, std::span<const T> values);
+		template<typename T>
+		size_t RemoveAllHelper(DatumType type, const T& value);
+		template<typename T>
+		void FillHelper(DatumType type, const T& value);
 		void BackHelper(DatumType type) const;
+		template<typename T>
+		static constexpr DatumType TypeOf();
 
 		static const size_t _sizeMap[static_cast<int>(DatumType::Unknown)];
 
@@ -1162,13 +1505,13 @@ namespace FieaGameEngine
 		using CompareFunctor = bool (Datum::*) (const Datum& rhs) const;
 		static const CompareFunctor _compareFunctors[static_cast<int>(DatumType::Unknown) + 1];
 
-		void SetFromStringIntegers(const std::string& str, size_t index);
-		void SetFromStringFloats(const std::string& str, size_t index);
-		void SetFromStringVectors(const std::string& str, size_t index);
-		void SetFromStringMatrixes(const std::string& str, size_t index);
-		void SetFromStringStrings(const std::string& str, size_t index);
+		void SetFromStringIntegers(std::string_view text, size_t index);
+		void SetFromStringFloats(std::string_view text, size_t index);
+		void SetFromStringVectors(std::string_view text, size_t index);
+		void SetFromStringMatrixes(std::string_view text, size_t index);
+		void SetFromStringStrings(std::string_view text, size_t index);
 
-		using SetFromStringFunctor = void (Datum::*) (const std::string& str, size_t index);
+		using SetFromStringFunctor = void (Datum::*) (std::string_view text, size_t index);
 		static const SetFromStringFunctor _setFromStringFunctors[static_cast<int>(DatumType::Unknown) + 1];
 
 		std::string ToStringIntegers(size_t index) const;
@@ -1181,15 +1524,103 @@ namespace FieaGameEngine
 		using ToStringFunctor = std::string (Datum::*) (size_t index) const;
 		static const ToStringFunctor _toStringFunctors[static_cast<int>(DatumType::Unknown) + 1];
 
-		void PushBackFromStringIntegers(const std::string& str);
-		void PushBackFromStringFloats(const std::string& str);
-		void PushBackFromStringVectors(const std::string& str);
-		void PushBackFromStringMatrixes(const std::string& str);
-		void PushBackFromStringStrings(const std::string& str);
+		size_t ToCharsIntegers(char* buffer, size_t length, size_t index) const;
+		size_t ToCharsFloats(char* buffer, size_t length, size_t index) const;
+		size_t ToCharsVectors(char* buffer, size_t length, size_t index) const;
+		size_t ToCharsMatrixes(char* buffer, size_t length, size_t index) const;
+		size_t ToCharsStrings(char* buffer, size_t length, size_t index) const;
+		size_t ToCharsPointers(char* buffer, size_t length, size_t index) const;
+
+		using ToCharsFunctor = size_t (Datum::*) (char* buffer, size_t length, size_t index) const;
+		static const ToCharsFunctor _toCharsFunctors[static_cast<int>(DatumType::Unknown) + 1];
 
-		using PushBackFromStringFunctor = void (Datum::*) (const std::string& str);
+		static int ParseInteger(std::string_view text);
+		static float ParseFloat(std::string_view text);
+		static glm::vec4 ParseVector(std::string_view text);
+		static glm::mat4 ParseMatrix(std::string_view text);
+		inline static constexpr size_t _maxCharsLength{ 1024 };
+
+		void PushBackFromStringIntegers(std::string_view text);
+		void PushBackFromStringFloats(std::string_view text);
+		void PushBackFromStringVectors(std::string_view text);
+		void PushBackFromStringMatrixes(std::string_view text);
+		void PushBackFromStringStrings(std::string_view text);
+
+		using PushBackFromStringFunctor = void (Datum::*) (std::string_view text);
 		static const PushBackFromStringFunctor _pushBackFromStringFunctors[static_cast<int>(DatumType::Unknown) + 1];
 	};
+
+	/// <summary>
+	/// Statically typed handle to a Datum, made by Datum::TypedRef once the type is checked.
+	/// Element access goes straight to the datum's storage: bounds and type are only asserted in
+	/// debug builds. The handle refers to the datum, not its storage, so it survives the datum
+	/// growing, but not the datum being destroyed or changing type.
+	/// </summary>
+	/// <typeparam name="T">element type, const for read-only handles</typeparam>
+	template <typename T>
+	class TypedDatumRef final
+	{
+		friend Datum;
+
+	public:
+		using DatumReference = std::conditional_t<std::is_const_v<T>, const Datum, Datum>;
+		using value_type = std::remove_const_t<T>;
+		using iterator = T*;
+
+		TypedDatumRef(const TypedDatumRef&) = default;
+		TypedDatumRef(TypedDatumRef&&) noexcept = default;
+		TypedDatumRef& operator=(const TypedDatumRef&) = default;
+		TypedDatumRef& operator=(TypedDatumRef&&) noexcept = default;
+		~TypedDatumRef() = default;
+
+		/// <summary>
+		/// Element at index, unchecked in release builds.
+		/// </summary>
+		/// <param name="index">index of the element, must be less than Size()</param>
+		/// <returns>reference to the element</returns>
+		T& operator[](size_t index) const;
+		/// <summary>
+		/// First element, unchecked in release builds.
+		/// </summary>
+		/// <returns>reference to the first element</returns>
+		T& Front() const;
+		/// <summary>
+		/// Last element, unchecked in release builds.
+		/// </summary>
+		/// <returns>reference to the last element</returns>
+		T& Back() const;
+		/// <summary>
+		/// Number of elements in the datum.
+		/// </summary>
+		/// <returns>size of the datum</returns>
+		size_t Size() const;
+		/// <summary>
+		/// Does the datum have no elements?
+		/// </summary>
+		/// <returns>true if the datum is empty</returns>
+		bool IsEmpty() const;
+		/// <summary>
+		/// Pointer to the first element, invalidated by anything that reallocates the datum.
+		/// </summary>
+		/// <returns>pointer to the first element</returns>
+		iterator begin() const;
+		/// <summary>
+		/// Pointer past the last element, invalidated by anything that reallocates the datum.
+		/// </summary>
+		/// <returns>pointer past the last element</returns>
+		iterator end() const;
+		/// <summary>
+		/// Datum the handle refers to.
+		/// </summary>
+		/// <returns>the datum</returns>
+		DatumReference& GetDatum() const;
+
+	private:
+		explicit TypedDatumRef(DatumReference& datum);
+		T* Data() const;
+
+		DatumReference* _datum;
+	};
 }
 
 #include "Datum.inl"
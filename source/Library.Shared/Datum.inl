@@ -9,9 +9,21 @@ namespace FieaGameEngine
 		{
 			throw std::runtime_error("Cannot SetFromString with an unknown or pointer type");
 		}
-		PushBackFromStringFunctor func = _pushBackFromStringFunctors[static_cast<int>(_type)];
-		assert(func != nullptr);
-		(this->*func)(str);
+		PushBackFromChars(str);
+	}
+
+	inline void Datum::Unshare()
+	{
+		if (_shared.load(std::memory_order_acquire) != nullptr)
+		{
+			UnshareStorage();
+		}
+	}
+
+	inline void Datum::Expose()
+	{
+		Unshare();
+		_isShareable = false;
 	}
 
 	template<typename IncrementFunctor>
@@ -117,6 +129,7 @@ namespace FieaGameEngine
 		{
 			throw std::runtime_error("Cannot PushBack with an unknown type or a different type.");
 		}
+		Unshare();
 		if (_size == _capacity)
 		{
 			size_t capacity = _capacity + std::max(1_z, incrementFunctor(_size, _capacity));
@@ -161,60 +174,81 @@ namespace FieaGameEngine
 	}
 
 	template<typename EqualityFunctor>
-	inline size_t Datum::IndexOf(const int& value, EqualityFunctor equalityFunctor)
+	inline size_t Datum::IndexOf(const int& value, [[maybe_unused]] EqualityFunctor equalityFunctor)
 	{
 		if (_type != DatumType::Integer)
 		{
 			throw std::runtime_error("Cannot IndexOf with an unknown type or a different type.");
 		}
-		size_t index = 0_z;
-		for (; index != _size; ++index)
+		if constexpr (std::is_same_v<EqualityFunctor, DefaultEquality<int>>)
+		{
+			return SimdMath::Find(_data.i, _size, value);
+		}
+		else
 		{
-			if (equalityFunctor(_data.i[index], value))
+			size_t index = 0_z;
+			for (; index != _size; ++index)
 			{
-				break;
+				if (equalityFunctor(_data.i[index], value))
+				{
+					break;
+				}
 			}
-		}
 
-		return index;
+			return index;
+		}
 	}
 
 	template<typename EqualityFunctor>
-	inline size_t Datum::IndexOf(const float& value, EqualityFunctor equalityFunctor)
+	inline size_t Datum::IndexOf(const float& value, [[maybe_unused]] EqualityFunctor equalityFunctor)
 	{
 		if (_type != DatumType::Float)
 		{
 			throw std::runtime_error("Cannot IndexOf with an unknown type or a different type.");
 		}
-		size_t index = 0_z;
-		for (; index != _size; ++index)
+		if constexpr (std::is_same_v<EqualityFunctor, DefaultEquality<float>>)
+		{
+			return SimdMath::Find(_data.f, _size, value);
+		}
+		else
 		{
-			if (equalityFunctor(_data.f[index], value))
+			size_t index = 0_z;
+			for (; index != _size; ++index)
 			{
-				break;
+				if (equalityFunctor(_data.f[index], value))
+				{
+					break;
+				}
 			}
-		}
 
-		return index;
+			return index;
+		}
 	}
 
 	template<typename EqualityFunctor>
-	inline size_t Datum::IndexOf(const glm::vec4& value, EqualityFunctor equalityFunctor)
+	inline size_t Datum::IndexOf(const glm::vec4& value, [[maybe_unused]] EqualityFunctor equalityFunctor)
 	{
 		if (_type != DatumType::Vector)
 		{
 			throw std::runtime_error("Cannot IndexOf with an unknown type or a different type.");
 		}
-		size_t index = 0_z;
-		for (; index != _size; ++index)
+		if constexpr (std::is_same_v<EqualityFunctor, DefaultEquality<glm::vec4>>)
+		{
+			return SimdMath::Find(_data.v, _size, value);
+		}
+		else
 		{
-			if (equalityFunctor(_data.v[index], value))
+			size_t index = 0_z;
+			for (; index != _size; ++index)
 			{
-				break;
+				if (equalityFunctor(_data.v[index], value))
+				{
+					break;
+				}
 			}
-		}
 
-		return index;
+			return index;
+		}
 	}
 
 	template<typename EqualityFunctor>
@@ -310,6 +344,202 @@ namespace FieaGameEngine
 		return const_cast<Datum*>(this)->IndexOf(value, equalityFunctor);
 	}
 
+	template<typename T>
+	inline std::span<T> Datum::SpanHelper(DatumType type) const
+	{
+		if (_type != type)
+		{
+			throw std::runtime_error("Cannot get a span with an unknown type or a different type.");
+		}
+		return std::span<T>(static_cast<T*>(_data.vp), _size);
+	}
+
+	template<typename T>
+	inline void Datum::AppendHelper(DatumType type, std::span<const T> values)
+	{
+		if (_isExternal)
+		{
+			throw std::runtime_error("Cannot Append with external storage.");
+		}
+		SetType(type);
+
+		// Values viewing this datum are found again after reserving, which may move the storage
+		const T* data = static_cast<const T*>(_data.vp);
+		const bool isAliased = data != nullptr && values.data() >= data && values.data() < data + _size;
+		const size_t offset = isAliased ? static_cast<size_t>(values.data() - data) : 0_z;
+		Reserve(_size + values.size());
+		if (isAliased)
+		{
+			values = std::span<const T>(static_cast<const T*>(_data.vp) + offset, values.size());
+		}
+
+		T* destination = static_cast<T*>(_data.vp);
+		for (const T& value : values)
+		{
+			new(destination + _size++)T(value);
+		}
+	}
+
+	template<typename T>
+	inline void Datum::AssignHelper(DatumType type, std::span<const T> values)
+	{
+		if (_isExternal)
+		{
+			throw std::runtime_error("Cannot Assign with external storage.");
+		}
+		SetType(type);
+
+		const T* data = static_cast<const T*>(_data.vp);
+		if (data != nullptr && values.data() >= data && values.data() < data + _size)
+		{
+			// Clearing would destroy the values, so assign from a copy
+			Datum copy(type);
+			copy.AppendHelper(type, values);
+			Clear();
+			AppendHelper(type, std::span<const T>(copy.SpanHelper<T>(type)));
+		}
+		else
+		{
+			Clear();
+			AppendHelper(type, values);
+		}
+	}
+
+	template<typename T>
+	inline size_t Datum::RemoveAllHelper(DatumType type, const T& value)
+	{
+		if (_isExternal)
+		{
+			throw std::runtime_error("Cannot remove from a Datum with external storage");
+		}
+		Unshare();
+
+		// Every element is written to the next kept slot, and the slot only advances for elements
+		// that are kept, so the loop has no data-dependent branch
+		std::span<T> elements = SpanHelper<T>(type);
+		size_t kept = 0_z;
+		for (const T& element : elements)
+		{
+			elements[kept] = element;
+			kept += static_cast<size_t>(!(element == value));
+		}
+
+		const size_t removed = _size - kept;
+		_size = kept;
+		return removed;
+	}
+
+	template<typename T>
+	inline void Datum::FillHelper(DatumType type, const T& value)
+	{
+		Unshare();
+		std::span<T> elements = SpanHelper<T>(type);
+		std::fill(elements.begin(), elements.end(), value);
+	}
+
+	template<typename T>
+	inline constexpr Datum::DatumType Datum::TypeOf()
+	{
+		if constexpr (std::is_same_v<T, int>) return DatumType::Integer;
+		else if constexpr (std::is_same_v<T, float>) return DatumType::Float;
+		else if constexpr (std::is_same_v<T, glm::vec4>) return DatumType::Vector;
+		else if constexpr (std::is_same_v<T, glm::mat4>) return DatumType::Matrix;
+		else if constexpr (std::is_same_v<T, std::string>) return DatumType::String;
+		else
+		{
+			static_assert(std::is_same_v<T, RTTI*>, "Datum elements are int, float, glm::vec4, glm::mat4, std::string or RTTI*.");
+			return DatumType::Pointer;
+		}
+	}
+
+	template<typename T>
+	inline TypedDatumRef<T> Datum::TypedRef()
+	{
+		if (_type != TypeOf<T>())
+		{
+			throw std::runtime_error("Cannot get a typed reference with an unknown type or a different type.");
+		}
+		Expose();
+		return TypedDatumRef<T>(*this);
+	}
+
+	template<typename T>
+	inline TypedDatumRef<const T> Datum::TypedRef() const
+	{
+		if (_type != TypeOf<T>())
+		{
+			throw std::runtime_error("Cannot get a typed reference with an unknown type or a different type.");
+		}
+		return TypedDatumRef<const T>(*this);
+	}
+
+#pragma region TypedDatumRef
+	template<typename T>
+	inline TypedDatumRef<T>::TypedDatumRef(DatumReference& datum) :
+		_datum{ &datum }
+	{
+	}
+
+	template<typename T>
+	inline T& TypedDatumRef<T>::operator[](size_t index) const
+	{
+		assert(index < _datum->_size);
+		return Data()[index];
+	}
+
+	template<typename T>
+	inline T& TypedDatumRef<T>::Front() const
+	{
+		assert(!IsEmpty());
+		return Data()[0];
+	}
+
+	template<typename T>
+	inline T& TypedDatumRef<T>::Back() const
+	{
+		assert(!IsEmpty());
+		return Data()[_datum->_size - 1];
+	}
+
+	template<typename T>
+	inline size_t TypedDatumRef<T>::Size() const
+	{
+		return _datum->_size;
+	}
+
+	template<typename T>
+	inline bool TypedDatumRef<T>::IsEmpty() const
+	{
+		return _datum->_size == 0_z;
+	}
+
+	template<typename T>
+	inline typename TypedDatumRef<T>::iterator TypedDatumRef<T>::begin() const
+	{
+		return Data();
+	}
+
+	template<typename T>
+	inline typename TypedDatumRef<T>::iterator TypedDatumRef<T>::end() const
+	{
+		return Data() + _datum->_size;
+	}
+
+	template<typename T>
+	inline typename TypedDatumRef<T>::DatumReference& TypedDatumRef<T>::GetDatum() const
+	{
+		return *_datum;
+	}
+
+	template<typename T>
+	inline T* TypedDatumRef<T>::Data() const
+	{
+		// The type was checked when the handle was made, it can only change if the datum was reassigned
+		assert(_datum->_type == Datum::TypeOf<value_type>());
+		return static_cast<T*>(_datum->_data.vp);
+	}
+#pragma endregion
+
 	inline const size_t Datum::_sizeMap[] =
 	{
 		sizeof(int),			// DatumType::Integer
@@ -454,11 +684,17 @@ namespace FieaGameEngine
 
 	inline bool Datum::ComparePODs(const Datum& rhs) const
 	{
-		return memcmp(_data.vp, rhs._data.vp, _sizeMap[static_cast<int>(_type)] * _size) == 0;
+		return _data.vp == rhs._data.vp || memcmp(_data.vp, rhs._data.vp, _sizeMap[static_cast<int>(_type)] * _size) == 0;
 	}
 
 	inline bool Datum::CompareStrings(const Datum& rhs) const
 	{
+		if (_data.s == rhs._data.s)
+		{
+			// Copy-on-write copies of the same values
+			return true;
+		}
+
 		bool areEqual = true;
 		for (size_t i = 0_z; i < _size; ++i)
 		{
@@ -499,29 +735,30 @@ namespace FieaGameEngine
 		nullptr,
 	};
 
-	inline void Datum::SetFromStringIntegers(const std::string& str, size_t index)
+	inline void Datum::SetFromStringIntegers(std::string_view text, size_t index)
 	{
-		Set(FromStringToInt(str), index);
+		Set(ParseInteger(text), index);
 	}
 
-	inline void Datum::SetFromStringFloats(const std::string& str, size_t index)
+	inline void Datum::SetFromStringFloats(std::string_view text, size_t index)
 	{
-		Set(FromStringToFloat(str), index);
+		Set(ParseFloat(text), index);
 	}
 
-	inline void Datum::SetFromStringVectors(const std::string& str, size_t index)
+	inline void Datum::SetFromStringVectors(std::string_view text, size_t index)
 	{
-		Set(FromStringToVector(str), index);
+		Set(ParseVector(text), index);
 	}
 
-	inline void Datum::SetFromStringMatrixes(const std::string& str, size_t index)
+	inline void Datum::SetFromStringMatrixes(std::string_view text, size_t index)
 	{
-		Set(FromStringToMatrix(str), index);
+		Set(ParseMatrix(text), index);
 	}
 
-	inline void Datum::SetFromStringStrings(const std::string& str, size_t index)
+	inline void Datum::SetFromStringStrings(std::string_view text, size_t index)
 	{
-		Set(str, index);
+		SetHelper(DatumType::String, index);
+		_data.s[index].assign(text);
 	}
 
 	inline const Datum::SetFromStringFunctor Datum::_setFromStringFunctors[] =
@@ -538,22 +775,26 @@ namespace FieaGameEngine
 
 	inline std::string Datum::ToStringIntegers(size_t index) const
 	{
-		return std::to_string(GetInteger(index));
+		char buffer[_maxCharsLength];
+		return std::string(buffer, ToCharsIntegers(buffer, _maxCharsLength, index));
 	}
 
 	inline std::string Datum::ToStringFloats(size_t index) const
 	{
-		return std::to_string(GetFloat(index));
+		char buffer[_maxCharsLength];
+		return std::string(buffer, ToCharsFloats(buffer, _maxCharsLength, index));
 	}
 
 	inline std::string Datum::ToStringVectors(size_t index) const
 	{
-		return glm::to_string(GetVector(index));
+		char buffer[_maxCharsLength];
+		return std::string(buffer, ToCharsVectors(buffer, _maxCharsLength, index));
 	}
 
 	inline std::string Datum::ToStringMatrixes(size_t index) const
 	{
-		return glm::to_string(GetMatrix(index));
+		char buffer[_maxCharsLength];
+		return std::string(buffer, ToCharsMatrixes(buffer, _maxCharsLength, index));
 	}
 
 	inline std::string Datum::ToStringStrings(size_t index) const
@@ -578,29 +819,41 @@ namespace FieaGameEngine
 		nullptr,
 	};
 
-	inline void Datum::PushBackFromStringIntegers(const std::string& str)
+	inline const Datum::ToCharsFunctor Datum::_toCharsFunctors[] =
+	{
+		&Datum::ToCharsIntegers,		// DatumType::Integer
+		&Datum::ToCharsFloats,			// DatumType::Float
+		&Datum::ToCharsVectors,			// DatumType::Vector
+		&Datum::ToCharsMatrixes,		// DatumType::Matrix
+		nullptr,
+		&Datum::ToCharsStrings,			// DatumType::String
+		&Datum::ToCharsPointers,		// DatumType::Pointer
+		nullptr,
+	};
+
+	inline void Datum::PushBackFromStringIntegers(std::string_view text)
 	{
-		PushBack(FromStringToInt(str));
+		PushBack(ParseInteger(text));
 	}
 
-	inline void Datum::PushBackFromStringFloats(const std::string& str)
+	inline void Datum::PushBackFromStringFloats(std::string_view text)
 	{
-		PushBack(FromStringToFloat(str));
+		PushBack(ParseFloat(text));
 	}
 
-	inline void Datum::PushBackFromStringVectors(const std::string& str)
+	inline void Datum::PushBackFromStringVectors(std::string_view text)
 	{
-		PushBack(FromStringToVector(str));
+		PushBack(ParseVector(text));
 	}
 
-	inline void Datum::PushBackFromStringMatrixes(const std::string& str)
+	inline void Datum::PushBackFromStringMatrixes(std::string_view text)
 	{
-		PushBack(FromStringToMatrix(str));
+		PushBack(ParseMatrix(text));
 	}
 
-	inline void Datum::PushBackFromStringStrings(const std::string& str)
+	inline void Datum::PushBackFromStringStrings(std::string_view text)
 	{
-		PushBack(str);
+		PushBack(std::string(text));
 	}
 
 	inline const Datum::PushBackFromStringFunctor Datum::_pushBackFromStringFunctors[] =
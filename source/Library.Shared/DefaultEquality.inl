@@ -1,5 +1,7 @@
 #include "DefaultEquality.h"
 #include "RTTI.h"
+#include <string>
+#include <string_view>
 #include <string.h>
 
 namespace FieaGameEngine
@@ -58,4 +60,48 @@ namespace FieaGameEngine
 			return strcmp(lhs, rhs) == 0;
 		}
 	};
+
+	template<>
+	struct DefaultEquality<std::string>
+	{
+		using is_transparent = void;
+
+		bool operator()(std::string_view lhs, std::string_view rhs) const
+		{
+			return lhs == rhs;
+		}
+	};
+
+	template<>
+	struct DefaultEquality<const std::string>
+	{
+		using is_transparent = void;
+
+		bool operator()(std::string_view lhs, std::string_view rhs) const
+		{
+			return lhs == rhs;
+		}
+	};
+
+	template<>
+	struct DefaultEquality<std::string_view>
+	{
+		using is_transparent = void;
+
+		bool operator()(std::string_view lhs, std::string_view rhs) const
+		{
+			return lhs == rhs;
+		}
+	};
+
+	template<>
+	struct DefaultEquality<const std::string_view>
+	{
+		using is_transparent = void;
+
+		bool operator()(std::string_view lhs, std::string_view rhs) const
+		{
+			return lhs == rhs;
+		}
+	};
 }
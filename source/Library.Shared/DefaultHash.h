@@ -7,6 +7,14 @@ namespace FieaGameEngine
 	{
 		size_t operator()(const TKey& key) const;
 	};
+
+	/// <summary>
+	/// A functor declaring is_transparent hashes or compares any key type that converts to its argument
+	/// (e.g. string literals and std::string_view for std::string), so maps can look those keys up without
+	/// first building a TKey.
+	/// </summary>
+	template <typename TFunctor>
+	concept TransparentFunctor = requires { typename TFunctor::is_transparent; };
 }
 
 #include "DefaultHash.inl"
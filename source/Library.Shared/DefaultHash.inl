@@ -1,29 +1,164 @@
 #include "DefaultHash.h"
 
+#include <bit>
 #include <cstdint>
+#include <cstring>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <string.h>
 
 namespace FieaGameEngine
 {
-	const size_t HashPrime = 33;
+	inline constexpr std::uint64_t HashPrime1 = 0x9E3779B185EBCA87ULL;
+	inline constexpr std::uint64_t HashPrime2 = 0xC2B2AE3D27D4EB4FULL;
+	inline constexpr std::uint64_t HashPrime3 = 0x165667B19E3779F9ULL;
+	inline constexpr std::uint64_t HashPrime4 = 0x85EBCA77C2B2AE63ULL;
+	inline constexpr std::uint64_t HashPrime5 = 0x27D4EB2F165667C5ULL;
 
-	inline size_t AdditiveHash(const std::uint8_t* data, size_t length)
+	inline std::uint64_t HashRead64(const std::uint8_t* data)
 	{
-		size_t hash = 0;
-		for (size_t i = 0; i < length; ++i)
+		std::uint64_t value;
+		std::memcpy(&value, data, sizeof(value));
+		return value;
+	}
+
+	inline std::uint32_t HashRead32(const std::uint8_t* data)
+	{
+		std::uint32_t value;
+		std::memcpy(&value, data, sizeof(value));
+		return value;
+	}
+
+	inline std::uint64_t HashRound(std::uint64_t accumulator, std::uint64_t input)
+	{
+		accumulator += input * HashPrime2;
+		accumulator = std::rotl(accumulator, 31);
+		return accumulator * HashPrime1;
+	}
+
+	inline std::uint64_t HashMergeRound(std::uint64_t accumulator, std::uint64_t value)
+	{
+		accumulator ^= HashRound(0, value);
+		return accumulator * HashPrime1 + HashPrime4;
+	}
+
+	inline std::uint64_t HashAvalanche(std::uint64_t hash)
+	{
+		hash ^= hash >> 33;
+		hash *= HashPrime2;
+		hash ^= hash >> 29;
+		hash *= HashPrime3;
+		hash ^= hash >> 32;
+		return hash;
+	}
+
+	inline size_t HashFold(std::uint64_t hash)
+	{
+		if constexpr (sizeof(size_t) < sizeof(std::uint64_t))
+		{
+			return static_cast<size_t>(hash ^ (hash >> 32));
+		}
+		else
 		{
-			hash += HashPrime * data[i];
+			return static_cast<size_t>(hash);
 		}
+	}
 
-		return hash;
+	/// <summary>
+	/// xxHash64 (seed 0) over length bytes. Inputs of 32 bytes or more are consumed in
+	/// stripes of four independent 8 byte lanes, the rest 8 bytes at a time, and every
+	/// output bit depends on every input bit, so anagrams and near keys do not collide.
+	/// </summary>
+	/// <param name="data">bytes to hash</param>
+	/// <param name="length">number of bytes</param>
+	/// <returns>hash of the bytes</returns>
+	inline size_t HashBytes(const void* data, size_t length)
+	{
+		const std::uint8_t* position = static_cast<const std::uint8_t*>(data);
+		const std::uint8_t* const end = position + length;
+		std::uint64_t hash;
+
+		if (length >= 32)
+		{
+			std::uint64_t lane1 = HashPrime1 + HashPrime2;
+			std::uint64_t lane2 = HashPrime2;
+			std::uint64_t lane3 = 0;
+			std::uint64_t lane4 = 0 - HashPrime1;
+
+			const std::uint8_t* const limit = end - 32;
+			do
+			{
+				lane1 = HashRound(lane1, HashRead64(position));
+				lane2 = HashRound(lane2, HashRead64(position + 8));
+				lane3 = HashRound(lane3, HashRead64(position + 16));
+				lane4 = HashRound(lane4, HashRead64(position + 24));
+				position += 32;
+			} while (position <= limit);
+
+			hash = std::rotl(lane1, 1) + std::rotl(lane2, 7) + std::rotl(lane3, 12) + std::rotl(lane4, 18);
+			hash = HashMergeRound(hash, lane1);
+			hash = HashMergeRound(hash, lane2);
+			hash = HashMergeRound(hash, lane3);
+			hash = HashMergeRound(hash, lane4);
+		}
+		else
+		{
+			hash = HashPrime5;
+		}
+
+		hash += static_cast<std::uint64_t>(length);
+
+		for (; position + 8 <= end; position += 8)
+		{
+			hash ^= HashRound(0, HashRead64(position));
+			hash = std::rotl(hash, 27) * HashPrime1 + HashPrime4;
+		}
+		if (position + 4 <= end)
+		{
+			hash ^= static_cast<std::uint64_t>(HashRead32(position)) * HashPrime1;
+			hash = std::rotl(hash, 23) * HashPrime2 + HashPrime3;
+			position += 4;
+		}
+		for (; position < end; ++position)
+		{
+			hash ^= static_cast<std::uint64_t>(*position) * HashPrime5;
+			hash = std::rotl(hash, 11) * HashPrime1;
+		}
+
+		return HashFold(HashAvalanche(hash));
+	}
+
+	/// <summary>
+	/// Mixes an integer so that nearby values (sequential ids, aligned pointers) spread over
+	/// all bits of the result instead of only the low ones.
+	/// </summary>
+	/// <param name="value">integer to hash</param>
+	/// <returns>hash of the integer</returns>
+	inline size_t HashInteger(std::uint64_t value)
+	{
+		return HashFold(HashAvalanche(value * HashPrime1 + HashPrime5));
 	}
 
 	template <typename TKey>
 	inline size_t DefaultHash<TKey>::operator()(const TKey& key) const
 	{
-		const std::uint8_t* data = reinterpret_cast<const std::uint8_t*>(&key);
-		return AdditiveHash(data, sizeof(key));
+		if constexpr (std::is_enum_v<TKey>)
+		{
+			return HashInteger(static_cast<std::uint64_t>(static_cast<std::underlying_type_t<TKey>>(key)));
+		}
+		else if constexpr (std::is_integral_v<TKey>)
+		{
+			return HashInteger(static_cast<std::uint64_t>(key));
+		}
+		else if constexpr (std::is_pointer_v<TKey>)
+		{
+			return HashInteger(static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(key)));
+		}
+		else
+		{
+			return HashBytes(&key, sizeof(key));
+		}
 	}
 
 	template <>
@@ -31,8 +166,7 @@ namespace FieaGameEngine
 	{
 		inline size_t operator()(const char* key) const
 		{
-			const std::uint8_t* data = reinterpret_cast<const std::uint8_t*>(key);
-			return AdditiveHash(data, strlen(key));
+			return HashBytes(key, strlen(key));
 		}
 	};
 
@@ -41,8 +175,7 @@ namespace FieaGameEngine
 	{
 		inline size_t operator()(const char* const key) const
 		{
-			const std::uint8_t* data = reinterpret_cast<const std::uint8_t*>(key);
-			return AdditiveHash(data, strlen(key));
+			return HashBytes(key, strlen(key));
 		}
 	};
 
@@ -51,8 +184,7 @@ namespace FieaGameEngine
 	{
 		inline size_t operator()(const char* key) const
 		{
-			const std::uint8_t* data = reinterpret_cast<const std::uint8_t*>(key);
-			return AdditiveHash(data, strlen(key));
+			return HashBytes(key, strlen(key));
 		}
 	};
 
@@ -61,18 +193,18 @@ namespace FieaGameEngine
 	{
 		inline size_t operator()(const char* const key) const
 		{
-			const std::uint8_t* data = reinterpret_cast<const std::uint8_t*>(key);
-			return AdditiveHash(data, strlen(key));
+			return HashBytes(key, strlen(key));
 		}
 	};
 
 	template <>
 	struct DefaultHash<std::string>
 	{
-		inline size_t operator()(const std::string& key) const
+		using is_transparent = void;
+
+		inline size_t operator()(std::string_view key) const
 		{
-			const std::uint8_t* data = reinterpret_cast<const std::uint8_t*>(key.c_str());
-			return AdditiveHash(data, key.length());
+			return HashBytes(key.data(), key.length());
 		}
 	};
 
@@ -81,18 +213,29 @@ namespace FieaGameEngine
 	{
 		inline size_t operator()(const std::wstring& key) const
 		{
-			const std::uint8_t* data = reinterpret_cast<const std::uint8_t*>(key.c_str());
-			return AdditiveHash(data, key.length());
+			return HashBytes(key.data(), key.length() * sizeof(wchar_t));
+		}
+	};
+
+	template <>
+	struct DefaultHash<std::string_view>
+	{
+		using is_transparent = void;
+
+		inline size_t operator()(std::string_view key) const
+		{
+			return HashBytes(key.data(), key.length());
 		}
 	};
 
 	template <>
 	struct DefaultHash<const std::string>
 	{
-		inline size_t operator()(const std::string& key) const
+		using is_transparent = void;
+
+		inline size_t operator()(std::string_view key) const
 		{
-			const std::uint8_t* data = reinterpret_cast<const std::uint8_t*>(key.c_str());
-			return AdditiveHash(data, key.length());
+			return HashBytes(key.data(), key.length());
 		}
 	};
 
@@ -101,17 +244,18 @@ namespace FieaGameEngine
 	{
 		inline size_t operator()(const std::wstring& key) const
 		{
-			const std::uint8_t* data = reinterpret_cast<const std::uint8_t*>(key.c_str());
-			return AdditiveHash(data, key.length());
+			return HashBytes(key.data(), key.length() * sizeof(wchar_t));
 		}
 	};
 
 	template <>
-	struct DefaultHash<int>
+	struct DefaultHash<const std::string_view>
 	{
-		inline size_t operator()(int key) const
+		using is_transparent = void;
+
+		inline size_t operator()(std::string_view key) const
 		{
-			return static_cast<size_t>(key);
+			return HashBytes(key.data(), key.length());
 		}
 	};
-}
+}
\ No newline at end of file
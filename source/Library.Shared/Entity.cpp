@@ -1,6 +1,8 @@
 #include "pch.h"
 
 #include "Entity.h"
+#include "ActionExpression.h"
+#include "ExpressionBatch.h"
 
 using namespace std;
 using namespace std::string_literals;
@@ -48,12 +50,12 @@ namespace FieaGameEngine
 
 	Datum& Entity::Children() const
 	{
-		return _orderVector[childrenIndex]->second;
+		return Entry(childrenIndex).second;
 	}
 
 	Datum& Entity::Actions() const
 	{
-		return _orderVector[actionsIndex]->second;
+		return Entry(actionsIndex).second;
 	}
 
 	void Entity::SetName(const std::string& name)
@@ -97,6 +99,21 @@ namespace FieaGameEngine
 			Scope& scope = Actions()[i];
 			assert(scope.Is("IAction"));
 			IAction* action = static_cast<IAction*>(&scope);
+			if (worldState.ExpressionBatch != nullptr)
+			{
+				ActionExpression* expression = action->As<ActionExpression>();
+				if (expression != nullptr)
+				{
+					worldState.ExpressionBatch->Add(*expression);
+					continue;
+				}
+
+				// Anything this action reads must already hold what the queued expressions assign
+				if (!worldState.ExpressionBatch->IsEmpty())
+				{
+					worldState.ExpressionBatch->Update(worldState);
+				}
+			}
 			action->Update(worldState);
 		}
 	}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <mutex>
+
 #include "EventSubscriber.h"
 #include "EventQueue.h"
 
@@ -61,6 +63,8 @@ namespace FieaGameEngine
 
 	private:
 		static inline Vector<EventSubscriber*> _subscribers;
+		// Subscribers come and go with their Reactions, which may be copied or destroyed on pool threads
+		static inline std::mutex _subscribersMutex;
 
 		T _message;
 	};
@@ -20,12 +20,14 @@ namespace FieaGameEngine
 	template<typename T>
 	inline void Event<T>::Subscribe(EventSubscriber& subscriber)
 	{
+		std::lock_guard<std::mutex> lock(_subscribersMutex);
 		_subscribers.PushBack(&subscriber);
 	}
 
 	template<typename T>
 	inline void Event<T>::Unsubscribe(EventSubscriber& subscriber)
 	{
+		std::lock_guard<std::mutex> lock(_subscribersMutex);
 		_subscribers.Remove(&subscriber);
 		_subscribers.ShrinkToFit();
 	}
@@ -33,6 +35,7 @@ namespace FieaGameEngine
 	template<typename T>
 	inline void Event<T>::UnsubscribeAll()
 	{
+		std::lock_guard<std::mutex> lock(_subscribersMutex);
 		_subscribers.Clear();
 		_subscribers.ShrinkToFit();
 	}
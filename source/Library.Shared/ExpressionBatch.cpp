@@ -0,0 +1,521 @@
+#include "pch.h"
+
+#include <cmath>
+
+#include "ExpressionBatch.h"
+#include "SimdMath.h"
+#include "WorldState.h"
+
+using namespace std;
+
+namespace FieaGameEngine
+{
+	void ExpressionBatch::Add(ActionExpression& action)
+	{
+		if (action._expression == "")
+		{
+			throw runtime_error("Empty expression");
+		}
+
+		if (!action._isCompiled)
+		{
+			action.Compile();
+		}
+
+		// The program is only copied when it starts a new group
+		auto it = _groupIndices.Find(action._program);
+		if (it == _groupIndices.end())
+		{
+			it = _groupIndices.Insert(make_pair(action._program, _groups.Size())).first;
+			_groups.EmplaceBack();
+		}
+
+		_groups[it->second].Actions.PushBack(&action);
+		_queue.PushBack(&action);
+	}
+
+	size_t ExpressionBatch::Size() const
+	{
+		return _queue.Size();
+	}
+
+	bool ExpressionBatch::IsEmpty() const
+	{
+		return _queue.IsEmpty();
+	}
+
+	void ExpressionBatch::Update(WorldState& worldState)
+	{
+		try
+		{
+			if (GroupsOverlap())
+			{
+				for (ActionExpression* action : _queue)
+				{
+					worldState.Action = action;
+					action->Update(worldState);
+				}
+			}
+			else
+			{
+				for (Group& group : _groups)
+				{
+					if (group.Actions.Size() > 1_z && Gather(group))
+					{
+						Evaluate(*group.Actions.Front(), group.Actions.Size());
+						Scatter(group);
+						worldState.Action = group.Actions.Back();
+					}
+					else
+					{
+						for (ActionExpression* action : group.Actions)
+						{
+							worldState.Action = action;
+							action->Update(worldState);
+						}
+					}
+				}
+			}
+		}
+		catch (...)
+		{
+			Clear();
+			throw;
+		}
+
+		for (Group& group : _groups)
+		{
+			group.Actions.Clear();
+		}
+		_queue.Clear();
+	}
+
+	void ExpressionBatch::Clear()
+	{
+		_groups.Clear();
+		_groupIndices.Clear();
+		_queue.Clear();
+	}
+
+	size_t ExpressionBatch::ProgramHash::operator()(const Vector<Instruction>& program) const
+	{
+		size_t hash = program.Size();
+		for (const Instruction& instruction : program)
+		{
+			const std::uint64_t fields = (static_cast<std::uint64_t>(instruction.Type) << 40) | (static_cast<std::uint64_t>(instruction.Code) << 32) | instruction.Slot;
+			hash = HashInteger(hash ^ fields);
+		}
+		return hash;
+	}
+
+	bool ExpressionBatch::ProgramEquality::operator()(const Vector<Instruction>& lhs, const Vector<Instruction>& rhs) const
+	{
+		if (lhs.Size() != rhs.Size())
+		{
+			return false;
+		}
+
+		for (size_t i = 0_z; i < lhs.Size(); ++i)
+		{
+			if (lhs[i].Type != rhs[i].Type || lhs[i].Code != rhs[i].Code || lhs[i].Slot != rhs[i].Slot)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool ExpressionBatch::GroupsOverlap()
+	{
+		if (_groups.Size() < 2_z)
+		{
+			return false;
+		}
+
+		// Updating group by group is only equivalent to updating in the order queued if no group
+		// assigns an attribute that another group uses
+		_assigningGroups.Clear();
+		for (size_t groupIndex = 0_z; groupIndex < _groups.Size(); ++groupIndex)
+		{
+			// Groups stay around empty between updates
+			const Group& group = _groups[groupIndex];
+			if (group.Actions.IsEmpty() || group.Actions.Front()->_program.Back().Type != InstructionType::AssignOperator)
+			{
+				continue;
+			}
+
+			for (ActionExpression* action : group.Actions)
+			{
+				ActionExpression::Operand& operand = action->_operands.Front();
+				const Datum* datum = operand.Search.Search(*action, operand.Name);
+				if (datum != nullptr)
+				{
+					auto [it, wasInserted] = _assigningGroups.Insert(make_pair(datum, groupIndex));
+					if (!wasInserted && it->second != groupIndex)
+					{
+						return true;
+					}
+				}
+			}
+		}
+
+		if (_assigningGroups.IsEmpty())
+		{
+			return false;
+		}
+
+		for (size_t groupIndex = 0_z; groupIndex < _groups.Size(); ++groupIndex)
+		{
+			for (ActionExpression* action : _groups[groupIndex].Actions)
+			{
+				for (ActionExpression::Operand& operand : action->_operands)
+				{
+					const Datum* datum = operand.Search.Search(*action, operand.Name);
+					auto it = _assigningGroups.Find(datum);
+					if (it != _assigningGroups.end() && it->second != groupIndex)
+					{
+						return true;
+					}
+				}
+			}
+		}
+
+		return false;
+	}
+
+	bool ExpressionBatch::Gather(const Group& group)
+	{
+		ActionExpression& first = *group.Actions.Front();
+		const size_t slotCount = first._operands.Size();
+		const size_t count = group.Actions.Size();
+
+		// Resolve every operand, all of them must be scalars of the same types for every action
+		_operands.Clear();
+		_operands.Reserve(count * slotCount);
+		_slotTypes.Clear();
+		for (ActionExpression* action : group.Actions)
+		{
+			for (size_t slot = 0_z; slot < slotCount; ++slot)
+			{
+				ActionExpression::Operand& operand = action->_operands[slot];
+				Datum* datum = operand.Search.Search(*action, operand.Name);
+				if (datum == nullptr || datum->Size() == 0_z)
+				{
+					return false;
+				}
+
+				const Datum::DatumType type = datum->Type();
+				if (action == &first)
+				{
+					if (type != Datum::DatumType::Integer && type != Datum::DatumType::Float)
+					{
+						return false;
+					}
+					_slotTypes.PushBack(type);
+				}
+				else if (type != _slotTypes[slot])
+				{
+					return false;
+				}
+
+				_operands.PushBack(datum);
+			}
+		}
+
+		if (!InferTypes(first))
+		{
+			return false;
+		}
+
+		// Evaluating at once is only equivalent to evaluating in order if no action
+		// assigns an attribute that another action uses
+		if (first._program.Back().Type == InstructionType::AssignOperator)
+		{
+			_targets.Clear();
+			for (size_t i = 0_z; i < count; ++i)
+			{
+				if (!_targets.Insert(make_pair(_operands[i * slotCount], i)).second)
+				{
+					return false;
+				}
+			}
+
+			for (size_t i = 0_z; i < count; ++i)
+			{
+				for (size_t slot = 1_z; slot < slotCount; ++slot)
+				{
+					auto it = _targets.Find(_operands[i * slotCount + slot]);
+					if (it != _targets.end() && it->second != i)
+					{
+						return false;
+					}
+				}
+			}
+		}
+
+		// Gather the operands into one column per slot, types and sizes were checked above
+		while (_columns.Size() < slotCount)
+		{
+			_columns.EmplaceBack();
+		}
+
+		for (size_t slot = 0_z; slot < slotCount; ++slot)
+		{
+			Column& column = _columns[slot];
+			if (_slotTypes[slot] == Datum::DatumType::Integer)
+			{
+				if (column.Integers.Size() < count) column.Integers.Resize(count);
+				int* integers = &column.Integers.Front();
+				for (size_t i = 0_z; i < count; ++i)
+				{
+					integers[i] = _operands[i * slotCount + slot]->TypedRef<int>().Front();
+				}
+			}
+			else
+			{
+				if (column.Floats.Size() < count) column.Floats.Resize(count);
+				float* floats = &column.Floats.Front();
+				for (size_t i = 0_z; i < count; ++i)
+				{
+					floats[i] = _operands[i * slotCount + slot]->TypedRef<float>().Front();
+				}
+			}
+		}
+
+		return true;
+	}
+
+	bool ExpressionBatch::InferTypes(const ActionExpression& action)
+	{
+		using DatumType = Datum::DatumType;
+
+		_stackTypes.Clear();
+		for (const auto& instruction : action._program)
+		{
+			if (instruction.Type == InstructionType::Operand)
+			{
+				_stackTypes.PushBack(_slotTypes[instruction.Slot]);
+				continue;
+			}
+
+			const DatumType rhs = _stackTypes.Back();
+			_stackTypes.PopBack();
+			DatumType& lhs = _stackTypes.Back();
+
+			if (instruction.Type == InstructionType::Operator)
+			{
+				const bool isComparison = instruction.Code == OpCode::Equals || instruction.Code == OpCode::NotEquals;
+				lhs = (isComparison || (lhs == DatumType::Integer && rhs == DatumType::Integer)) ? DatumType::Integer : DatumType::Float;
+			}
+			else
+			{
+				// Integer attributes cannot be assigned Float results (Update reports the error)
+				const DatumType target = _slotTypes.Front();
+				const DatumType result = instruction.Code == OpCode::Assign ? rhs :
+					(target == DatumType::Integer && rhs == DatumType::Integer ? DatumType::Integer : DatumType::Float);
+				if (target == DatumType::Integer && result != DatumType::Integer)
+				{
+					return false;
+				}
+				lhs = target;
+			}
+		}
+
+		return true;
+	}
+
+	void ExpressionBatch::Evaluate(const ActionExpression& action, size_t count)
+	{
+		_stackTypes.Clear();
+		size_t depth = 0_z;
+		for (const auto& instruction : action._program)
+		{
+			switch (instruction.Type)
+			{
+				case InstructionType::Operand:
+					if (_stack.Size() == depth)
+					{
+						_stack.EmplaceBack();
+					}
+					Copy(_stack[depth], _columns[instruction.Slot], _slotTypes[instruction.Slot], count);
+					_stackTypes.PushBack(_slotTypes[instruction.Slot]);
+					++depth;
+					break;
+
+				case InstructionType::Operator:
+					Apply(instruction.Code, _stack[depth - 2], _stackTypes[depth - 2], _stack[depth - 1], _stackTypes[depth - 1], count);
+					_stackTypes.PopBack();
+					--depth;
+					break;
+
+				case InstructionType::AssignOperator:
+				{
+					// Assignments always target the first operand of the expression
+					Column& lhs = _stack[depth - 2];
+					Datum::DatumType& lhsType = _stackTypes[depth - 2];
+					Copy(lhs, _columns.Front(), _slotTypes.Front(), count);
+					lhsType = _slotTypes.Front();
+					Apply(instruction.Code, lhs, lhsType, _stack[depth - 1], _stackTypes[depth - 1], count);
+					if (_slotTypes.Front() == Datum::DatumType::Float)
+					{
+						Promote(lhs, lhsType, count);
+					}
+					_stackTypes.PopBack();
+					--depth;
+					break;
+				}
+
+				default:
+					assert(false);
+			}
+		}
+
+		_resultType = _stackTypes.Back();
+	}
+
+	void ExpressionBatch::Scatter(const Group& group)
+	{
+		const ActionExpression& first = *group.Actions.Front();
+		const size_t slotCount = first._operands.Size();
+		const size_t count = group.Actions.Size();
+		const bool assigns = first._program.Back().Type == InstructionType::AssignOperator;
+		const Column& result = _stack.Front();
+
+		if (_resultType == Datum::DatumType::Integer)
+		{
+			const int* integers = &result.Integers.Front();
+			for (size_t i = 0_z; i < count; ++i)
+			{
+				Value& value = group.Actions[i]->_result;
+				value.Type = Datum::DatumType::Integer;
+				value.Integer = integers[i];
+				if (assigns)
+				{
+					_operands[i * slotCount]->TypedRef<int>().Front() = integers[i];
+				}
+			}
+		}
+		else
+		{
+			const float* floats = &result.Floats.Front();
+			for (size_t i = 0_z; i < count; ++i)
+			{
+				Value& value = group.Actions[i]->_result;
+				value.Type = Datum::DatumType::Float;
+				value.Float = floats[i];
+				if (assigns)
+				{
+					_operands[i * slotCount]->TypedRef<float>().Front() = floats[i];
+				}
+			}
+		}
+	}
+
+	void ExpressionBatch::Apply(OpCode code, Column& lhs, Datum::DatumType& lhsType, Column& rhs, Datum::DatumType rhsType, size_t count)
+	{
+		if (code == OpCode::Assign)
+		{
+			Copy(lhs, rhs, rhsType, count);
+			lhsType = rhsType;
+			return;
+		}
+
+		if (lhsType == Datum::DatumType::Integer && rhsType == Datum::DatumType::Integer)
+		{
+			int* left = &lhs.Integers.Front();
+			const int* right = &rhs.Integers.Front();
+			switch (code)
+			{
+				case OpCode::Add:
+					for (size_t i = 0_z; i < count; ++i) left[i] += right[i];
+					break;
+				case OpCode::Subtract:
+					for (size_t i = 0_z; i < count; ++i) left[i] -= right[i];
+					break;
+				case OpCode::Multiply:
+					for (size_t i = 0_z; i < count; ++i) left[i] *= right[i];
+					break;
+				case OpCode::Divide:
+					for (size_t i = 0_z; i < count; ++i) left[i] /= right[i];
+					break;
+				case OpCode::Mod:
+					for (size_t i = 0_z; i < count; ++i) left[i] %= right[i];
+					break;
+				case OpCode::Equals:
+					for (size_t i = 0_z; i < count; ++i) left[i] = left[i] == right[i];
+					break;
+				case OpCode::NotEquals:
+					for (size_t i = 0_z; i < count; ++i) left[i] = left[i] != right[i];
+					break;
+				default:
+					assert(false);
+			}
+			return;
+		}
+
+		// Integers mixed with floats are promoted to float
+		Promote(lhs, lhsType, count);
+		Promote(rhs, rhsType, count);
+		float* left = &lhs.Floats.Front();
+		const float* right = &rhs.Floats.Front();
+		switch (code)
+		{
+			case OpCode::Add:
+				SimdMath::Add(left, left, right, count);
+				break;
+			case OpCode::Subtract:
+				SimdMath::Subtract(left, left, right, count);
+				break;
+			case OpCode::Multiply:
+				SimdMath::Multiply(left, left, right, count);
+				break;
+			case OpCode::Divide:
+				SimdMath::Divide(left, left, right, count);
+				break;
+			case OpCode::Mod:
+				for (size_t i = 0_z; i < count; ++i) left[i] = std::fmod(left[i], right[i]);
+				break;
+			case OpCode::Equals:
+			case OpCode::NotEquals:
+			{
+				if (lhs.Integers.Size() < count) lhs.Integers.Resize(count);
+				int* integers = &lhs.Integers.Front();
+				const bool equals = code == OpCode::Equals;
+				for (size_t i = 0_z; i < count; ++i) integers[i] = (left[i] == right[i]) == equals;
+				lhsType = Datum::DatumType::Integer;
+				break;
+			}
+			default:
+				assert(false);
+		}
+	}
+
+	void ExpressionBatch::Promote(Column& column, Datum::DatumType& type, size_t count)
+	{
+		if (type == Datum::DatumType::Integer)
+		{
+			if (column.Floats.Size() < count) column.Floats.Resize(count);
+			float* floats = &column.Floats.Front();
+			const int* integers = &column.Integers.Front();
+			for (size_t i = 0_z; i < count; ++i)
+			{
+				floats[i] = static_cast<float>(integers[i]);
+			}
+			type = Datum::DatumType::Float;
+		}
+	}
+
+	void ExpressionBatch::Copy(Column& destination, const Column& source, Datum::DatumType type, size_t count)
+	{
+		if (type == Datum::DatumType::Integer)
+		{
+			if (destination.Integers.Size() < count) destination.Integers.Resize(count);
+			std::copy_n(&source.Integers.Front(), count, &destination.Integers.Front());
+		}
+		else
+		{
+			if (destination.Floats.Size() < count) destination.Floats.Resize(count);
+			std::copy_n(&source.Floats.Front(), count, &destination.Floats.Front());
+		}
+	}
+}
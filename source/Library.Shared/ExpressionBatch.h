@@ -0,0 +1,114 @@
+#pragma once
+
+#include "ActionExpression.h"
+#include "HashMap.h"
+#include "Vector.h"
+
+namespace FieaGameEngine
+{
+	class WorldState;
+
+	/// <summary>
+	/// ExpressionBatch updates many ActionExpressions together. Expressions are queued with Add and
+	/// grouped by their compiled program, so expressions of the same shape share a group even when
+	/// their attributes differ (e.g. "A + B" and "C + D"). Update then gathers the operands of each group into contiguous
+	/// columns (one per operand), runs the group's program once over whole columns with vectorized
+	/// kernels and scatters the results back to the attributes and the actions.
+	/// Groups are updated in the order they were first queued. A group is updated one action at a
+	/// time instead, with the same results as ActionExpression::Update, when its operands are not all
+	/// Integer or Float of the same types for every action, or when one action assigns an attribute
+	/// another action of the group also uses. When a group assigns an attribute that another group
+	/// uses, every action is updated one at a time in the order it was queued.
+	/// Set WorldState::ExpressionBatch to have Entities queue their ActionExpressions here. Entities
+	/// update the batch before any other action, so that action sees what the queued expressions assign.
+	/// </summary>
+	class ExpressionBatch final
+	{
+	public:
+		ExpressionBatch() = default;
+		ExpressionBatch(const ExpressionBatch&) = delete;
+		ExpressionBatch(ExpressionBatch&&) noexcept = default;
+		ExpressionBatch& operator=(const ExpressionBatch&) = delete;
+		ExpressionBatch& operator=(ExpressionBatch&&) noexcept = default;
+		~ExpressionBatch() = default;
+
+		/// <summary>
+		/// Queues the action to be updated by the next Update.
+		/// </summary>
+		/// <param name="action">action to queue, it must stay alive until the batch is updated or cleared</param>
+		/// <exception cref="runtime_error">Empty expression</exception>
+		/// <exception cref="runtime_error">Expression is malformed</exception>
+		void Add(ActionExpression& action);
+		/// <summary>
+		/// Number of actions queued.
+		/// </summary>
+		/// <returns>number of actions queued</returns>
+		size_t Size() const;
+		/// <summary>
+		/// Is nothing queued?
+		/// </summary>
+		/// <returns>true if no action is queued</returns>
+		bool IsEmpty() const;
+		/// <summary>
+		/// Updates every queued action and empties the batch.
+		/// </summary>
+		/// <param name="worldState">world state passed to actions updated one at a time</param>
+		void Update(WorldState& worldState);
+		/// <summary>
+		/// Empties the batch without updating. Scratch memory is kept for the next batch.
+		/// </summary>
+		void Clear();
+
+	private:
+		using Value = ActionExpression::Value;
+		using OpCode = ActionExpression::OpCode;
+		using InstructionType = ActionExpression::InstructionType;
+
+		using Instruction = ActionExpression::Instruction;
+
+		struct Group final
+		{
+			Vector<ActionExpression*> Actions;
+		};
+
+		struct ProgramHash final
+		{
+			size_t operator()(const Vector<Instruction>& program) const;
+		};
+
+		struct ProgramEquality final
+		{
+			bool operator()(const Vector<Instruction>& lhs, const Vector<Instruction>& rhs) const;
+		};
+
+		struct Column final
+		{
+			Vector<int> Integers;
+			Vector<float> Floats;
+		};
+
+		bool GroupsOverlap();
+		bool Gather(const Group& group);
+		bool InferTypes(const ActionExpression& action);
+		void Evaluate(const ActionExpression& action, size_t count);
+		void Scatter(const Group& group);
+
+		static void Apply(OpCode code, Column& lhs, Datum::DatumType& lhsType, Column& rhs, Datum::DatumType rhsType, size_t count);
+		static void Promote(Column& column, Datum::DatumType& type, size_t count);
+		static void Copy(Column& destination, const Column& source, Datum::DatumType type, size_t count);
+
+		HashMap<Vector<Instruction>, size_t, ProgramHash, ProgramEquality> _groupIndices;
+		Vector<Group> _groups;
+		Vector<ActionExpression*> _queue;
+
+		// Scratch reused between updates
+		Vector<Datum*> _operands;
+		Vector<Datum::DatumType> _slotTypes;
+		Vector<Datum::DatumType> _stackTypes;
+		Vector<Column> _columns;
+		Vector<Column> _stack;
+		HashMap<const Datum*, size_t> _targets;
+		HashMap<const Datum*, size_t> _assigningGroups;
+		Datum::DatumType _resultType{ Datum::DatumType::Unknown };
+	};
+}
@@ -2,8 +2,10 @@
 
 #include <gsl/gsl>
 #include <limits>
+#include <string>
+#include <string_view>
 
-#include "HashMap.h"
+#include "ConcurrentHashMap.h"
 
 namespace FieaGameEngine
 {
@@ -32,14 +34,14 @@ namespace FieaGameEngine
 		/// </summary>
 		/// <param name="className">given class name</param>
 		/// <returns>the associated concrete factory</returns>
-		static const Factory* const Find(const std::string& className);
+		static const Factory* const Find(std::string_view className);
 
 		/// <summary>
 		/// Given a class name (string), returns a new object of that type.
 		/// </summary>
 		/// <param name="className">given class name</param>
 		/// <returns>new object of that type given</returns>
-		static gsl::owner<T*> Create(const std::string& className);
+		static gsl::owner<T*> Create(std::string_view className);
 		/// <summary>
 		/// resizes the factory map of all factories
 		/// </summary>
@@ -59,10 +61,15 @@ namespace FieaGameEngine
 
 	protected:
 		static void Add(const Factory& factory);
+		/// <summary>
+		/// Unregisters the factory and frees its entry right away, so factories must not be destroyed
+		/// while another thread is finding or creating through this Factory.
+		/// </summary>
+		/// <param name="factory">factory to unregister</param>
 		static void Remove(const Factory& factory);
 
 	private:
-		inline static HashMap<std::string, const Factory* const> _factories;
+		inline static ConcurrentHashMap<std::string, const Factory* const> _factories{ 64_z };
 	};
 }
 
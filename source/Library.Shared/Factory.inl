@@ -3,17 +3,17 @@
 namespace FieaGameEngine
 {
 	template<typename T>
-	inline const Factory<T>* const Factory<T>::Find(const std::string& className)
+	inline const Factory<T>* const Factory<T>::Find(std::string_view className)
 	{
-		auto it = _factories.Find(className);
-		return it != _factories.end() ? it->second : nullptr;
+		const auto* entry = _factories.Find(className);
+		return entry != nullptr ? entry->second : nullptr;
 	}
 
 	template<typename T>
-	inline gsl::owner<T*> Factory<T>::Create(const std::string& className)
+	inline gsl::owner<T*> Factory<T>::Create(std::string_view className)
 	{
-		auto it = _factories.Find(className);
-		return it != _factories.end() ? it->second->Create() : nullptr;
+		const auto* entry = _factories.Find(className);
+		return entry != nullptr ? entry->second->Create() : nullptr;
 	}
 
 	template<typename T>
@@ -37,7 +37,7 @@ namespace FieaGameEngine
 	template<typename T>
 	inline void Factory<T>::Add(const Factory& factory)
 	{
-		auto [it, wasInserted] = _factories.Insert(std::make_pair(factory.ClassName(), &factory));
+		auto [it, wasInserted] = _factories.TryEmplace(factory.ClassName(), &factory);
 		if (!wasInserted)
 		{
 			throw std::runtime_error("Factory Not Added, possibly already instantiated?");
@@ -48,5 +48,6 @@ namespace FieaGameEngine
 	inline void Factory<T>::Remove(const Factory& factory)
 	{
 		_factories.Remove(factory.ClassName());
+		_factories.Reclaim();
 	}
 }
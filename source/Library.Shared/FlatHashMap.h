@@ -0,0 +1,534 @@
+#pragma once
+
+#include <utility>
+#include <functional>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define FIEA_FLATHASHMAP_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "DefaultHash.h"
+#include "DefaultEquality.h"
+#include "SizeLiteral.h"
+
+namespace FieaGameEngine
+{
+	/// <summary>
+	/// A group of 16 control bytes from a FlatHashMap. Each control byte describes one slot:
+	/// Empty, Deleted, or Full (in which case it holds 7 bits of the key's hash).
+	/// All 16 bytes are matched at once with SSE2 when it is available.
+	/// </summary>
+	class ControlGroup final
+	{
+	public:
+		using ControlByte = std::int8_t;
+		using BitMask = std::uint32_t;
+
+		static constexpr size_t Width = 16;
+		static constexpr ControlByte Empty = static_cast<ControlByte>(0x80);
+		static constexpr ControlByte Deleted = static_cast<ControlByte>(0xFE);
+
+		/// <summary>
+		/// Loads the 16 control bytes starting at position.
+		/// </summary>
+		/// <param name="position">first control byte of the group</param>
+		explicit ControlGroup(const ControlByte* position);
+
+		/// <summary>
+		/// Slots whose control byte is equal to the 7 bit hash passed in.
+		/// </summary>
+		/// <param name="hash">7 bit hash to match</param>
+		/// <returns>bit i is set if slot i matches</returns>
+		BitMask Match(ControlByte hash) const;
+		/// <summary>
+		/// Slots that have never been used.
+		/// </summary>
+		/// <returns>bit i is set if slot i is empty</returns>
+		BitMask MatchEmpty() const;
+		/// <summary>
+		/// Slots that can receive a new entry.
+		/// </summary>
+		/// <returns>bit i is set if slot i is empty or deleted</returns>
+		BitMask MatchEmptyOrDeleted() const;
+
+	private:
+#ifdef FIEA_FLATHASHMAP_SSE2
+		__m128i _control;
+#else
+		const ControlByte* _control;
+#endif
+	};
+
+	/// <summary>
+	/// FlatHashMap is an open addressing unordered map with the same interface as HashMap.
+	/// Entries are stored inline in one slot array and each slot has a one byte control
+	/// entry. Lookups probe a group of 16 control bytes at a time, so most misses and hits
+	/// touch a single cache line of metadata before comparing a key.
+	/// Unlike HashMap, inserting can move existing entries when the table grows, so
+	/// pointers and iterators into the map are invalidated by Insert and Resize.
+	/// Like HashMap, the functors are template parameters called directly.
+	/// </summary>
+	/// <typeparam name="TKey">Key that will be hashed to access map</typeparam>
+	/// <typeparam name="TValue">Value to be stored at key</typeparam>
+	/// <typeparam name="THash">Functor hashing a key to a size_t</typeparam>
+	/// <typeparam name="TEq">Functor comparing two keys for equality</typeparam>
+	template <typename TKey, typename TValue, typename THash = DefaultHash<TKey>, typename TEq = DefaultEquality<TKey>>
+	class FlatHashMap final
+	{
+	public:
+		using PairType = std::pair<const TKey, TValue>;
+		using HashFunctor = THash;
+		using EqualityFunctor = TEq;
+
+	private:
+		using ControlByte = ControlGroup::ControlByte;
+		using BitMask = ControlGroup::BitMask;
+
+	public:
+		class Iterator final
+		{
+			friend FlatHashMap;
+			friend class ConstIterator;
+
+		public:
+			/// <summary>
+			/// Constructs iterator using default constructor provided by compiler
+			/// </summary>
+			Iterator() = default;
+			/// <summary>
+			/// Copies iterator using default copy semantics provided by compiler
+			/// </summary>
+			/// <param name="">other iterator to copy</param>
+			Iterator(const Iterator&) = default;
+			/// <summary>
+			/// Moves iterator using default move semantics provided by compiler
+			/// </summary>
+			/// <param name="">other iterator to move</param>
+			Iterator(Iterator&&) noexcept = default;
+			/// <summary>
+			/// Copy operation for iterator using default copy semantics provided by compiler
+			/// </summary>
+			/// <param name="other">other iterator to copy</param>
+			/// <returns>iterator address of the copied iterator</returns>
+			Iterator& operator=(const Iterator& other) = default;
+			/// <summary>
+			/// move operation for iterator using default move semantics provided by compiler
+			/// </summary>
+			/// <param name="other">other iterator to move</param>
+			/// <returns>iterator address of the moved iterator</returns>
+			Iterator& operator=(Iterator&& other) noexcept = default;
+			/// <summary>
+			/// Default Destructor of Iterator
+			/// </summary>
+			~Iterator() = default;
+
+			/// <summary>
+			/// returns data that the iterator is pointing to.
+			/// </summary>
+			/// <returns>data pointed to by iterators</returns>
+			/// <exception cref="runtime_error">uninitialized iterator</exception>
+			/// <exception cref="out_of_range">thrown if the iterator is end</exception>
+			PairType& operator*() const;
+			/// <summary>
+			/// returns pointer to the data that the iterator is pointing to.
+			/// </summary>
+			/// <returns>pointer to data pointed to by iterators</returns>
+			/// <exception cref="runtime_error">uninitialized iterator</exception>
+			/// <exception cref="out_of_range">thrown if the iterator is end</exception>
+			PairType* operator->() const;
+
+			/// <summary>
+			/// !(operator!=(other))
+			/// </summary>
+			/// <param name="other"></param>
+			/// <returns>!(operator!=(other))</returns>
+			bool operator==(const Iterator& other) const;
+			/// <summary>
+			/// The iterators are not equal if the owners are not the same or the slots are not the same
+			/// </summary>
+			/// <param name="other">other iterator to compare to</param>
+			/// <returns>true if not equal and false otherwise</returns>
+			bool operator!=(const Iterator& other) const;
+
+			/// <summary>
+			/// pre increments iterator by moving to the next full slot
+			/// </summary>
+			/// <returns>reference to the iterator</returns>
+			/// <exception cref="runtime_error">uninitialized iterator</exception>
+			Iterator& operator++();
+			/// <summary>
+			/// increments iterator by moving to the next full slot after
+			/// expression is over
+			/// </summary>
+			/// <returns>copy of iterator before increment</returns>
+			/// <exception cref="runtime_error">uninitialized iterator</exception>
+			Iterator operator++(int);
+
+		private:
+			Iterator(FlatHashMap& owner, size_t index);
+			FlatHashMap* _owner{ nullptr };
+			size_t _index{ 0_z };
+		};
+
+		class ConstIterator final
+		{
+			friend FlatHashMap;
+
+		public:
+			/// <summary>
+			/// Constructs constant iterator using default constructor provided by compiler
+			/// </summary>
+			ConstIterator() = default;
+			/// <summary>
+			/// Casts non constant iterator into constant iterator
+			/// </summary>
+			/// <param name="it">iterator to cast</param>
+			ConstIterator(const Iterator& it);
+			/// <summary>
+			/// Copies constant iterator using default copy semantics provided by compiler
+			/// </summary>
+			/// <param name="">other constant iterator to copy</param>
+			ConstIterator(const ConstIterator&) = default;
+			/// <summary>
+			/// Moves constant iterator using default move semantics provided by compiler
+			/// </summary>
+			/// <param name="">other constant iterator to move</param>
+			ConstIterator(ConstIterator&&) noexcept = default;
+			/// <summary>
+			/// Copy operation for constant iterator using default copy semantics provided by compiler
+			/// </summary>
+			/// <param name="other">other constant iterator to copy</param>
+			/// <returns>iterator address of the copied constant iterator</returns>
+			ConstIterator& operator=(const ConstIterator& other) = default;
+			/// <summary>
+			/// move operation for constant iterator using default move semantics provided by compiler
+			/// </summary>
+			/// <param name="other">other constant iterator to move</param>
+			/// <returns>iterator address of the moved constant iterator</returns>
+			ConstIterator& operator=(ConstIterator&& other) noexcept = default;
+			/// <summary>
+			/// Default Destructor of ConstIterator
+			/// </summary>
+			~ConstIterator() = default;
+
+			/// <summary>
+			/// returns const reference to data that the const iterator is pointing to.
+			/// </summary>
+			/// <returns>data pointed to by iterators</returns>
+			/// <exception cref="runtime_error">uninitialized iterator</exception>
+			/// <exception cref="out_of_range">thrown if the iterator is end</exception>
+			const PairType& operator*() const;
+			/// <summary>
+			/// returns const pointer to the data that the iterator is pointing to.
+			/// </summary>
+			/// <returns>pointer to data pointed to by iterators</returns>
+			/// <exception cref="runtime_error">uninitialized iterator</exception>
+			/// <exception cref="out_of_range">thrown if the iterator is end</exception>
+			const PairType* operator->() const;
+
+			/// <summary>
+			/// !(operator!=(other))
+			/// </summary>
+			/// <param name="other"></param>
+			/// <returns>!(operator!=(other))</returns>
+			bool operator==(const ConstIterator& other) const;
+			/// <summary>
+			/// The constant iterators are not equal if the owners are not the same or the slots are not the same
+			/// </summary>
+			/// <param name="other">other constant iterator to compare to</param>
+			/// <returns>true if not equal and false otherwise</returns>
+			bool operator!=(const ConstIterator& other) const;
+
+			/// <summary>
+			/// pre increments iterator by moving to the next full slot
+			/// </summary>
+			/// <returns>reference to the iterator</returns>
+			/// <exception cref="runtime_error">uninitialized iterator</exception>
+			ConstIterator& operator++();
+			/// <summary>
+			/// increments iterator by moving to the next full slot after
+			/// expression is over
+			/// </summary>
+			/// <returns>copy of iterator before increment</returns>
+			/// <exception cref="runtime_error">uninitialized iterator</exception>
+			ConstIterator operator++(int);
+
+		private:
+			ConstIterator(const FlatHashMap& owner, size_t index);
+			const FlatHashMap* _owner{ nullptr };
+			size_t _index{ 0_z };
+		};
+
+		/// <summary>
+		/// Creates new instance of FlatHashMap container. Requires a size > 0.
+		/// Size is the number of entries the map can hold before it has to grow.
+		/// Can pass in a custom HashFunctor as well as an EqualityFunctor, but
+		/// both are required when one is passed in.
+		/// </summary>
+		/// <param name="size">Number of entries to make room for</param>
+		/// <param name="hashFuctor">function to use to hash keys</param>
+		/// <param name="equalityFunctor">function to use to check for key equality</param>
+		/// <exception cref="runtime-error">size cannot be zero</exception>
+		FlatHashMap(size_t size = 11_z, HashFunctor hashFunctor = DefaultHashFunctor(), EqualityFunctor equalityFunctor = DefaultEqualityFunctor());
+		/// <summary>
+		/// Flat Hash Map initializer list constructor with default functors
+		/// </summary>
+		/// <param name="list">initializer list</param>
+		FlatHashMap(std::initializer_list<PairType> list);
+		/// <summary>
+		/// Flat Hash Map initializer list constructor with user defined functors
+		/// </summary>
+		/// <param name="list">initializer list</param>
+		/// <param name="hashFunctor">hash functor</param>
+		/// <param name="equalityFunctor">equality functor</param>
+		FlatHashMap(std::initializer_list<PairType> list, HashFunctor hashFunctor, EqualityFunctor equalityFunctor);
+		/// <summary>
+		/// Copy Constructor for new instance of FlatHashMap container.
+		/// Deep copies other FlatHashMap passed in, keeping the same slot layout.
+		/// </summary>
+		/// <param name="other">other map to copy from</param>
+		FlatHashMap(const FlatHashMap& other);
+		/// <summary>
+		/// Move Constructor for new instance of FlatHashMap container.
+		/// Takes ownership of the slots of the other map, leaving it empty.
+		/// </summary>
+		/// <param name="other">other map to move from</param>
+		FlatHashMap(FlatHashMap&& other) noexcept;
+		/// <summary>
+		/// Copy operator for FlatHashMap container.
+		/// Clears current map and copies over the other map.
+		/// </summary>
+		/// <param name="other">other map to copy</param>
+		/// <returns>copy of the other map</returns>
+		FlatHashMap& operator=(const FlatHashMap& other);
+		/// <summary>
+		/// Move operator for FlatHashMap container.
+		/// Clears current map and moves over the other map.
+		/// </summary>
+		/// <param name="other">other map to move</param>
+		/// <returns>moved map</returns>
+		FlatHashMap& operator=(FlatHashMap&& other) noexcept;
+		/// <summary>
+		/// Destructs FlatHashMap container destructing elements and freeing data.
+		/// </summary>
+		~FlatHashMap();
+
+		/// <summary>
+		/// Is FlatHashMap empty?
+		/// </summary>
+		/// <returns>true if map is empty false otherwise</returns>
+		bool IsEmpty() const;
+		/// <summary>
+		/// Size of the FlatHashMap
+		/// </summary>
+		/// <returns>the amount of elements of the container</returns>
+		size_t Size() const;
+		/// <summary>
+		/// Number of slots of the FlatHashMap. Always a power of two multiple of 16.
+		/// </summary>
+		/// <returns>the number of slots of the container</returns>
+		size_t BucketSize() const;
+
+		/// <summary>
+		/// Finds and returns iterator pointing to slot where key resides, if not found it returns end.
+		/// </summary>
+		/// <param name="value">key to find in map</param>
+		/// <returns>Iterator pointing to slot containing key or end if not found</returns>
+		Iterator Find(const TKey& key);
+		/// <summary>
+		/// Finds and returns iterator pointing to slot where key resides, if not found it returns end.
+		/// </summary>
+		/// <param name="value">key to find in map</param>
+		/// <returns>ConstIterator pointing to slot containing key or end if not found</returns>
+		ConstIterator Find(const TKey& key) const;
+		/// <summary>
+		/// Insert will try to insert the entry passed in, if the entry is not in the map
+		/// then it will insert it and return the iterator pointing to the entry.
+		/// If the entry is in the map then it will not be inserted and the returned Iterator
+		/// will be pointing to the already inserted entry.
+		/// </summary>
+		/// <param name="entry"></param>
+		/// <returns>pair of Iterator where entry was inserted (if inserted) and bool if entry was inserted</returns>
+		std::pair<Iterator, bool> Insert(const PairType& entry);
+		/// <summary>
+		/// Constructs an entry from the arguments passed in, as if by PairType(args...), and inserts it
+		/// if its key is not in the map yet. The key has to be known before a slot can be picked, so the
+		/// entry is built first and then moved into its slot.
+		/// </summary>
+		/// <param name="args">arguments forwarded to the constructor of PairType</param>
+		/// <returns>pair of Iterator to the entry with that key and bool if the entry was inserted</returns>
+		template <typename... Args>
+		std::pair<Iterator, bool> Emplace(Args&&... args);
+		/// <summary>
+		/// Inserts an entry for key with a value constructed in place from the arguments passed in,
+		/// if key is not in the map yet. Nothing is constructed, copied or moved otherwise.
+		/// </summary>
+		/// <param name="key">key of the entry</param>
+		/// <param name="args">arguments forwarded to the constructor of TValue</param>
+		/// <returns>pair of Iterator to the entry with that key and bool if the entry was inserted</returns>
+		template <typename... Args>
+		std::pair<Iterator, bool> TryEmplace(const TKey& key, Args&&... args);
+		/// <summary>
+		/// Inserts an entry for key with a value constructed in place from the arguments passed in,
+		/// if key is not in the map yet. The key is only moved from if the entry is inserted.
+		/// </summary>
+		/// <param name="key">key of the entry</param>
+		/// <param name="args">arguments forwarded to the constructor of TValue</param>
+		/// <returns>pair of Iterator to the entry with that key and bool if the entry was inserted</returns>
+		template <typename... Args>
+		std::pair<Iterator, bool> TryEmplace(TKey&& key, Args&&... args);
+
+		/// <summary>
+		/// Takes a "key" argument to remove and returns nothing.
+		/// It removes the matching entry, if it exists, otherwise it does nothing.
+		/// </summary>
+		/// <param name="key">key entry to remove from map</param>
+		void Remove(const TKey& key);
+
+		/// <summary>
+		/// Completely clears the map of its data, keeping its slots.
+		/// </summary>
+		void Clear();
+		/// <summary>
+		/// Rehashes the map so it can hold at least size entries before growing again.
+		/// Never shrinks below what is needed for the current entries.
+		/// </summary>
+		/// <param name="size">number of entries to make room for</param>
+		void Resize(size_t size);
+
+		/// <summary>
+		/// returns a Boolean indicating the presence of a key within the map.
+		/// </summary>
+		/// <param name="key">key to find</param>
+		/// <returns>true if key is within the map, false otherwise</returns>
+		bool ContainsKey(const TKey& key) const;
+		/// <summary>
+		/// Access to the value in the map. If map has no entry associated with
+		/// the key then it will create a default entry.
+		/// </summary>
+		/// <returns>reference to the value at the given key</returns>
+		TValue& operator[](const TKey& key);
+		/// <summary>
+		/// Access to the data in the container at the given key.
+		/// </summary>
+		/// <returns>reference to the value at the given key</returns>
+		/// <exception cref="runtime_error">thrown if there is no key in container</exception>
+		TValue& At(const TKey& key);
+		/// <summary>
+		/// access to the (constant) data in the container at the key.
+		/// </summary>
+		/// <returns>constant reference to the value at the given key</returns>
+		/// <exception cref="runtime_error">thrown if there is no key in container</exception>
+		const TValue& At(const TKey& key) const;
+
+		/// <summary>
+		/// Find with a key of another type, e.g. a string literal or std::string_view for a std::string key.
+		/// Only available when both functors are transparent, so the key is hashed and compared as is
+		/// instead of being converted to a TKey first.
+		/// </summary>
+		/// <param name="key">key to find in the map</param>
+		/// <returns>Iterator pointing to the slot containing key or end if not found</returns>
+		template <typename TLookup> requires TransparentFunctor<THash> && TransparentFunctor<TEq>
+		Iterator Find(const TLookup& key);
+		/// <summary>
+		/// Find with a key of another type. Only available when both functors are transparent.
+		/// </summary>
+		/// <param name="key">key to find in the map</param>
+		/// <returns>ConstIterator pointing to the slot containing key or end if not found</returns>
+		template <typename TLookup> requires TransparentFunctor<THash> && TransparentFunctor<TEq>
+		ConstIterator Find(const TLookup& key) const;
+		/// <summary>
+		/// ContainsKey with a key of another type. Only available when both functors are transparent.
+		/// </summary>
+		/// <param name="key">key to find</param>
+		/// <returns>true if key is within the map, false otherwise</returns>
+		template <typename TLookup> requires TransparentFunctor<THash> && TransparentFunctor<TEq>
+		bool ContainsKey(const TLookup& key) const;
+		/// <summary>
+		/// At with a key of another type. Only available when both functors are transparent.
+		/// </summary>
+		/// <returns>reference to the value at the given key</returns>
+		/// <exception cref="runtime_error">thrown if there is no key in container</exception>
+		template <typename TLookup> requires TransparentFunctor<THash> && TransparentFunctor<TEq>
+		TValue& At(const TLookup& key);
+		/// <summary>
+		/// At with a key of another type. Only available when both functors are transparent.
+		/// </summary>
+		/// <returns>constant reference to the value at the given key</returns>
+		/// <exception cref="runtime_error">thrown if there is no key in container</exception>
+		template <typename TLookup> requires TransparentFunctor<THash> && TransparentFunctor<TEq>
+		const TValue& At(const TLookup& key) const;
+		/// <summary>
+		/// Remove with a key of another type. Only available when both functors are transparent.
+		/// </summary>
+		/// <param name="key">key entry to remove from the map</param>
+		template <typename TLookup> requires TransparentFunctor<THash> && TransparentFunctor<TEq>
+		void Remove(const TLookup& key);
+
+		/// <summary>
+		/// returns a FlatHashMap::Iterator pointing to the first full slot.
+		/// </summary>
+		/// <returns>the iterator pointing to the first element of the container</returns>
+		Iterator begin();
+		/// <summary>
+		/// (const) returns a FlatHashMap::ConstIterator pointing to the first full slot.
+		/// </summary>
+		/// <returns>the constant iterator pointing to the first element of the constant container</returns>
+		ConstIterator begin() const;
+		/// <summary>
+		/// returns a FlatHashMap::ConstIterator pointing to the first full slot (const only)
+		/// Used primarily to get constant iterators on a non-constant container
+		/// </summary>
+		/// <returns>the constant iterator pointing to the first element of the container</returns>
+		ConstIterator cbegin() const;
+		/// <summary>
+		/// returns a FlatHashMap::Iterator pointing past the last slot.
+		/// </summary>
+		/// <returns>the iterator pointing past the last element of the container</returns>
+		Iterator end();
+		/// <summary>
+		/// (const) returns a FlatHashMap::ConstIterator pointing past the last slot.
+		/// </summary>
+		/// <returns>the constant iterator pointing past the last element of the constant container</returns>
+		ConstIterator end() const;
+		/// <summary>
+		/// returns a FlatHashMap::ConstIterator pointing past the last slot (const only)
+		/// Used primarily to get constant iterators on a non-constant container
+		/// </summary>
+		/// <returns>the constant iterator pointing past the last element of the container</returns>
+		ConstIterator cend() const;
+
+	private:
+		static size_t CapacityFor(size_t size);
+		static size_t GrowthFor(size_t capacity);
+		static ControlByte H2(size_t hash);
+		static HashFunctor DefaultHashFunctor();
+		static EqualityFunctor DefaultEqualityFunctor();
+
+		template <typename TLookup>
+		size_t FindIndex(const TLookup& key) const;
+		void RemoveIndex(size_t index);
+		size_t FindInsertIndex(size_t hash) const;
+		template <typename... Args>
+		size_t InsertNew(size_t hash, Args&&... args);
+		template <typename TKeyArg, typename... Args>
+		std::pair<Iterator, bool> TryEmplaceKey(TKeyArg&& key, Args&&... args);
+		size_t NextFullIndex(size_t index) const;
+		void Rehash(size_t capacity);
+		void DestroySlots();
+
+		ControlByte* _control{ nullptr };
+		PairType* _slots{ nullptr };
+		size_t _capacity{ 0_z };
+		size_t _size{ 0_z };
+		size_t _growthLeft{ 0_z };
+		[[msvc::no_unique_address]] HashFunctor _hashFunctor;
+		[[msvc::no_unique_address]] EqualityFunctor _equalityFunctor;
+	};
+}
+
+#include "FlatHashMap.inl"
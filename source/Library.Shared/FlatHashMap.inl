@@ -0,0 +1,749 @@
+#include "pch.h"
+
+#include <bit>
+#include <cstring>
+
+#include "FlatHashMap.h"
+
+namespace FieaGameEngine
+{
+#pragma region ControlGroup
+#ifdef FIEA_FLATHASHMAP_SSE2
+	inline ControlGroup::ControlGroup(const ControlByte* position) :
+		_control{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(position)) }
+	{
+	}
+
+	inline ControlGroup::BitMask ControlGroup::Match(ControlByte hash) const
+	{
+		return static_cast<BitMask>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(hash), _control)));
+	}
+
+	inline ControlGroup::BitMask ControlGroup::MatchEmpty() const
+	{
+		return static_cast<BitMask>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(Empty), _control)));
+	}
+
+	inline ControlGroup::BitMask ControlGroup::MatchEmptyOrDeleted() const
+	{
+		// Empty and Deleted are the only control bytes with the sign bit set.
+		return static_cast<BitMask>(_mm_movemask_epi8(_control));
+	}
+#else
+	inline ControlGroup::ControlGroup(const ControlByte* position) :
+		_control{ position }
+	{
+	}
+
+	inline ControlGroup::BitMask ControlGroup::Match(ControlByte hash) const
+	{
+		BitMask mask = 0;
+		for (size_t i = 0_z; i < Width; ++i)
+		{
+			mask |= static_cast<BitMask>(_control[i] == hash) << i;
+		}
+		return mask;
+	}
+
+	inline ControlGroup::BitMask ControlGroup::MatchEmpty() const
+	{
+		return Match(Empty);
+	}
+
+	inline ControlGroup::BitMask ControlGroup::MatchEmptyOrDeleted() const
+	{
+		BitMask mask = 0;
+		for (size_t i = 0_z; i < Width; ++i)
+		{
+			mask |= static_cast<BitMask>(_control[i] < 0) << i;
+		}
+		return mask;
+	}
+#endif
+#pragma endregion
+
+#pragma region Iterator
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline FlatHashMap<TKey, TValue, THash, TEq>::Iterator::Iterator(FlatHashMap& owner, size_t index) :
+		_owner(&owner), _index(index)
+	{
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename FlatHashMap<TKey, TValue, THash, TEq>::PairType& FlatHashMap<TKey, TValue, THash, TEq>::Iterator::operator*() const
+	{
+		if (_owner == nullptr)
+		{
+			throw std::runtime_error("Null reference. Is iterator uninitialized?");
+		}
+		if (_index >= _owner->_capacity)
+		{
+			throw std::out_of_range("Index out of range. Does this Iterator == end()?");
+		}
+		return _owner->_slots[_index];
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename FlatHashMap<TKey, TValue, THash, TEq>::PairType* FlatHashMap<TKey, TValue, THash, TEq>::Iterator::operator->() const
+	{
+		return &operator*();
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline bool FlatHashMap<TKey, TValue, THash, TEq>::Iterator::operator==(const Iterator& other) const
+	{
+		return !(operator!=(other));
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline bool FlatHashMap<TKey, TValue, THash, TEq>::Iterator::operator!=(const Iterator& other) const
+	{
+		return (_owner != other._owner) || (_index != other._index);
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename FlatHashMap<TKey, TValue, THash, TEq>::Iterator& FlatHashMap<TKey, TValue, THash, TEq>::Iterator::operator++()
+	{
+		if (_owner == nullptr)
+		{
+			throw std::runtime_error("Unassociated Iterator.");
+		}
+		if (_index < _owner->_capacity)
+		{
+			_index = _owner->NextFullIndex(_index + 1);
+		}
+		return *this;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename FlatHashMap<TKey, TValue, THash, TEq>::Iterator FlatHashMap<TKey, TValue, THash, TEq>::Iterator::operator++(int)
+	{
+		Iterator temp(*this);
+		operator++();
+		return temp;
+	}
+#pragma endregion
+
+#pragma region ConstIterator
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline FlatHashMap<TKey, TValue, THash, TEq>::ConstIterator::ConstIterator(const Iterator& other) :
+		_owner(other._owner), _index(other._index)
+	{
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline FlatHashMap<TKey, TValue, THash, TEq>::ConstIterator::ConstIterator(const FlatHashMap& owner, size_t index) :
+		_owner(&owner), _index(index)
+	{
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline const typename FlatHashMap<TKey, TValue, THash, TEq>::PairType& FlatHashMap<TKey, TValue, THash, TEq>::ConstIterator::operator*() const
+	{
+		if (_owner == nullptr)
+		{
+			throw std::runtime_error("Null reference. Is iterator uninitialized?");
+		}
+		if (_index >= _owner->_capacity)
+		{
+			throw std::out_of_range("Index out of range. Does this Iterator == end()?");
+		}
+		return _owner->_slots[_index];
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline const typename FlatHashMap<TKey, TValue, THash, TEq>::PairType* FlatHashMap<TKey, TValue, THash, TEq>::ConstIterator::operator->() const
+	{
+		return &operator*();
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline bool FlatHashMap<TKey, TValue, THash, TEq>::ConstIterator::operator==(const ConstIterator& other) const
+	{
+		return !(operator!=(other));
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline bool FlatHashMap<TKey, TValue, THash, TEq>::ConstIterator::operator!=(const ConstIterator& other) const
+	{
+		return (_owner != other._owner) || (_index != other._index);
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename FlatHashMap<TKey, TValue, THash, TEq>::ConstIterator& FlatHashMap<TKey, TValue, THash, TEq>::ConstIterator::operator++()
+	{
+		if (_owner == nullptr)
+		{
+			throw std::runtime_error("Unassociated Iterator.");
+		}
+		if (_index < _owner->_capacity)
+		{
+			_index = _owner->NextFullIndex(_index + 1);
+		}
+		return *this;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename FlatHashMap<TKey, TValue, THash, TEq>::ConstIterator FlatHashMap<TKey, TValue, THash, TEq>::ConstIterator::operator++(int)
+	{
+		ConstIterator temp(*this);
+		operator++();
+		return temp;
+	}
+#pragma endregion
+
+#pragma region FlatHashMap
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline FlatHashMap<TKey, TValue, THash, TEq>::FlatHashMap(size_t size, HashFunctor hashFunctor, EqualityFunctor equalityFunctor) :
+		_hashFunctor{ hashFunctor }, _equalityFunctor{ equalityFunctor }
+	{
+		if (size == 0)
+		{
+			throw std::runtime_error("FlatHashMap can NOT be initialized with a size of ZERO.");
+		}
+
+		Rehash(CapacityFor(size));
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline FlatHashMap<TKey, TValue, THash, TEq>::FlatHashMap(std::initializer_list<PairType> list) :
+		FlatHashMap{ list, DefaultHashFunctor(), DefaultEqualityFunctor() }
+	{
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline FlatHashMap<TKey, TValue, THash, TEq>::FlatHashMap(std::initializer_list<PairType> list, HashFunctor hashFunctor, EqualityFunctor equalityFunctor) :
+		FlatHashMap{ list.size(), hashFunctor, equalityFunctor }
+	{
+		for (const auto& pair : list)
+		{
+			Insert(pair);
+		}
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline FlatHashMap<TKey, TValue, THash, TEq>::FlatHashMap(const FlatHashMap& other) :
+		_size{ other._size }, _growthLeft{ other._growthLeft },
+		_hashFunctor{ other._hashFunctor }, _equalityFunctor{ other._equalityFunctor }
+	{
+		if (other._capacity > 0_z)
+		{
+			_control = static_cast<ControlByte*>(malloc(other._capacity));
+			_slots = static_cast<PairType*>(malloc(other._capacity * sizeof(PairType)));
+			_capacity = other._capacity;
+			assert(_control != nullptr && _slots != nullptr);
+
+			std::memcpy(_control, other._control, _capacity);
+			for (size_t i = 0_z; i < _capacity; ++i)
+			{
+				if (_control[i] >= 0)
+				{
+					new(_slots + i) PairType(other._slots[i]);
+				}
+			}
+		}
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline FlatHashMap<TKey, TValue, THash, TEq>::FlatHashMap(FlatHashMap&& other) noexcept :
+		_control{ other._control }, _slots{ other._slots }, _capacity{ other._capacity },
+		_size{ other._size }, _growthLeft{ other._growthLeft },
+		_hashFunctor{ std::move(other._hashFunctor) }, _equalityFunctor{ std::move(other._equalityFunctor) }
+	{
+		other._control = nullptr;
+		other._slots = nullptr;
+		other._capacity = 0_z;
+		other._size = 0_z;
+		other._growthLeft = 0_z;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline FlatHashMap<TKey, TValue, THash, TEq>& FlatHashMap<TKey, TValue, THash, TEq>::operator=(const FlatHashMap& other)
+	{
+		if (this != &other)
+		{
+			*this = FlatHashMap(other);
+		}
+
+		return *this;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline FlatHashMap<TKey, TValue, THash, TEq>& FlatHashMap<TKey, TValue, THash, TEq>::operator=(FlatHashMap&& other) noexcept
+	{
+		if (this != &other)
+		{
+			DestroySlots();
+			free(_control);
+			free(_slots);
+
+			_control = other._control;
+			_slots = other._slots;
+			_capacity = other._capacity;
+			_size = other._size;
+			_growthLeft = other._growthLeft;
+			_hashFunctor = std::move(other._hashFunctor);
+			_equalityFunctor = std::move(other._equalityFunctor);
+
+			other._control = nullptr;
+			other._slots = nullptr;
+			other._capacity = 0_z;
+			other._size = 0_z;
+			other._growthLeft = 0_z;
+		}
+
+		return *this;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline FlatHashMap<TKey, TValue, THash, TEq>::~FlatHashMap()
+	{
+		DestroySlots();
+		free(_control);
+		free(_slots);
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline bool FlatHashMap<TKey, TValue, THash, TEq>::IsEmpty() const
+	{
+		return _size == 0_z;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline size_t FlatHashMap<TKey, TValue, THash, TEq>::Size() const
+	{
+		return _size;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline size_t FlatHashMap<TKey, TValue, THash, TEq>::BucketSize() const
+	{
+		return _capacity;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename FlatHashMap<TKey, TValue, THash, TEq>::Iterator FlatHashMap<TKey, TValue, THash, TEq>::Find(const TKey& key)
+	{
+		return Iterator(*this, FindIndex(key));
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename FlatHashMap<TKey, TValue, THash, TEq>::ConstIterator FlatHashMap<TKey, TValue, THash, TEq>::Find(const TKey& key) const
+	{
+		return ConstIterator(*this, FindIndex(key));
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline std::pair<typename FlatHashMap<TKey, TValue, THash, TEq>::Iterator, bool> FlatHashMap<TKey, TValue, THash, TEq>::Insert(const PairType& entry)
+	{
+		const size_t index = FindIndex(entry.first);
+		if (index != _capacity)
+		{
+			return std::make_pair(Iterator(*this, index), false);
+		}
+
+		return std::make_pair(Iterator(*this, InsertNew(_hashFunctor(entry.first), entry)), true);
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename... Args>
+	inline std::pair<typename FlatHashMap<TKey, TValue, THash, TEq>::Iterator, bool> FlatHashMap<TKey, TValue, THash, TEq>::Emplace(Args&&... args)
+	{
+		PairType entry(std::forward<Args>(args)...);
+		const size_t index = FindIndex(entry.first);
+		if (index != _capacity)
+		{
+			return std::make_pair(Iterator(*this, index), false);
+		}
+
+		return std::make_pair(Iterator(*this, InsertNew(_hashFunctor(entry.first), std::move(entry))), true);
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename... Args>
+	inline std::pair<typename FlatHashMap<TKey, TValue, THash, TEq>::Iterator, bool> FlatHashMap<TKey, TValue, THash, TEq>::TryEmplace(const TKey& key, Args&&... args)
+	{
+		return TryEmplaceKey(key, std::forward<Args>(args)...);
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename... Args>
+	inline std::pair<typename FlatHashMap<TKey, TValue, THash, TEq>::Iterator, bool> FlatHashMap<TKey, TValue, THash, TEq>::TryEmplace(TKey&& key, Args&&... args)
+	{
+		return TryEmplaceKey(std::move(key), std::forward<Args>(args)...);
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename TKeyArg, typename... Args>
+	inline std::pair<typename FlatHashMap<TKey, TValue, THash, TEq>::Iterator, bool> FlatHashMap<TKey, TValue, THash, TEq>::TryEmplaceKey(TKeyArg&& key, Args&&... args)
+	{
+		const size_t index = FindIndex(key);
+		if (index != _capacity)
+		{
+			return std::make_pair(Iterator(*this, index), false);
+		}
+
+		const size_t hash = _hashFunctor(key);
+		return std::make_pair(Iterator(*this, InsertNew(hash, std::piecewise_construct, std::forward_as_tuple(std::forward<TKeyArg>(key)), std::forward_as_tuple(std::forward<Args>(args)...))), true);
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline void FlatHashMap<TKey, TValue, THash, TEq>::Remove(const TKey& key)
+	{
+		RemoveIndex(FindIndex(key));
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline void FlatHashMap<TKey, TValue, THash, TEq>::RemoveIndex(size_t index)
+	{
+		if (index != _capacity)
+		{
+			_slots[index].~PairType();
+			--_size;
+
+			// A probe that reaches a group holding an Empty slot stops there, so when this group
+			// already has one the slot can go back to Empty instead of leaving a tombstone.
+			const ControlGroup group(_control + (index & ~(ControlGroup::Width - 1)));
+			if (group.MatchEmpty() != 0)
+			{
+				_control[index] = ControlGroup::Empty;
+				++_growthLeft;
+			}
+			else
+			{
+				_control[index] = ControlGroup::Deleted;
+			}
+		}
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline void FlatHashMap<TKey, TValue, THash, TEq>::Clear()
+	{
+		DestroySlots();
+		if (_capacity > 0_z)
+		{
+			std::memset(_control, ControlGroup::Empty, _capacity);
+		}
+
+		_size = 0_z;
+		_growthLeft = GrowthFor(_capacity);
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline void FlatHashMap<TKey, TValue, THash, TEq>::Resize(size_t size)
+	{
+		if (size == 0)
+		{
+			throw std::runtime_error("FlatHashMap can NOT be resized to a size of ZERO.");
+		}
+
+		Rehash(CapacityFor(std::max(size, _size)));
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline bool FlatHashMap<TKey, TValue, THash, TEq>::ContainsKey(const TKey& key) const
+	{
+		return FindIndex(key) != _capacity;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline TValue& FlatHashMap<TKey, TValue, THash, TEq>::operator[](const TKey& key)
+	{
+		return TryEmplace(key).first->second;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline TValue& FlatHashMap<TKey, TValue, THash, TEq>::At(const TKey& key)
+	{
+		const size_t index = FindIndex(key);
+		if (index == _capacity)
+		{
+			throw std::runtime_error("No Value associated with key passed in to FlatHashMap.At()");
+		}
+		return _slots[index].second;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline const TValue& FlatHashMap<TKey, TValue, THash, TEq>::At(const TKey& key) const
+	{
+		const size_t index = FindIndex(key);
+		if (index == _capacity)
+		{
+			throw std::runtime_error("No Value associated with key passed in to FlatHashMap.At()");
+		}
+		return _slots[index].second;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename TLookup> requires TransparentFunctor<THash> && TransparentFunctor<TEq>
+	inline typename FlatHashMap<TKey, TValue, THash, TEq>::Iterator FlatHashMap<TKey, TValue, THash, TEq>::Find(const TLookup& key)
+	{
+		return Iterator(*this, FindIndex(key));
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename TLookup> requires TransparentFunctor<THash> && TransparentFunctor<TEq>
+	inline typename FlatHashMap<TKey, TValue, THash, TEq>::ConstIterator FlatHashMap<TKey, TValue, THash, TEq>::Find(const TLookup& key) const
+	{
+		return ConstIterator(*this, FindIndex(key));
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename TLookup> requires TransparentFunctor<THash> && TransparentFunctor<TEq>
+	inline bool FlatHashMap<TKey, TValue, THash, TEq>::ContainsKey(const TLookup& key) const
+	{
+		return FindIndex(key) != _capacity;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename TLookup> requires TransparentFunctor<THash> && TransparentFunctor<TEq>
+	inline TValue& FlatHashMap<TKey, TValue, THash, TEq>::At(const TLookup& key)
+	{
+		const size_t index = FindIndex(key);
+		if (index == _capacity)
+		{
+			throw std::runtime_error("No Value associated with key passed in to FlatHashMap.At()");
+		}
+		return _slots[index].second;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename TLookup> requires TransparentFunctor<THash> && TransparentFunctor<TEq>
+	inline const TValue& FlatHashMap<TKey, TValue, THash, TEq>::At(const TLookup& key) const
+	{
+		const size_t index = FindIndex(key);
+		if (index == _capacity)
+		{
+			throw std::runtime_error("No Value associated with key passed in to FlatHashMap.At()");
+		}
+		return _slots[index].second;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename TLookup> requires TransparentFunctor<THash> && TransparentFunctor<TEq>
+	inline void FlatHashMap<TKey, TValue, THash, TEq>::Remove(const TLookup& key)
+	{
+		RemoveIndex(FindIndex(key));
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename FlatHashMap<TKey, TValue, THash, TEq>::Iterator FlatHashMap<TKey, TValue, THash, TEq>::begin()
+	{
+		return Iterator(*this, NextFullIndex(0_z));
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename FlatHashMap<TKey, TValue, THash, TEq>::ConstIterator FlatHashMap<TKey, TValue, THash, TEq>::begin() const
+	{
+		return ConstIterator(*this, NextFullIndex(0_z));
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename FlatHashMap<TKey, TValue, THash, TEq>::ConstIterator FlatHashMap<TKey, TValue, THash, TEq>::cbegin() const
+	{
+		return ConstIterator(*this, NextFullIndex(0_z));
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename FlatHashMap<TKey, TValue, THash, TEq>::Iterator FlatHashMap<TKey, TValue, THash, TEq>::end()
+	{
+		return Iterator(*this, _capacity);
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename FlatHashMap<TKey, TValue, THash, TEq>::ConstIterator FlatHashMap<TKey, TValue, THash, TEq>::end() const
+	{
+		return ConstIterator(*this, _capacity);
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename FlatHashMap<TKey, TValue, THash, TEq>::ConstIterator FlatHashMap<TKey, TValue, THash, TEq>::cend() const
+	{
+		return ConstIterator(*this, _capacity);
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline size_t FlatHashMap<TKey, TValue, THash, TEq>::CapacityFor(size_t size)
+	{
+		size_t capacity = ControlGroup::Width;
+		while (GrowthFor(capacity) < size)
+		{
+			capacity *= 2_z;
+		}
+		return capacity;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline size_t FlatHashMap<TKey, TValue, THash, TEq>::GrowthFor(size_t capacity)
+	{
+		// Keep at least an eighth of the slots free so probe sequences stay short.
+		return capacity - capacity / 8_z;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename FlatHashMap<TKey, TValue, THash, TEq>::ControlByte FlatHashMap<TKey, TValue, THash, TEq>::H2(size_t hash)
+	{
+		return static_cast<ControlByte>(hash & 0x7F);
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename... Args>
+	inline size_t FlatHashMap<TKey, TValue, THash, TEq>::InsertNew(size_t hash, Args&&... args)
+	{
+		if (_growthLeft == 0_z)
+		{
+			// Lots of Deleted slots can use up the growth; clean them up in place before doubling.
+			Rehash(_size < GrowthFor(_capacity) / 2 ? _capacity : CapacityFor(_size + 1));
+		}
+
+		const size_t index = FindInsertIndex(hash);
+		new(_slots + index) PairType(std::forward<Args>(args)...);
+
+		if (_control[index] == ControlGroup::Empty)
+		{
+			--_growthLeft;
+		}
+		_control[index] = H2(hash);
+		++_size;
+
+		return index;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename TLookup>
+	inline size_t FlatHashMap<TKey, TValue, THash, TEq>::FindIndex(const TLookup& key) const
+	{
+		if (_capacity == 0_z)
+		{
+			return _capacity;
+		}
+
+		const size_t hash = _hashFunctor(key);
+		const ControlByte h2 = H2(hash);
+		const size_t groupMask = _capacity / ControlGroup::Width - 1;
+		size_t group = (hash >> 7) & groupMask;
+
+		for (size_t step = 1_z; step <= groupMask + 1; ++step)
+		{
+			const size_t groupStart = group * ControlGroup::Width;
+			const ControlGroup controlGroup(_control + groupStart);
+
+			for (BitMask match = controlGroup.Match(h2); match != 0; match &= match - 1)
+			{
+				const size_t index = groupStart + std::countr_zero(match);
+				if (_equalityFunctor(_slots[index].first, key))
+				{
+					return index;
+				}
+			}
+
+			if (controlGroup.MatchEmpty() != 0)
+			{
+				break;
+			}
+
+			// Triangular probing visits every group when the group count is a power of two.
+			group = (group + step) & groupMask;
+		}
+
+		return _capacity;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline size_t FlatHashMap<TKey, TValue, THash, TEq>::FindInsertIndex(size_t hash) const
+	{
+		const size_t groupMask = _capacity / ControlGroup::Width - 1;
+		size_t group = (hash >> 7) & groupMask;
+
+		for (size_t step = 1_z;; ++step)
+		{
+			const size_t groupStart = group * ControlGroup::Width;
+			const BitMask available = ControlGroup(_control + groupStart).MatchEmptyOrDeleted();
+			if (available != 0)
+			{
+				return groupStart + std::countr_zero(available);
+			}
+
+			group = (group + step) & groupMask;
+		}
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline size_t FlatHashMap<TKey, TValue, THash, TEq>::NextFullIndex(size_t index) const
+	{
+		while (index < _capacity && _control[index] < 0)
+		{
+			++index;
+		}
+		return index;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline void FlatHashMap<TKey, TValue, THash, TEq>::Rehash(size_t capacity)
+	{
+		ControlByte* oldControl = _control;
+		PairType* oldSlots = _slots;
+		const size_t oldCapacity = _capacity;
+
+		_control = static_cast<ControlByte*>(malloc(capacity));
+		_slots = static_cast<PairType*>(malloc(capacity * sizeof(PairType)));
+		_capacity = capacity;
+		assert(_control != nullptr && _slots != nullptr);
+		std::memset(_control, ControlGroup::Empty, _capacity);
+
+		for (size_t i = 0_z; i < oldCapacity; ++i)
+		{
+			if (oldControl[i] >= 0)
+			{
+				const size_t hash = _hashFunctor(oldSlots[i].first);
+				const size_t index = FindInsertIndex(hash);
+				new(_slots + index) PairType(std::move(oldSlots[i]));
+				_control[index] = H2(hash);
+				oldSlots[i].~PairType();
+			}
+		}
+
+		_growthLeft = GrowthFor(_capacity) - _size;
+		free(oldControl);
+		free(oldSlots);
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline void FlatHashMap<TKey, TValue, THash, TEq>::DestroySlots()
+	{
+		for (size_t i = 0_z; i < _capacity; ++i)
+		{
+			if (_control[i] >= 0)
+			{
+				_slots[i].~PairType();
+			}
+		}
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename FlatHashMap<TKey, TValue, THash, TEq>::HashFunctor FlatHashMap<TKey, TValue, THash, TEq>::DefaultHashFunctor()
+	{
+		if constexpr (std::is_constructible_v<HashFunctor, DefaultHash<TKey>>)
+		{
+			return HashFunctor{ DefaultHash<TKey>{} };
+		}
+		else
+		{
+			return HashFunctor{};
+		}
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename FlatHashMap<TKey, TValue, THash, TEq>::EqualityFunctor FlatHashMap<TKey, TValue, THash, TEq>::DefaultEqualityFunctor()
+	{
+		if constexpr (std::is_constructible_v<EqualityFunctor, DefaultEquality<TKey>>)
+		{
+			return EqualityFunctor{ DefaultEquality<TKey>{} };
+		}
+		else
+		{
+			return EqualityFunctor{};
+		}
+	}
+#pragma endregion
+}
@@ -2,9 +2,14 @@
 
 #include <utility>
 #include <functional>
+#include <limits>
+#include <cmath>
+#include <tuple>
+#include <type_traits>
 
 #include "DefaultHash.h"
 #include "DefaultEquality.h"
+#include "DefaultIncrement.h"
 #include "SizeLiteral.h"
 #include "Vector.h"
 #include "SList.h"
@@ -13,19 +18,27 @@ namespace FieaGameEngine
 {
 	/// <summary>
 	/// HashMap is an unordered map storing keys at indexes based on what unsigned int
-	/// they get hashed to. HashFunctor can be passed in but must guarantee that equivalent
-	/// keys will hash to the same result. EqualityFunctor is used to compared the keys and
-	/// can be passed in as well. Size of the vector will be constant throughout.
+	/// they get hashed to. THash must guarantee that equivalent keys will hash to the same
+	/// result and TEq is used to compare the keys. Both are stored by value and called
+	/// directly, so stateless functors cost no space and inline into Find and Insert.
+	/// DynamicHashMap takes them as std::function instead, for functors picked at runtime.
+	/// Insert grows the buckets once the load factor goes over
+	/// MaxLoadFactor, adding as many buckets as the IncrementFunctor returns (doubling by default).
+	/// Growing relinks the existing chain nodes, so pointers to entries stay valid.
+	/// With a rehash step set, growing is spread out instead: the old buckets are kept next to the new
+	/// ones and each Insert or Find moves at most that many of them over, so no single call relinks the whole map.
 	/// </summary>
 	/// <typeparam name="TKey">Key that will be hashed to access map</typeparam>
 	/// <typeparam name="TValue">Value to be stored at key</typeparam>
-	template <typename TKey, typename TValue>
+	/// <typeparam name="THash">Functor hashing a key to a size_t</typeparam>
+	/// <typeparam name="TEq">Functor comparing two keys for equality</typeparam>
+	template <typename TKey, typename TValue, typename THash = DefaultHash<TKey>, typename TEq = DefaultEquality<TKey>>
 	class HashMap final
 	{
 	public:
 		using PairType = std::pair<const TKey, TValue>;
-		using HashFunctor = std::function<size_t(const TKey& key)>;
-		using EqualityFunctor = std::function<bool(const TKey& lhs, const TKey& rhs)>;
+		using HashFunctor = THash;
+		using EqualityFunctor = TEq;
 		using IncrementFunctor = std::function<size_t(size_t size, size_t capacity)>;
 
 	private:
@@ -221,7 +234,7 @@ namespace FieaGameEngine
 		/// <param name="hashFuctor">function to use to hash keys</param>
 		/// <param name="equalityFunctor">function to use to check for key equality</param>
 		/// <exception cref="runtime-error">size cannot be zero</exception>
-		HashMap(size_t size = 11_z, HashFunctor hashFunctor = DefaultHash<TKey>{}, EqualityFunctor equalityFunctor = DefaultEquality<TKey>{});
+		HashMap(size_t size = 11_z, HashFunctor hashFunctor = DefaultHashFunctor(), EqualityFunctor equalityFunctor = DefaultEqualityFunctor());
 		/// <summary>
 		/// Hash Map initializer list constructor with default functors
 		/// </summary>
@@ -304,6 +317,33 @@ namespace FieaGameEngine
 		/// <param name="entry"></param>
 		/// <returns>pair of Iterator where entry was inserted (if inserted) and bool if entry was inserted</returns>
 		std::pair<Iterator, bool> Insert(const PairType& entry);
+		/// <summary>
+		/// Constructs an entry in place from the arguments passed in, as if by PairType(args...), and inserts
+		/// it if its key is not in the hashmap yet. The entry is built in its own chain node, which is linked
+		/// into the bucket without being copied. If the key is already in the hashmap, the new entry is destroyed.
+		/// </summary>
+		/// <param name="args">arguments forwarded to the constructor of PairType</param>
+		/// <returns>pair of Iterator to the entry with that key and bool if the entry was inserted</returns>
+		template <typename... Args>
+		std::pair<Iterator, bool> Emplace(Args&&... args);
+		/// <summary>
+		/// Inserts an entry for key with a value constructed in place from the arguments passed in,
+		/// if key is not in the hashmap yet. Nothing is constructed, copied or moved otherwise.
+		/// </summary>
+		/// <param name="key">key of the entry</param>
+		/// <param name="args">arguments forwarded to the constructor of TValue</param>
+		/// <returns>pair of Iterator to the entry with that key and bool if the entry was inserted</returns>
+		template <typename... Args>
+		std::pair<Iterator, bool> TryEmplace(const TKey& key, Args&&... args);
+		/// <summary>
+		/// Inserts an entry for key with a value constructed in place from the arguments passed in,
+		/// if key is not in the hashmap yet. The key is only moved from if the entry is inserted.
+		/// </summary>
+		/// <param name="key">key of the entry</param>
+		/// <param name="args">arguments forwarded to the constructor of TValue</param>
+		/// <returns>pair of Iterator to the entry with that key and bool if the entry was inserted</returns>
+		template <typename... Args>
+		std::pair<Iterator, bool> TryEmplace(TKey&& key, Args&&... args);
 
 		/// <summary>
 		/// Takes a key argument to remove and returns nothing.
@@ -318,9 +358,71 @@ namespace FieaGameEngine
 		void Clear();
 		/// <summary>
 		/// Resizes Map to a different Bucket Size.
+		/// Entries are relinked into the new buckets without being copied. With a rehash step set, this
+		/// only allocates the new buckets and the entries are relinked by the following Inserts and Finds.
+		/// A Resize during a rehash takes effect once that rehash is done.
 		/// </summary>
 		/// <param name="bucketSize">new size of the buckets</param>
+		/// <exception cref="runtime_error">bucket size cannot be zero</exception>
 		void Resize(size_t bucketSize);
+		/// <summary>
+		/// Grows the buckets so that size entries fit without going over the max load factor.
+		/// Does nothing if the map already has enough buckets.
+		/// </summary>
+		/// <param name="size">number of entries to make room for</param>
+		void Reserve(size_t size);
+
+		/// <summary>
+		/// Average number of entries per bucket.
+		/// </summary>
+		/// <returns>Size divided by BucketSize</returns>
+		float LoadFactor() const;
+		/// <summary>
+		/// Number of entries in the longest chain. Lookups are O(1) as long as this stays small.
+		/// </summary>
+		/// <returns>the size of the fullest bucket</returns>
+		size_t MaxBucketLength() const;
+		/// <summary>
+		/// Load factor that Insert will not go over before growing the buckets.
+		/// </summary>
+		/// <returns>the max load factor of the map</returns>
+		float MaxLoadFactor() const;
+		/// <summary>
+		/// Sets the load factor that Insert will not go over before growing the buckets.
+		/// </summary>
+		/// <param name="maxLoadFactor">new max load factor</param>
+		/// <exception cref="runtime_error">max load factor must be greater than zero</exception>
+		void SetMaxLoadFactor(float maxLoadFactor);
+		/// <summary>
+		/// Sets the functor that decides how many buckets are added when Insert grows the map.
+		/// It is given the size and the bucket size, like the increment functor of Vector.
+		/// </summary>
+		/// <param name="incrementFunctor">functor returning the number of buckets to add</param>
+		void SetIncrementFunctor(IncrementFunctor incrementFunctor);
+		/// <summary>
+		/// Number of old buckets each Insert or Find moves over while a rehash is in progress.
+		/// Zero, the default, means the map is rehashed all at once.
+		/// </summary>
+		/// <returns>the rehash step of the map</returns>
+		size_t RehashStep() const;
+		/// <summary>
+		/// Sets how many old buckets each Insert or Find moves over while a rehash is in progress.
+		/// While rehashing, Find as well as Insert can move entries to other buckets, which invalidates
+		/// iterators but not pointers or references to entries. Insert does not grow the map again until the
+		/// rehash is done, so the load factor can go over the max meanwhile. Setting it to zero finishes any rehash in progress.
+		/// </summary>
+		/// <param name="rehashStep">buckets to move per operation, or zero to rehash all at once</param>
+		void SetRehashStep(size_t rehashStep);
+		/// <summary>
+		/// Is there an incremental rehash in progress?
+		/// </summary>
+		/// <returns>true if some entries are still in the old buckets</returns>
+		bool IsRehashing() const;
+		/// <summary>
+		/// Moves all the entries left in the old buckets over, e.g. during a loading screen, including
+		/// for a Resize that was waiting on the rehash. Does nothing if no rehash is in progress.
+		/// </summary>
+		void FinishRehash();
 
 		/// <summary>
 		/// returns a Boolean indicating the presence of a key within the hash map.
@@ -347,6 +449,50 @@ namespace FieaGameEngine
 		/// <exception cref="runtime_error">thrown if there is no key in container</exception>
 		const TValue& At(const TKey & key) const;
 
+		/// <summary>
+		/// Find with a key of another type, e.g. a string literal or std::string_view for a std::string key.
+		/// Only available when both functors are transparent, so the key is hashed and compared as is
+		/// instead of being converted to a TKey first.
+		/// </summary>
+		/// <param name="key">key to find in hashmap</param>
+		/// <returns>Iterator pointing to index containing key or end if not found</returns>
+		template <typename TLookup> requires TransparentFunctor<THash> && TransparentFunctor<TEq>
+		Iterator Find(const TLookup& key);
+		/// <summary>
+		/// Find with a key of another type. Only available when both functors are transparent.
+		/// </summary>
+		/// <param name="key">key to find in hashmap</param>
+		/// <returns>ConstIterator pointing to index containing key or end if not found</returns>
+		template <typename TLookup> requires TransparentFunctor<THash> && TransparentFunctor<TEq>
+		ConstIterator Find(const TLookup& key) const;
+		/// <summary>
+		/// ContainsKey with a key of another type. Only available when both functors are transparent.
+		/// </summary>
+		/// <param name="key">key to find</param>
+		/// <returns>true if key is within the hash map, false otherwise</returns>
+		template <typename TLookup> requires TransparentFunctor<THash> && TransparentFunctor<TEq>
+		bool ContainsKey(const TLookup& key) const;
+		/// <summary>
+		/// At with a key of another type. Only available when both functors are transparent.
+		/// </summary>
+		/// <returns>reference to the value at the given key</returns>
+		/// <exception cref="runtime_error">thrown if there is no key in container</exception>
+		template <typename TLookup> requires TransparentFunctor<THash> && TransparentFunctor<TEq>
+		TValue& At(const TLookup& key);
+		/// <summary>
+		/// At with a key of another type. Only available when both functors are transparent.
+		/// </summary>
+		/// <returns>constant reference to the value at the given key</returns>
+		/// <exception cref="runtime_error">thrown if there is no key in container</exception>
+		template <typename TLookup> requires TransparentFunctor<THash> && TransparentFunctor<TEq>
+		const TValue& At(const TLookup& key) const;
+		/// <summary>
+		/// Remove with a key of another type. Only available when both functors are transparent.
+		/// </summary>
+		/// <param name="key">key entry to remove from hashmap</param>
+		template <typename TLookup> requires TransparentFunctor<THash> && TransparentFunctor<TEq>
+		void Remove(const TLookup& key);
+
 		/// <summary>
 		/// returns an HashMap::Iterator pointing to the head of the list.
 		/// </summary>
@@ -381,11 +527,48 @@ namespace FieaGameEngine
 		ConstIterator cend() const;
 
 	private:
+		static HashFunctor DefaultHashFunctor();
+		static EqualityFunctor DefaultEqualityFunctor();
+
+		template <typename TLookup>
+		Iterator FindKey(const TLookup& key);
+		template <typename TLookup>
+		Iterator FindKey(const TLookup& key, size_t hash);
+		template <typename TLookup>
+		ConstIterator FindKey(const TLookup& key) const;
+		template <typename TKeyArg, typename... Args>
+		std::pair<Iterator, bool> TryEmplaceKey(TKeyArg&& key, Args&&... args);
+		template <typename TChain, typename TLookup>
+		auto FindInChain(TChain& chain, const TLookup& key) const;
+		size_t GrowForInsert(size_t hash);
+		void StartRehash(size_t bucketSize);
+		void MigrateBuckets(size_t count);
+
+		// Chains are indexed as the new buckets followed by the old ones still being rehashed,
+		// and end() uses an index past any chain so it does not move when the old buckets go away
+		inline static constexpr size_t _endIndex{ std::numeric_limits<size_t>::max() };
+		size_t ChainCount() const;
+		ChainType& ChainAt(size_t index);
+		const ChainType& ChainAt(size_t index) const;
+
 		BucketType _buckets;
+		BucketType _oldBuckets;
+		size_t _migratedBuckets{ 0_z };
+		size_t _pendingBucketSize{ 0_z };
+		size_t _rehashStep{ 0_z };
 		size_t _size{ 0_z };
-		HashFunctor _hashFunctor;
-		EqualityFunctor _equalityFunctor;
+		[[msvc::no_unique_address]] HashFunctor _hashFunctor;
+		[[msvc::no_unique_address]] EqualityFunctor _equalityFunctor;
+		IncrementFunctor _incrementFunctor{ DefaultIncrement{} };
+		float _maxLoadFactor{ 1.0f };
 	};
+
+	/// <summary>
+	/// HashMap calling its hash and equality functors through std::function, so that they
+	/// can be chosen at runtime. Defaults to DefaultHash and DefaultEquality.
+	/// </summary>
+	template <typename TKey, typename TValue>
+	using DynamicHashMap = HashMap<TKey, TValue, std::function<size_t(const TKey& key)>, std::function<bool(const TKey& lhs, const TKey& rhs)>>;
 }
 
 #include "HashMap.inl"
\ No newline at end of file
@@ -6,80 +6,84 @@
 namespace FieaGameEngine
 {
 #pragma region Iterator
-	template<typename TKey, typename TValue>
-	inline HashMap<TKey, TValue>::Iterator::Iterator(HashMap& owner, size_t index, ChainIteratorType chainIt) :
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline HashMap<TKey, TValue, THash, TEq>::Iterator::Iterator(HashMap& owner, size_t index, ChainIteratorType chainIt) :
 		_owner(&owner), _index(index), _chainIt(chainIt)
 	{
 	}
 
-	template<typename TKey, typename TValue>
-	inline typename HashMap<TKey, TValue>::PairType& HashMap<TKey, TValue>::Iterator::operator*() const
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename HashMap<TKey, TValue, THash, TEq>::PairType& HashMap<TKey, TValue, THash, TEq>::Iterator::operator*() const
 	{
 		if (_owner == nullptr)
 		{
 			throw std::runtime_error("Null reference. Is iterator uninitialized?");
 		}
-		if (_index >= _owner->BucketSize())
+		if (_index >= _owner->ChainCount())
 		{
 			throw std::out_of_range("Index out of range. Does this Iterator == end() or is the index >= size of container?");
 		}
 		return *_chainIt;
 	}
 
-	template<typename TKey, typename TValue>
-	inline typename HashMap<TKey, TValue>::PairType* HashMap<TKey, TValue>::Iterator::operator->() const
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename HashMap<TKey, TValue, THash, TEq>::PairType* HashMap<TKey, TValue, THash, TEq>::Iterator::operator->() const
 	{
 		if (_owner == nullptr)
 		{
 			throw std::runtime_error("Null reference. Is iterator uninitialized?");
 		}
-		if (_index >= _owner->BucketSize())
+		if (_index >= _owner->ChainCount())
 		{
 			throw std::out_of_range("Index out of range. Does this Iterator == end() or is the index >= size of container?");
 		}
 		return &(*_chainIt);
 	}
 
-	template<typename TKey, typename TValue>
-	inline bool HashMap<TKey, TValue>::Iterator::operator==(const Iterator& other) const
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline bool HashMap<TKey, TValue, THash, TEq>::Iterator::operator==(const Iterator& other) const
 	{
 		return !(operator!=(other));
 	}
 
-	template<typename TKey, typename TValue>
-	inline bool HashMap<TKey, TValue>::Iterator::operator!=(const Iterator& other) const
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline bool HashMap<TKey, TValue, THash, TEq>::Iterator::operator!=(const Iterator& other) const
 	{
 		return (_owner != other._owner) || (_index != other._index) || (_chainIt != other._chainIt);
 	}
 
-	template<typename TKey, typename TValue>
-	inline typename HashMap<TKey, TValue>::Iterator& HashMap<TKey, TValue>::Iterator::operator++()
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename HashMap<TKey, TValue, THash, TEq>::Iterator& HashMap<TKey, TValue, THash, TEq>::Iterator::operator++()
 	{
 		if (_owner == nullptr)
 		{
 			throw std::runtime_error("Unassociated Iterator.");
 		}
-		if (_index < _owner->BucketSize())
+		if (_index < _owner->ChainCount())
 		{
 			++_chainIt;
-			if (_chainIt == _owner->_buckets[_index].end())
+			if (_chainIt == _owner->ChainAt(_index).end())
 			{
-				while(++_index < _owner->BucketSize())
+				while(++_index < _owner->ChainCount())
 				{
-					if (!_owner->_buckets[_index].IsEmpty())
+					if (!_owner->ChainAt(_index).IsEmpty())
 					{
-						_chainIt = _owner->_buckets[_index].begin();
+						_chainIt = _owner->ChainAt(_index).begin();
 						break;
 					};
 				}
-				if (_index == _owner->BucketSize()) _chainIt = ChainIteratorType{};
+				if (_index == _owner->ChainCount())
+				{
+					_index = _endIndex;
+					_chainIt = ChainIteratorType{};
+				}
 			}
 		}
 		return *this;
 	}
 
-	template<typename TKey, typename TValue>
-	inline typename HashMap<TKey, TValue>::Iterator HashMap<TKey, TValue>::Iterator::operator++(int)
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename HashMap<TKey, TValue, THash, TEq>::Iterator HashMap<TKey, TValue, THash, TEq>::Iterator::operator++(int)
 	{
 		Iterator temp(*this);
 		operator++();
@@ -89,86 +93,90 @@ namespace FieaGameEngine
 #pragma endregion
 
 #pragma region ConstIterator
-	template<typename TKey, typename TValue>
-	inline HashMap<TKey, TValue>::ConstIterator::ConstIterator(const Iterator& other) :
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline HashMap<TKey, TValue, THash, TEq>::ConstIterator::ConstIterator(const Iterator& other) :
 		_owner(other._owner), _index(other._index), _chainIt(other._chainIt)
 	{
 	}
 
-	template<typename TKey, typename TValue>
-	inline HashMap<TKey, TValue>::ConstIterator::ConstIterator(const HashMap& owner, size_t index, ConstChainIteratorType chainIt) :
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline HashMap<TKey, TValue, THash, TEq>::ConstIterator::ConstIterator(const HashMap& owner, size_t index, ConstChainIteratorType chainIt) :
 		_owner(&owner), _index(index), _chainIt(chainIt)
 	{
 	}
 
-	template<typename TKey, typename TValue>
-	inline const typename HashMap<TKey, TValue>::PairType& HashMap<TKey, TValue>::ConstIterator::operator*() const
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline const typename HashMap<TKey, TValue, THash, TEq>::PairType& HashMap<TKey, TValue, THash, TEq>::ConstIterator::operator*() const
 	{
 		if (_owner == nullptr)
 		{
 			throw std::runtime_error("Null reference. Is iterator uninitialized?");
 		}
-		if (_index >= _owner->BucketSize())
+		if (_index >= _owner->ChainCount())
 		{
 			throw std::out_of_range("Index out of range. Does this Iterator == end() or is the index >= size of container?");
 		}
 		return *_chainIt;
 	}
 
-	template<typename TKey, typename TValue>
-	inline const typename HashMap<TKey, TValue>::PairType* HashMap<TKey, TValue>::ConstIterator::operator->() const
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline const typename HashMap<TKey, TValue, THash, TEq>::PairType* HashMap<TKey, TValue, THash, TEq>::ConstIterator::operator->() const
 	{
 		if (_owner == nullptr)
 		{
 			throw std::runtime_error("Null reference. Is iterator uninitialized?");
 		}
-		if (_index >= _owner->BucketSize())
+		if (_index >= _owner->ChainCount())
 		{
 			throw std::out_of_range("Index out of range. Does this Iterator == end() or is the index >= size of container?");
 		}
 		return &(*_chainIt);
 	}
 
-	template<typename TKey, typename TValue>
-	inline bool HashMap<TKey, TValue>::ConstIterator::operator==(const ConstIterator& other) const
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline bool HashMap<TKey, TValue, THash, TEq>::ConstIterator::operator==(const ConstIterator& other) const
 	{
 		return !(operator!=(other));
 	}
 
-	template<typename TKey, typename TValue>
-	inline bool HashMap<TKey, TValue>::ConstIterator::operator!=(const ConstIterator& other) const
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline bool HashMap<TKey, TValue, THash, TEq>::ConstIterator::operator!=(const ConstIterator& other) const
 	{
 		return (_owner != other._owner) || (_index != other._index) || (_chainIt != other._chainIt);
 	}
 
-	template<typename TKey, typename TValue>
-	inline typename HashMap<TKey, TValue>::ConstIterator& HashMap<TKey, TValue>::ConstIterator::operator++()
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename HashMap<TKey, TValue, THash, TEq>::ConstIterator& HashMap<TKey, TValue, THash, TEq>::ConstIterator::operator++()
 	{
 		if (_owner == nullptr)
 		{
 			throw std::runtime_error("Unassociated Iterator.");
 		}
-		if (_index < _owner->BucketSize())
+		if (_index < _owner->ChainCount())
 		{
 			++_chainIt;
-			if (_chainIt == _owner->_buckets[_index].end())
+			if (_chainIt == _owner->ChainAt(_index).end())
 			{
-				while (++_index < _owner->BucketSize())
+				while (++_index < _owner->ChainCount())
 				{
-					if (!_owner->_buckets[_index].IsEmpty())
+					if (!_owner->ChainAt(_index).IsEmpty())
 					{
-						_chainIt = _owner->_buckets[_index].begin();
+						_chainIt = _owner->ChainAt(_index).begin();
 						break;
 					};
 				}
-				if (_index == _owner->BucketSize()) _chainIt = ConstChainIteratorType{};
+				if (_index == _owner->ChainCount())
+				{
+					_index = _endIndex;
+					_chainIt = ConstChainIteratorType{};
+				}
 			}
 		}
 		return *this;
 	}
 
-	template<typename TKey, typename TValue>
-	inline typename HashMap<TKey, TValue>::ConstIterator HashMap<TKey, TValue>::ConstIterator::operator++(int)
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename HashMap<TKey, TValue, THash, TEq>::ConstIterator HashMap<TKey, TValue, THash, TEq>::ConstIterator::operator++(int)
 	{
 		ConstIterator temp(*this);
 		operator++();
@@ -177,8 +185,8 @@ namespace FieaGameEngine
 #pragma endregion
 
 #pragma region HashMap
-	template<typename TKey, typename TValue>
-	inline HashMap<TKey, TValue>::HashMap(size_t size, HashFunctor hashFunctor, EqualityFunctor equalityFunctor) :
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline HashMap<TKey, TValue, THash, TEq>::HashMap(size_t size, HashFunctor hashFunctor, EqualityFunctor equalityFunctor) :
 		_hashFunctor { hashFunctor }, _equalityFunctor{ equalityFunctor }
 	{
 		if (size == 0)
@@ -189,14 +197,14 @@ namespace FieaGameEngine
 		_buckets.Resize(size);
 	}
 
-	template<typename TKey, typename TValue>
-	inline HashMap<TKey, TValue>::HashMap(std::initializer_list<PairType> list) :
-		HashMap{ list, DefaultHash<TKey>(), DefaultEquality<TKey>() }
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline HashMap<TKey, TValue, THash, TEq>::HashMap(std::initializer_list<PairType> list) :
+		HashMap{ list, DefaultHashFunctor(), DefaultEqualityFunctor() }
 	{
 	}
 
-	template<typename TKey, typename TValue>
-	inline HashMap<TKey, TValue>::HashMap(std::initializer_list<PairType> list, HashFunctor hashFunctor, EqualityFunctor equalityFunctor) :
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline HashMap<TKey, TValue, THash, TEq>::HashMap(std::initializer_list<PairType> list, HashFunctor hashFunctor, EqualityFunctor equalityFunctor) :
 		HashMap{ list.size(), hashFunctor, equalityFunctor }
 	{
 		for (const auto& pair : list)
@@ -205,168 +213,427 @@ namespace FieaGameEngine
 		}
 	}
 
-	template<typename TKey, typename TValue>
-	inline HashMap<TKey, TValue>::HashMap(HashMap&& other) noexcept :
-		_buckets{ std::move(other._buckets) }, _size{ std::move(other._size) },
-		_hashFunctor{ std::move(other._hashFunctor) }, _equalityFunctor{ std::move(other._equalityFunctor) }
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline HashMap<TKey, TValue, THash, TEq>::HashMap(HashMap&& other) noexcept :
+		_buckets{ std::move(other._buckets) }, _oldBuckets{ std::move(other._oldBuckets) },
+		_migratedBuckets{ other._migratedBuckets }, _pendingBucketSize{ other._pendingBucketSize }, _rehashStep{ other._rehashStep }, _size{ std::move(other._size) },
+		_hashFunctor{ std::move(other._hashFunctor) }, _equalityFunctor{ std::move(other._equalityFunctor) },
+		_incrementFunctor{ std::move(other._incrementFunctor) }, _maxLoadFactor{ other._maxLoadFactor }
 	{
+		other._migratedBuckets = 0_z;
+		other._pendingBucketSize = 0_z;
 		other._size = 0_z;
 	}
 
-	template<typename TKey, typename TValue>
-	inline HashMap<TKey, TValue>& HashMap<TKey, TValue>::operator=(HashMap&& other) noexcept
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline HashMap<TKey, TValue, THash, TEq>& HashMap<TKey, TValue, THash, TEq>::operator=(HashMap&& other) noexcept
 	{
 		if (this != &other)
 		{
 			_buckets = std::move(other._buckets);
+			_oldBuckets = std::move(other._oldBuckets);
+			_migratedBuckets = other._migratedBuckets;
+			_pendingBucketSize = other._pendingBucketSize;
+			_rehashStep = other._rehashStep;
 			_size = std::move(other._size);
 			_hashFunctor = std::move(other._hashFunctor);
 			_equalityFunctor = std::move(other._equalityFunctor);
+			_incrementFunctor = std::move(other._incrementFunctor);
+			_maxLoadFactor = other._maxLoadFactor;
 
+			other._migratedBuckets = 0_z;
+			other._pendingBucketSize = 0_z;
 			other._size = 0_z;
 		}
 
 		return *this;
 	}
 
-	template<typename TKey, typename TValue>
-	inline bool HashMap<TKey, TValue>::IsEmpty() const
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline bool HashMap<TKey, TValue, THash, TEq>::IsEmpty() const
 	{
 		return _size == 0_z;
 	}
 
-	template<typename TKey, typename TValue>
-	inline size_t HashMap<TKey, TValue>::Size() const
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline size_t HashMap<TKey, TValue, THash, TEq>::Size() const
 	{
 		return _size;
 	}
 	
-	template<typename TKey, typename TValue>
-	inline size_t HashMap<TKey, TValue>::BucketSize() const
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline size_t HashMap<TKey, TValue, THash, TEq>::BucketSize() const
 	{
 		return _buckets.Size();
 	}
 
-	template<typename TKey, typename TValue>
-	inline typename HashMap<TKey, TValue>::Iterator HashMap<TKey, TValue>::Find(const TKey& key)
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename HashMap<TKey, TValue, THash, TEq>::Iterator HashMap<TKey, TValue, THash, TEq>::Find(const TKey& key)
+	{
+		return FindKey(key);
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename HashMap<TKey, TValue, THash, TEq>::ConstIterator HashMap<TKey, TValue, THash, TEq>::Find(const TKey& key) const
+	{
+		return FindKey(key);
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename TLookup>
+	inline typename HashMap<TKey, TValue, THash, TEq>::Iterator HashMap<TKey, TValue, THash, TEq>::FindKey(const TLookup& key)
+	{
+		return FindKey(key, _hashFunctor(key));
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename TLookup>
+	inline typename HashMap<TKey, TValue, THash, TEq>::Iterator HashMap<TKey, TValue, THash, TEq>::FindKey(const TLookup& key, size_t hash)
 	{
-		size_t index = _hashFunctor(key) % BucketSize();
-		ChainType& bucket = _buckets[index];
+		// Rehashing first, so the iterator returned stays valid
+		MigrateBuckets(_rehashStep);
 
-		ChainIteratorType it = bucket.begin();
-		for (; it != bucket.end(); ++it)
+		size_t index = hash % BucketSize();
+		ChainIteratorType it = FindInChain(_buckets[index], key);
+		if (it == _buckets[index].end() && IsRehashing())
 		{
-			if (_equalityFunctor(it->first, key))
-			{
-				break;
-			}
+			index = BucketSize() + hash % _oldBuckets.Size();
+			it = FindInChain(ChainAt(index), key);
 		}
-		if (it == bucket.end())
+		if (it == ChainAt(index).end())
 		{
-			index = BucketSize();
-			it = ChainIteratorType{};
+			return end();
 		}
 		return Iterator(*this, index, it);
 	}
 
-	template<typename TKey, typename TValue>
-	inline typename HashMap<TKey, TValue>::ConstIterator HashMap<TKey, TValue>::Find(const TKey& key) const
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename TLookup>
+	inline typename HashMap<TKey, TValue, THash, TEq>::ConstIterator HashMap<TKey, TValue, THash, TEq>::FindKey(const TLookup& key) const
+	{
+		const size_t hash = _hashFunctor(key);
+		size_t index = hash % BucketSize();
+		ConstChainIteratorType it = FindInChain(_buckets[index], key);
+		if (it == _buckets[index].end() && IsRehashing())
+		{
+			index = BucketSize() + hash % _oldBuckets.Size();
+			it = FindInChain(ChainAt(index), key);
+		}
+		if (it == ChainAt(index).end())
+		{
+			return end();
+		}
+		return ConstIterator(*this, index, it);
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline std::pair<typename HashMap<TKey, TValue, THash, TEq>::Iterator, bool> HashMap<TKey, TValue, THash, TEq>::Insert(const PairType& entry)
+	{
+		const size_t hash = _hashFunctor(entry.first);
+		Iterator it = FindKey(entry.first, hash);
+		if (it != end())
+		{
+			return std::make_pair(it, false);
+		}
+
+		const size_t index = GrowForInsert(hash);
+		ChainIteratorType chainIt = _buckets[index].PushFront(entry);
+		++_size;
+		
+		return std::make_pair(Iterator(*this, index, chainIt), true);
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename... Args>
+	inline std::pair<typename HashMap<TKey, TValue, THash, TEq>::Iterator, bool> HashMap<TKey, TValue, THash, TEq>::Emplace(Args&&... args)
 	{
-		size_t index = _hashFunctor(key) % BucketSize();
-		const ChainType& bucket = _buckets[index];
+		ChainType node;
+		const TKey& key = node.EmplaceFront(std::forward<Args>(args)...)->first;
 
-		ConstChainIteratorType it = bucket.begin();
-		for (; it != bucket.end(); ++it)
+		const size_t hash = _hashFunctor(key);
+		Iterator it = FindKey(key, hash);
+		if (it != end())
+		{
+			return std::make_pair(it, false);
+		}
+
+		const size_t index = GrowForInsert(hash);
+		ChainIteratorType chainIt = _buckets[index].SpliceFront(node);
+		++_size;
+
+		return std::make_pair(Iterator(*this, index, chainIt), true);
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename... Args>
+	inline std::pair<typename HashMap<TKey, TValue, THash, TEq>::Iterator, bool> HashMap<TKey, TValue, THash, TEq>::TryEmplace(const TKey& key, Args&&... args)
+	{
+		return TryEmplaceKey(key, std::forward<Args>(args)...);
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename... Args>
+	inline std::pair<typename HashMap<TKey, TValue, THash, TEq>::Iterator, bool> HashMap<TKey, TValue, THash, TEq>::TryEmplace(TKey&& key, Args&&... args)
+	{
+		return TryEmplaceKey(std::move(key), std::forward<Args>(args)...);
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename TKeyArg, typename... Args>
+	inline std::pair<typename HashMap<TKey, TValue, THash, TEq>::Iterator, bool> HashMap<TKey, TValue, THash, TEq>::TryEmplaceKey(TKeyArg&& key, Args&&... args)
+	{
+		const size_t hash = _hashFunctor(key);
+		Iterator it = FindKey(key, hash);
+		if (it != end())
+		{
+			return std::make_pair(it, false);
+		}
+
+		const size_t index = GrowForInsert(hash);
+		ChainIteratorType chainIt = _buckets[index].EmplaceFront(std::piecewise_construct, std::forward_as_tuple(std::forward<TKeyArg>(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+		++_size;
+
+		return std::make_pair(Iterator(*this, index, chainIt), true);
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename TChain, typename TLookup>
+	inline auto HashMap<TKey, TValue, THash, TEq>::FindInChain(TChain& chain, const TLookup& key) const
+	{
+		auto it = chain.begin();
+		for (; it != chain.end(); ++it)
 		{
 			if (_equalityFunctor(it->first, key))
 			{
 				break;
 			}
 		}
-		if (it == bucket.end())
+		return it;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline size_t HashMap<TKey, TValue, THash, TEq>::GrowForInsert(size_t hash)
+	{
+		// While rehashing the map is allowed over the max load factor, so growing never has to wait on the old buckets
+		if (!IsRehashing() && static_cast<float>(_size + 1_z) > _maxLoadFactor * static_cast<float>(BucketSize()))
 		{
-			index = BucketSize();
-			it = ConstChainIteratorType{};
+			Resize(BucketSize() + std::max(_incrementFunctor(_size, BucketSize()), 1_z));
 		}
-		return ConstIterator(*this, index, it);
+		return hash % BucketSize();
 	}
 
-	template<typename TKey, typename TValue>
-	inline std::pair<typename HashMap<TKey, TValue>::Iterator, bool> HashMap<TKey, TValue>::Insert(const PairType& entry)
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline void HashMap<TKey, TValue, THash, TEq>::StartRehash(size_t bucketSize)
 	{
-		bool wasValueInserted = false;
-		size_t index = _hashFunctor(entry.first) % BucketSize();
-		ChainType& bucket = _buckets[index];
+		BucketType buckets;
+		buckets.Resize(bucketSize);
+
+		_oldBuckets = std::move(_buckets);
+		_buckets = std::move(buckets);
+		_migratedBuckets = 0_z;
+	}
 
-		ChainIteratorType it = bucket.begin();
-		for (; it != bucket.end(); ++it)
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline void HashMap<TKey, TValue, THash, TEq>::MigrateBuckets(size_t count)
+	{
+		if (!IsRehashing())
 		{
-			if (_equalityFunctor(it->first, entry.first))
+			return;
+		}
+
+		const size_t last = std::min(_migratedBuckets + count, _oldBuckets.Size());
+		for (; _migratedBuckets < last; ++_migratedBuckets)
+		{
+			ChainType& bucket = _oldBuckets[_migratedBuckets];
+			while (!bucket.IsEmpty())
 			{
-				break;
+				_buckets[_hashFunctor(bucket.Front().first) % BucketSize()].SpliceFront(bucket);
 			}
 		}
 
-		if (it == bucket.end())
+		if (_migratedBuckets == _oldBuckets.Size())
 		{
-			it = bucket.PushFront(entry);
-			wasValueInserted = true;
-			++_size;
+			_oldBuckets = BucketType{};
+			_migratedBuckets = 0_z;
+
+			if (_pendingBucketSize != 0_z)
+			{
+				const size_t bucketSize = _pendingBucketSize;
+				_pendingBucketSize = 0_z;
+				StartRehash(bucketSize);
+			}
 		}
-		
-		return std::make_pair(Iterator(*this, index, it), wasValueInserted);
 	}
 
-	template<typename TKey, typename TValue>
-	inline void HashMap<TKey, TValue>::Remove(const TKey& key)
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline size_t HashMap<TKey, TValue, THash, TEq>::ChainCount() const
+	{
+		return _buckets.Size() + _oldBuckets.Size();
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename HashMap<TKey, TValue, THash, TEq>::ChainType& HashMap<TKey, TValue, THash, TEq>::ChainAt(size_t index)
+	{
+		return index < _buckets.Size() ? _buckets[index] : _oldBuckets[index - _buckets.Size()];
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline const typename HashMap<TKey, TValue, THash, TEq>::ChainType& HashMap<TKey, TValue, THash, TEq>::ChainAt(size_t index) const
+	{
+		return index < _buckets.Size() ? _buckets[index] : _oldBuckets[index - _buckets.Size()];
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline void HashMap<TKey, TValue, THash, TEq>::Remove(const TKey& key)
 	{
 		Iterator it = Find(key);
 		if (it != end())
 		{
-			_buckets[it._index].Remove(it._chainIt);
+			ChainAt(it._index).Remove(it._chainIt);
 			--_size;
 		}
 	}
 
-	template<typename TKey, typename TValue>
-	inline void HashMap<TKey, TValue>::Clear()
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline void HashMap<TKey, TValue, THash, TEq>::Clear()
 	{
-		for (ChainType& bucket : _buckets)
+		if (_pendingBucketSize != 0_z)
 		{
-			bucket.Clear();
+			BucketType buckets;
+			buckets.Resize(_pendingBucketSize);
+			_buckets = std::move(buckets);
+			_pendingBucketSize = 0_z;
+		}
+		else
+		{
+			for (ChainType& bucket : _buckets)
+			{
+				bucket.Clear();
+			}
 		}
 
+		_oldBuckets = BucketType{};
+		_migratedBuckets = 0_z;
 		_size = 0_z;
 	}
 
-	template<typename TKey, typename TValue>
-	inline void HashMap<TKey, TValue>::Resize(size_t bucketSize)
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline void HashMap<TKey, TValue, THash, TEq>::Resize(size_t bucketSize)
+	{
+		if (bucketSize == 0)
+		{
+			throw std::runtime_error("HashMap can NOT be resized to a size of ZERO.");
+		}
+
+		if (IsRehashing())
+		{
+			// Starts once the rehash in progress is done, so the old buckets keep moving a few at a time
+			_pendingBucketSize = bucketSize;
+			return;
+		}
+
+		StartRehash(bucketSize);
+		if (_rehashStep == 0_z)
+		{
+			FinishRehash();
+		}
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline void HashMap<TKey, TValue, THash, TEq>::Reserve(size_t size)
+	{
+		const size_t bucketSize = static_cast<size_t>(std::ceil(static_cast<float>(size) / _maxLoadFactor));
+		if (bucketSize > BucketSize())
+		{
+			Resize(bucketSize);
+		}
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline float HashMap<TKey, TValue, THash, TEq>::LoadFactor() const
+	{
+		return static_cast<float>(_size) / static_cast<float>(BucketSize());
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline size_t HashMap<TKey, TValue, THash, TEq>::MaxBucketLength() const
+	{
+		size_t maxBucketLength = 0_z;
+		for (size_t i = 0_z; i < ChainCount(); ++i)
+		{
+			maxBucketLength = std::max(maxBucketLength, ChainAt(i).Size());
+		}
+		return maxBucketLength;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline float HashMap<TKey, TValue, THash, TEq>::MaxLoadFactor() const
+	{
+		return _maxLoadFactor;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline void HashMap<TKey, TValue, THash, TEq>::SetMaxLoadFactor(float maxLoadFactor)
 	{
-		HashMap map{ bucketSize, _hashFunctor, _equalityFunctor };
+		if (maxLoadFactor <= 0.0f)
+		{
+			throw std::runtime_error("HashMap max load factor must be greater than ZERO.");
+		}
+		_maxLoadFactor = maxLoadFactor;
+	}
 
-		for (auto& it : *this)
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline void HashMap<TKey, TValue, THash, TEq>::SetIncrementFunctor(IncrementFunctor incrementFunctor)
+	{
+		_incrementFunctor = incrementFunctor;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline size_t HashMap<TKey, TValue, THash, TEq>::RehashStep() const
+	{
+		return _rehashStep;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline void HashMap<TKey, TValue, THash, TEq>::SetRehashStep(size_t rehashStep)
+	{
+		_rehashStep = rehashStep;
+		if (_rehashStep == 0_z)
 		{
-			map.Insert(std::move(it));
+			FinishRehash();
 		}
+	}
 
-		*this = std::move(map);
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline bool HashMap<TKey, TValue, THash, TEq>::IsRehashing() const
+	{
+		return !_oldBuckets.IsEmpty();
 	}
 
-	template<typename TKey, typename TValue>
-	inline bool HashMap<TKey, TValue>::ContainsKey(const TKey& key) const
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline void HashMap<TKey, TValue, THash, TEq>::FinishRehash()
+	{
+		// Finishing the rehash in progress can start a pending one
+		while (IsRehashing())
+		{
+			MigrateBuckets(_oldBuckets.Size());
+		}
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline bool HashMap<TKey, TValue, THash, TEq>::ContainsKey(const TKey& key) const
 	{
 		return Find(key) != end();
 	}
 
-	template<typename TKey, typename TValue>
-	inline TValue& HashMap<TKey, TValue>::operator[](const TKey& key)
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline TValue& HashMap<TKey, TValue, THash, TEq>::operator[](const TKey& key)
 	{
-		auto [it, wasInserted] = Insert(std::make_pair(key, TValue()));
-		return it->second;
+		return TryEmplace(key).first->second;
 	}
 
-	template<typename TKey, typename TValue>
-	inline TValue& HashMap<TKey, TValue>::At(const TKey& key)
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline TValue& HashMap<TKey, TValue, THash, TEq>::At(const TKey& key)
 	{
 		Iterator it = Find(key);
 		if (it == end())
@@ -376,8 +643,8 @@ namespace FieaGameEngine
 		return it->second;
 	}
 
-	template<typename TKey, typename TValue>
-	inline const TValue& HashMap<TKey, TValue>::At(const TKey& key) const
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline const TValue& HashMap<TKey, TValue, THash, TEq>::At(const TKey& key) const
 	{
 		ConstIterator it = Find(key);
 		if (it == end())
@@ -387,12 +654,69 @@ namespace FieaGameEngine
 		return it->second;
 	}
 
-	template<typename TKey, typename TValue>
-	inline typename HashMap<TKey, TValue>::Iterator HashMap<TKey, TValue>::begin()
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename TLookup> requires TransparentFunctor<THash> && TransparentFunctor<TEq>
+	inline typename HashMap<TKey, TValue, THash, TEq>::Iterator HashMap<TKey, TValue, THash, TEq>::Find(const TLookup& key)
+	{
+		return FindKey(key);
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename TLookup> requires TransparentFunctor<THash> && TransparentFunctor<TEq>
+	inline typename HashMap<TKey, TValue, THash, TEq>::ConstIterator HashMap<TKey, TValue, THash, TEq>::Find(const TLookup& key) const
 	{
-		for (size_t i = 0_z; i < BucketSize(); ++i)
+		return FindKey(key);
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename TLookup> requires TransparentFunctor<THash> && TransparentFunctor<TEq>
+	inline bool HashMap<TKey, TValue, THash, TEq>::ContainsKey(const TLookup& key) const
+	{
+		return FindKey(key) != end();
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename TLookup> requires TransparentFunctor<THash> && TransparentFunctor<TEq>
+	inline TValue& HashMap<TKey, TValue, THash, TEq>::At(const TLookup& key)
+	{
+		Iterator it = FindKey(key);
+		if (it == end())
+		{
+			throw std::runtime_error("No Value associated with key passed in to HashMap.At()");
+		}
+		return it->second;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename TLookup> requires TransparentFunctor<THash> && TransparentFunctor<TEq>
+	inline const TValue& HashMap<TKey, TValue, THash, TEq>::At(const TLookup& key) const
+	{
+		ConstIterator it = FindKey(key);
+		if (it == end())
 		{
-			ChainType& bucket = _buckets[i];
+			throw std::runtime_error("No Value associated with key passed in to HashMap.At()");
+		}
+		return it->second;
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	template <typename TLookup> requires TransparentFunctor<THash> && TransparentFunctor<TEq>
+	inline void HashMap<TKey, TValue, THash, TEq>::Remove(const TLookup& key)
+	{
+		Iterator it = FindKey(key);
+		if (it != end())
+		{
+			ChainAt(it._index).Remove(it._chainIt);
+			--_size;
+		}
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename HashMap<TKey, TValue, THash, TEq>::Iterator HashMap<TKey, TValue, THash, TEq>::begin()
+	{
+		for (size_t i = 0_z; i < ChainCount(); ++i)
+		{
+			ChainType& bucket = ChainAt(i);
 			if (!bucket.IsEmpty())
 			{
 				return Iterator(*this, i, bucket.begin());
@@ -401,12 +725,12 @@ namespace FieaGameEngine
 		return end();
 	}
 
-	template<typename TKey, typename TValue>
-	inline typename HashMap<TKey, TValue>::ConstIterator HashMap<TKey, TValue>::begin() const
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename HashMap<TKey, TValue, THash, TEq>::ConstIterator HashMap<TKey, TValue, THash, TEq>::begin() const
 	{
-		for (size_t i = 0_z; i < BucketSize(); ++i)
+		for (size_t i = 0_z; i < ChainCount(); ++i)
 		{
-			const ChainType& bucket = _buckets[i];
+			const ChainType& bucket = ChainAt(i);
 			if (!bucket.IsEmpty())
 			{
 				return ConstIterator(*this, i, bucket.begin());
@@ -415,12 +739,12 @@ namespace FieaGameEngine
 		return end();
 	}
 
-	template<typename TKey, typename TValue>
-	inline typename HashMap<TKey, TValue>::ConstIterator HashMap<TKey, TValue>::cbegin() const
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename HashMap<TKey, TValue, THash, TEq>::ConstIterator HashMap<TKey, TValue, THash, TEq>::cbegin() const
 	{
-		for (size_t i = 0_z; i < BucketSize(); ++i)
+		for (size_t i = 0_z; i < ChainCount(); ++i)
 		{
-			const ChainType& bucket = _buckets[i];
+			const ChainType& bucket = ChainAt(i);
 			if (!bucket.IsEmpty())
 			{
 				return ConstIterator(*this, i, bucket.begin());
@@ -429,22 +753,48 @@ namespace FieaGameEngine
 		return cend();
 	}
 
-	template<typename TKey, typename TValue>
-	inline typename HashMap<TKey, TValue>::Iterator HashMap<TKey, TValue>::end()
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename HashMap<TKey, TValue, THash, TEq>::Iterator HashMap<TKey, TValue, THash, TEq>::end()
 	{
-		return Iterator(*this, BucketSize(), ChainIteratorType{});
+		return Iterator(*this, _endIndex, ChainIteratorType{});
 	}
 
-	template<typename TKey, typename TValue>
-	inline typename HashMap<TKey, TValue>::ConstIterator HashMap<TKey, TValue>::end() const
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename HashMap<TKey, TValue, THash, TEq>::ConstIterator HashMap<TKey, TValue, THash, TEq>::end() const
 	{
-		return ConstIterator(*this, BucketSize(), ConstChainIteratorType{});
+		return ConstIterator(*this, _endIndex, ConstChainIteratorType{});
 	}
 
-	template<typename TKey, typename TValue>
-	inline typename HashMap<TKey, TValue>::ConstIterator HashMap<TKey, TValue>::cend() const
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename HashMap<TKey, TValue, THash, TEq>::ConstIterator HashMap<TKey, TValue, THash, TEq>::cend() const
 	{
-		return ConstIterator(*this, BucketSize(), ConstChainIteratorType{});
+		return ConstIterator(*this, _endIndex, ConstChainIteratorType{});
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename HashMap<TKey, TValue, THash, TEq>::HashFunctor HashMap<TKey, TValue, THash, TEq>::DefaultHashFunctor()
+	{
+		if constexpr (std::is_constructible_v<HashFunctor, DefaultHash<TKey>>)
+		{
+			return HashFunctor{ DefaultHash<TKey>{} };
+		}
+		else
+		{
+			return HashFunctor{};
+		}
+	}
+
+	template<typename TKey, typename TValue, typename THash, typename TEq>
+	inline typename HashMap<TKey, TValue, THash, TEq>::EqualityFunctor HashMap<TKey, TValue, THash, TEq>::DefaultEqualityFunctor()
+	{
+		if constexpr (std::is_constructible_v<EqualityFunctor, DefaultEquality<TKey>>)
+		{
+			return EqualityFunctor{ DefaultEquality<TKey>{} };
+		}
+		else
+		{
+			return EqualityFunctor{};
+		}
 	}
 #pragma endregion
 }
@@ -17,6 +17,7 @@ namespace FieaGameEngine
 	void JsonParseCoordinator::SharedData::Initialize()
 	{
 		_depth = 0;
+		_arraySize = 0;
 	}
 
 	JsonParseCoordinator* JsonParseCoordinator::SharedData::GetJsonParseCoordinator()
@@ -44,6 +45,11 @@ namespace FieaGameEngine
 		return _depth;
 	}
 
+	size_t JsonParseCoordinator::SharedData::ArraySize() const
+	{
+		return _arraySize;
+	}
+
 	void JsonParseCoordinator::SharedData::SetJsonParseCoordinator(JsonParseCoordinator* coordinator)
 	{
 		_coordinator = coordinator;
@@ -227,10 +233,13 @@ namespace FieaGameEngine
 	{
 		if (isArray)
 		{
+			const size_t outerArraySize = _sharedData->_arraySize;
+			_sharedData->_arraySize = val.size();
 			for (Json::ArrayIndex i = 0; i < val.size(); ++i)
 			{
 				ParseHandlerHelper(key, val[i], isArray, i);
 			}
+			_sharedData->_arraySize = outerArraySize;
 		}
 		else
 		{
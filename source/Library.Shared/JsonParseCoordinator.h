@@ -54,6 +54,12 @@ namespace FieaGameEngine
 			/// </summary>
 			/// <returns>Current nesting depth.</returns>
 			std::uint32_t Depth() const;
+			/// <summary>
+			/// Returns the number of elements of the array being parsed. Only meaningful while
+			/// handling an array element, helpers can use it to reserve once for the whole array.
+			/// </summary>
+			/// <returns>Number of elements in the current array.</returns>
+			size_t ArraySize() const;
 
 		private:
 			void SetJsonParseCoordinator(JsonParseCoordinator* coordinator);
@@ -63,6 +69,7 @@ namespace FieaGameEngine
 
 			JsonParseCoordinator* _coordinator{ nullptr };
 			std::uint32_t _depth{ 0 };
+			size_t _arraySize{ 0 };
 		};
 
 		explicit JsonParseCoordinator() = default;
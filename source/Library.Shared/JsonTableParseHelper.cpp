@@ -71,7 +71,7 @@ namespace FieaGameEngine
 			assert(_contextStack.Size() > 0_z);
 			if (!value.isString()) throw std::runtime_error("Type must be a string");
 			StackFrame& stackFrame = _contextStack.Top();
-			Datum* datum = stackFrame.Context->Search(stackFrame.Key);
+			Datum* datum = stackFrame.Context->Search(stackFrame.KeySymbol);
 			assert(datum != nullptr);
 			datum->SetType(Datum::DatumTypeMap.At(value.asString()));
 			stackFrame.Type = Datum::DatumTypeMap.At(value.asString());
@@ -91,17 +91,30 @@ namespace FieaGameEngine
 			if (stackFrame.Type == Datum::DatumType::Table)
 			{
 				if (!isArray) {
-					const string& className = stackFrame.ClassName.empty() ? "Scope" : stackFrame.ClassName;
-					Scope* nestedScope = Factory<Scope>::Create(className);
-					assert(nestedScope != nullptr);
-					stackFrame.Context->Adopt(*nestedScope, stackFrame.Key);
+					Scope* nestedScope;
+					if (stackFrame.ClassName.empty())
+					{
+						// Plain Scopes are appended directly so they come from the context's arena, if it has one
+						nestedScope = &stackFrame.Context->AppendScope(stackFrame.KeySymbol);
+					}
+					else
+					{
+						nestedScope = Factory<Scope>::Create(stackFrame.ClassName);
+						assert(nestedScope != nullptr);
+						stackFrame.Context->Adopt(*nestedScope, stackFrame.KeySymbol);
+					}
 					_contextStack.Push({ key, Datum::DatumType::Table, nestedScope });
 				}
 			}
 			else
 			{
-				Datum& datum = stackFrame.Context->Append(stackFrame.Key);
-				
+				Datum& datum = stackFrame.Context->Append(stackFrame.KeySymbol);
+				if (isArray && index == 0_z && !datum.IsExternal())
+				{
+					// One allocation for the whole array instead of one per growth
+					datum.Reserve(datum.Size() + sharedData.ArraySize());
+				}
+
 				switch (stackFrame.Type)
 				{
 					case Datum::DatumType::Integer:
@@ -115,9 +128,26 @@ namespace FieaGameEngine
 						break;
 
 					default:
-						if (datum.IsExternal()) datum.SetFromString(value.asString(), index);
-						else datum.PushBackFromString(value.asString());
+					{
+						// Parse straight out of the JSON value, strings are only built for non-string values
+						const char* begin;
+						const char* end;
+						std::string converted;
+						std::string_view text;
+						if (value.getString(&begin, &end))
+						{
+							text = std::string_view(begin, static_cast<size_t>(end - begin));
+						}
+						else
+						{
+							converted = value.asString();
+							text = converted;
+						}
+
+						if (datum.IsExternal()) datum.FromChars(text, index);
+						else datum.PushBackFromChars(text);
 						break;
+					}
 				}
 			}
 		}
@@ -16,10 +16,11 @@ namespace FieaGameEngine
 
 		struct StackFrame
 		{
-			StackFrame(const std::string& key, Datum::DatumType type, Scope* context) : Key(key), Type(type), Context(context) { };
-			StackFrame(const std::string& key, Scope* context) : Key(key), Context(context) { };
+			StackFrame(const std::string& key, Datum::DatumType type, Scope* context) : Key(key), KeySymbol(key), Type(type), Context(context) { };
+			StackFrame(const std::string& key, Scope* context) : Key(key), KeySymbol(key), Context(context) { };
 
 			const std::string& Key;
+			Symbol KeySymbol;
 			Datum::DatumType Type = Datum::DatumType::Unknown;
 			std::string ClassName;
 			Scope* Context = nullptr;
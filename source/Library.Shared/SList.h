@@ -1,5 +1,7 @@
 #pragma once
 
+#include <utility>
+
 #include "DefaultEquality.h"
 #include "SizeLiteral.h"
 
@@ -28,6 +30,13 @@ namespace FieaGameEngine
 			/// <param name="data">rvalue data to place in node</param>
 			/// <param name="next">node to point to as next</param>
 			Node(T&& data, Node* next = nullptr);
+			/// <summary>
+			/// Creates Node element constructing its data in place from the arguments passed in
+			/// </summary>
+			/// <param name="next">node to point to as next</param>
+			/// <param name="args">arguments forwarded to the constructor of T</param>
+			template<typename... Args>
+			Node(std::in_place_t, Node* next, Args&&... args);
 
 			T _data;
 			Node* _next;
@@ -258,6 +267,20 @@ namespace FieaGameEngine
 		/// <param name="value">rvalue data</param>
 		/// <returns>Iterator pointint to pushed element</returns>
 		Iterator PushBack(T&& value);
+		/// <summary>
+		/// Constructs an element in place at the front of the linked list
+		/// </summary>
+		/// <param name="args">arguments forwarded to the constructor of T</param>
+		/// <returns>Iterator pointing to the new element</returns>
+		template<typename... Args>
+		Iterator EmplaceFront(Args&&... args);
+		/// <summary>
+		/// Constructs an element in place at the back of the linked list
+		/// </summary>
+		/// <param name="args">arguments forwarded to the constructor of T</param>
+		/// <returns>Iterator pointing to the new element</returns>
+		template<typename... Args>
+		Iterator EmplaceBack(Args&&... args);
 
 		/// <summary>
 		/// deletes the first (front) element of the linked list, will do nothing if empty
@@ -358,6 +381,14 @@ namespace FieaGameEngine
 		/// <returns>new iterator thats inserted after the given iterator</returns>
 		/// <exception cref="runtime_error">throws exception if given iterator is not owned by list to insert rvalue to</exception>
 		Iterator InsertAfter(const Iterator& it, T&& value);
+		/// <summary>
+		/// Moves the front node of the other list to the front of this list.
+		/// The element is neither copied nor moved, so pointers to it stay valid.
+		/// </summary>
+		/// <param name="other">list to take the front node from</param>
+		/// <returns>iterator pointing to the spliced element in this list</returns>
+		/// <exception cref="runtime_error">throws exception if other list is empty</exception>
+		Iterator SpliceFront(SList& other);
 
 		/// <summary>
 		/// Finds and returns first iterator pointing to item passed in, if not found it returns end.
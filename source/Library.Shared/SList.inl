@@ -149,6 +149,13 @@ namespace FieaGameEngine
 	{
 	}
 
+	template<typename T>
+	template<typename... Args>
+	inline SList<T>::Node::Node(std::in_place_t, Node* next, Args&&... args) :
+		_data(std::forward<Args>(args)...), _next(next)
+	{
+	}
+
 	template<typename T>
 	inline SList<T>::SList(const SList& other)
 	{
@@ -262,6 +269,37 @@ namespace FieaGameEngine
 		return Iterator(*this, newNode);
 	}
 
+	template<typename T>
+	template<typename... Args>
+	inline typename SList<T>::Iterator SList<T>::EmplaceFront(Args&&... args)
+	{
+		_front = new Node(std::in_place, _front, std::forward<Args>(args)...);
+		if (_size == 0_z)
+		{
+			_back = _front;
+		}
+		++_size;
+		return Iterator(*this, _front);
+	}
+
+	template<typename T>
+	template<typename... Args>
+	inline typename SList<T>::Iterator SList<T>::EmplaceBack(Args&&... args)
+	{
+		Node* newNode = new Node(std::in_place, nullptr, std::forward<Args>(args)...);
+		if (IsEmpty())
+		{
+			_front = newNode;
+		}
+		else
+		{
+			_back->_next = newNode;
+		}
+		_back = newNode;
+		++_size;
+		return Iterator(*this, newNode);
+	}
+
 	template<typename T>
 	inline void SList<T>::PopFront()
 	{
@@ -440,6 +478,32 @@ namespace FieaGameEngine
 		return itToReturn;
 	}
 
+	template<typename T>
+	inline typename SList<T>::Iterator SList<T>::SpliceFront(SList& other)
+	{
+		if (other.IsEmpty())
+		{
+			throw std::runtime_error("Cannot splice from an empty SList.");
+		}
+
+		Node* node = other._front;
+		other._front = node->_next;
+		if (--other._size == 0_z)
+		{
+			other._back = nullptr;
+		}
+
+		node->_next = _front;
+		_front = node;
+		if (_size == 0_z)
+		{
+			_back = node;
+		}
+		++_size;
+
+		return Iterator(*this, node);
+	}
+
 	template<typename T>
 	template<typename EqualityFunctor>
 	inline typename SList<T>::Iterator SList<T>::Find(const T& value, EqualityFunctor equalityFunctor)
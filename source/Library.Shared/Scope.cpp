@@ -1,6 +1,7 @@
 #include "pch.h"
 
 #include "Scope.h"
+#include "ThreadPool.h"
 
 using namespace glm;
 using namespace std;
@@ -10,7 +11,12 @@ namespace FieaGameEngine
 	RTTI_DEFINITIONS(Scope);
 
 	Scope::Scope(size_t size) :
-		_orderVector{size}
+		_table{ size }
+	{
+	}
+
+	Scope::Scope(Arena& arena, size_t size) :
+		_table{ size, &arena }, _arena{ &arena }
 	{
 	}
 
@@ -20,7 +26,7 @@ namespace FieaGameEngine
 	}
 
 	Scope::Scope(Scope&& other) noexcept :
-		_parent{ other._parent }, _map{ std::move(other._map) }, _orderVector{ std::move(other._orderVector) }
+		_parent{ other._parent }, _table{ std::move(other._table) }, _arena{ other._arena }
 	{
 		Reparent(std::move(other));
 	}
@@ -42,8 +48,8 @@ namespace FieaGameEngine
 			Scope::Clear();
 			
 			_parent = other._parent;
-			_map = std::move(other._map);
-			_orderVector = std::move(other._orderVector);
+			_table = std::move(other._table);
+			_arena = other._arena;
 
 			Reparent(std::move(other));
 		}
@@ -58,30 +64,41 @@ namespace FieaGameEngine
 
 	void Scope::DeepCopy(const Scope& other)
 	{
-		_orderVector.Reserve(other._orderVector.Size());
+		Vector<DeferredCopy>* deferredCopies = std::exchange(_deferredCopies, nullptr);
+		_table.Reserve(other._table.Size());
 
-		for (const auto& pair : other._orderVector)
+		for (const auto& pair : other._table)
 		{
-			Datum& existingDatum = pair->second;
-			Datum& newDatum = Append(pair->first);
+			const Datum& existingDatum = pair.second;
+			Datum& newDatum = Append(pair.first);
 			
 			if (existingDatum.Type() == Datum::DatumType::Table)
 			{
 				assert(!existingDatum.IsExternal());
 				newDatum.SetType(Datum::DatumType::Table);
-				newDatum.Reserve(existingDatum.Size());
 
+				if (deferredCopies != nullptr)
+				{
+					// No slot is added until CloneParallel has the copy, so the Datum never holds an empty one
+					for (size_t datumIndex = 0; datumIndex < existingDatum.Size(); ++datumIndex)
+					{
+						deferredCopies->PushBack(DeferredCopy{ &newDatum, &existingDatum.GetScope(datumIndex), nullptr });
+					}
+					continue;
+				}
+
+				newDatum.Reserve(existingDatum.Size());
 				for (size_t datumIndex = 0; datumIndex < existingDatum.Size(); ++datumIndex)
 				{
-					Scope& existingScope = existingDatum.GetScope(datumIndex);
-					Scope* scope = existingScope.Clone();
-					scope->_parent = this;
-					newDatum.PushBack(*scope);
+					const Scope& existingScope = existingDatum.GetScope(datumIndex);
+					Scope* scope = CreateNestedScope(&existingScope);
+					AttachChild(*scope, newDatum);
 				}
 			}
 			else
 			{
-				newDatum = existingDatum;
+				// Copies read the prototype's values until they change them
+				newDatum.Share(existingDatum);
 			}
 		}
 	}
@@ -91,17 +108,18 @@ namespace FieaGameEngine
 	{
 		if (this != &other)
 		{
-			if (_orderVector.Size() != other._orderVector.Size())
+			if (_table.Size() != other._table.Size())
 			{
 				return false;
 			}
 
-			for (size_t i = 0_z; i < _orderVector.Size(); ++i)
+			auto rhsIt = other._table.begin();
+			for (auto lhsIt = _table.begin(); lhsIt != _table.end(); ++lhsIt, ++rhsIt)
 			{
-				auto& lhsPair = *_orderVector[i];
-				auto& rhsPair = *other._orderVector[i];
+				auto& lhsPair = *lhsIt;
+				auto& rhsPair = *rhsIt;
 
-				if (lhsPair.first == "this"s)
+				if (lhsPair.first == _thisSymbol)
 				{
 					continue;
 				}
@@ -122,27 +140,40 @@ namespace FieaGameEngine
 
 	Datum& Scope::operator[](size_t index)
 	{
-		return _orderVector[index]->second;
+		if (index >= _table.Size())
+		{
+			throw std::out_of_range("Index out of range.");
+		}
+		return _table[index].second;
 	}
 
 	const Datum& Scope::operator[](size_t index) const
 	{
-		return _orderVector[index]->second;
+		if (index >= _table.Size())
+		{
+			throw std::out_of_range("Index out of range.");
+		}
+		return _table[index].second;
+	}
+
+	Datum& Scope::operator[](std::string_view name)
+	{
+		return Append(name);
 	}
 
-	Datum& Scope::operator[](const std::string& name)
+	Datum& Scope::operator[](const Symbol& name)
 	{
 		return Append(name);
 	}
 
 	size_t Scope::Size() const
 	{
-		return _orderVector.Size();
+		return _table.Size();
 	}
 
 	bool Scope::IsEmpty() const
 	{
-		return _orderVector.Size() == 0;
+		return _table.IsEmpty();
 	}
 
 	void Scope::Clear()
@@ -158,12 +189,13 @@ namespace FieaGameEngine
 			UNREFERENCED(parent);
 #endif // NDEBUG
 			scope._parent = nullptr;
-			delete &scope;
+			scope._parentDatum = nullptr;
+			DestroyNestedScope(scope);
 			return false;
 		});
 
-		_map.Clear();
-		_orderVector.Clear();
+		_table.Clear();
+		_generation = NextGeneration();
 	}
 
 	Scope* Scope::GetParent()
@@ -176,30 +208,51 @@ namespace FieaGameEngine
 		return _parent;
 	}
 
-	Datum& Scope::Append(const std::string& name)
+	Arena* Scope::GetArena() const
+	{
+		return _arena;
+	}
+
+	Datum& Scope::Append(std::string_view name)
+	{
+		bool entryCreated;
+		return Append(name, entryCreated);
+	}
+
+	Datum& Scope::Append(std::string_view name, bool& entryCreated)
+	{
+		return Append(Symbol(name), entryCreated);
+	}
+
+	Datum& Scope::Append(const Symbol& name)
 	{
 		bool entryCreated;
 		return Append(name, entryCreated);
 	}
 
-	Datum& Scope::Append(const std::string& name, bool& entryCreated)
+	Datum& Scope::Append(const Symbol& name, bool& entryCreated)
 	{
-		if (name.empty())
+		if (name.IsEmpty())
 		{
 			throw std::invalid_argument("Cannot Append an empty string name into Scope");
 		}
 
-		auto [it, wasInserted] = _map.Insert(std::make_pair(name, Datum()));
+		auto [entry, wasInserted] = _table.Insert(name);
 		entryCreated = wasInserted;
 
 		if (entryCreated)
 		{
-			_orderVector.PushBack(&*it);
+			_generation = NextGeneration();
 		}
-		return it->second;
+		return entry->second;
 	}
 
-	Scope& Scope::AppendScope(const std::string& name)
+	Scope& Scope::AppendScope(std::string_view name)
+	{
+		return AppendScope(Symbol(name));
+	}
+
+	Scope& Scope::AppendScope(const Symbol& name)
 	{
 		bool entryCreated;
 		Datum& datum = Append(name, entryCreated);
@@ -214,63 +267,95 @@ namespace FieaGameEngine
 			assert(!datum._isExternal);
 		}
 
-		Scope* scope = new Scope;
-		scope->_parent = this;
-		datum.PushBack(*scope);
+		Scope* scope = CreateNestedScope(nullptr);
+		AttachChild(*scope, datum);
 
 		return *scope;
 	}
 
 	const std::pair<Datum*, size_t> Scope::FindContainedScope(const Scope& scope) const
 	{
-		Datum* foundDatum = nullptr;
-		size_t foundIndex = numeric_limits<size_t>::max();
-
-		ForEachNestedScopeIn([&scope, &foundDatum, &foundIndex](const Scope&, Datum& datum, size_t datumIndex)
+		if (scope._parent != this)
 		{
-			if (&datum.GetScope(datumIndex) == &scope)
-			{
-				foundDatum = &datum;
-				foundIndex = datumIndex;
-				return true;
-			}
-			return false;
-		});
+			return std::make_pair(nullptr, numeric_limits<size_t>::max());
+		}
+		return scope.ParentSlot();
+	}
 
-		return std::make_pair(foundDatum, foundIndex);
+	Datum* Scope::Find(std::string_view name)
+	{
+		const Datum* datum = const_cast<const Scope&>(*this).Find(name);
+		return const_cast<Datum*>(datum);
+	}
+
+	const Datum* Scope::Find(std::string_view name) const
+	{
+		// A name that was never interned cannot be a key of any Scope
+		const std::uintptr_t id = SymbolTable::FindId(name);
+		const PairType* entry = id != 0 ? _table.FindId(id) : nullptr;
+		return entry != nullptr ? &entry->second : nullptr;
 	}
 
-	Datum* Scope::Find(const std::string& name)
+	Datum* Scope::Find(const Symbol& name)
 	{
 		const Datum* datum = const_cast<const Scope&>(*this).Find(name);
 		return const_cast<Datum*>(datum);
 	}
 
-	const Datum* Scope::Find(const std::string& name) const
+	const Datum* Scope::Find(const Symbol& name) const
+	{
+		const PairType* entry = _table.Find(name);
+		return entry != nullptr ? &entry->second : nullptr;
+	}
+
+	Datum* Scope::Search(std::string_view name)
+	{
+		Scope* found;
+		return Search(name, found);
+	}
+
+	const Datum* Scope::Search(std::string_view name) const
+	{
+		const Scope* found;
+		return Search(name, found);
+	}
+
+	Datum* Scope::Search(std::string_view name, Scope*& foundScope)
+	{
+		const Datum* datum = const_cast<const Scope&>(*this).Search(name, const_cast<const Scope*&>(foundScope));
+		return const_cast<Datum*>(datum);
+	}
+
+	const Datum* Scope::Search(std::string_view name, const Scope*& foundScope) const
 	{
-		auto it = _map.Find(name);
-		return it != _map.end() ? &it->second : nullptr;
+		const std::uintptr_t id = SymbolTable::FindId(name);
+		if (id == 0)
+		{
+			foundScope = nullptr;
+			return nullptr;
+		}
+		return SearchId(id, foundScope);
 	}
 
-	Datum* Scope::Search(const std::string& name)
+	Datum* Scope::Search(const Symbol& name)
 	{
 		Scope* found;
 		return Search(name, found);
 	}
 
-	const Datum* Scope::Search(const std::string& name) const
+	const Datum* Scope::Search(const Symbol& name) const
 	{
 		const Scope* found;
 		return Search(name, found);
 	}
 
-	Datum* Scope::Search(const std::string& name, Scope*& foundScope)
+	Datum* Scope::Search(const Symbol& name, Scope*& foundScope)
 	{
 		const Datum* datum = const_cast<const Scope&>(*this).Search(name, const_cast<const Scope*&>(foundScope));
 		return const_cast<Datum*>(datum);
 	}
 
-	const Datum* Scope::Search(const std::string& name, const Scope*& foundScope) const
+	const Datum* Scope::Search(const Symbol& name, const Scope*& foundScope) const
 	{
 		const Datum* datum = Find(name);
 		foundScope = this;
@@ -285,21 +370,55 @@ namespace FieaGameEngine
 		return datum;
 	}
 
-	Datum& Scope::At(const std::string& name)
+	const Datum* Scope::SearchId(std::uintptr_t id, const Scope*& foundScope) const
+	{
+		for (const Scope* scope = this; scope != nullptr; scope = scope->_parent)
+		{
+			const PairType* entry = scope->_table.FindId(id);
+			if (entry != nullptr)
+			{
+				foundScope = scope;
+				return &entry->second;
+			}
+		}
+		foundScope = nullptr;
+		return nullptr;
+	}
+
+	Datum& Scope::At(std::string_view name)
+	{
+		Datum* datum = Find(name);
+		assert(datum != nullptr);
+		return *datum;
+	}
+
+	const Datum& Scope::At(std::string_view name) const
+	{
+		const Datum* datum = Find(name);
+		assert(datum != nullptr);
+		return *datum;
+	}
+
+	Datum& Scope::At(const Symbol& name)
 	{
 		Datum* datum = Find(name);
 		assert(datum != nullptr);
 		return *datum;
 	}
 
-	const Datum& Scope::At(const std::string& name) const
+	const Datum& Scope::At(const Symbol& name) const
 	{
 		const Datum* datum = Find(name);
 		assert(datum != nullptr);
 		return *datum;
 	}
 
-	void Scope::Adopt(Scope& scope, const std::string& name)
+	void Scope::Adopt(Scope& scope, std::string_view name)
+	{
+		Adopt(scope, Symbol(name));
+	}
+
+	void Scope::Adopt(Scope& scope, const Symbol& name)
 	{
 		if (this == &scope)
 		{
@@ -324,18 +443,29 @@ namespace FieaGameEngine
 		}
 
 		scope.Orphan();
-		datum.PushBack(scope);
-		scope._parent = this;
+		AttachChild(scope, datum);
 	}
 
 	void Scope::Orphan()
 	{
 		if (_parent != nullptr)
 		{
-			auto [datum, index] = _parent->FindContainedScope(*this);
+			auto [datum, index] = ParentSlot();
 			assert(datum != nullptr);
-			datum->RemoveAt(index);
+
+			// The last sibling takes over the slot, so it is the only back-reference to fix
+			const size_t last = datum->Size() - 1_z;
+			if (index != last)
+			{
+				Scope& sibling = datum->GetScope(last);
+				sibling._parentDatum = datum;
+				sibling._parentIndex = index;
+			}
+			datum->RemoveAtSwap(index);
+
 			_parent = nullptr;
+			_parentDatum = nullptr;
+			_generation = NextGeneration();
 		}
 	}
 
@@ -379,16 +509,158 @@ namespace FieaGameEngine
 		return scope.IsAncestorOf(*this);
 	}
 
+	gsl::owner<Scope*> Scope::CloneParallel(ThreadPool& pool) const
+	{
+		Vector<DeferredCopy> deferredCopies;
+		_deferredCopies = &deferredCopies;
+		gsl::owner<Scope*> clone;
+		try
+		{
+			clone = Clone();
+		}
+		catch (...)
+		{
+			_deferredCopies = nullptr;
+			throw;
+		}
+		_deferredCopies = nullptr;
+
+		try
+		{
+			pool.ParallelFor(deferredCopies.Size(), [&deferredCopies](size_t index)
+			{
+				DeferredCopy& deferredCopy = deferredCopies[index];
+				deferredCopy.Copy = deferredCopy.Prototype->Clone();
+			});
+		}
+		catch (...)
+		{
+			// None of the copies were attached yet, so they are destroyed on their own
+			for (DeferredCopy& deferredCopy : deferredCopies)
+			{
+				delete deferredCopy.Copy;
+			}
+			delete clone;
+			throw;
+		}
+
+		// Attached in the order DeepCopy found them, so every child keeps its index
+		for (DeferredCopy& deferredCopy : deferredCopies)
+		{
+			clone->AttachChild(*deferredCopy.Copy, *deferredCopy.Target);
+		}
+		return clone;
+	}
+
+	bool Scope::EqualsParallel(const Scope& other, ThreadPool& pool) const
+	{
+		if (this == &other)
+		{
+			return true;
+		}
+		if (_table.Size() != other._table.Size())
+		{
+			return false;
+		}
+
+		// Entries are compared here as in operator==, the nested Scopes are collected for the pool
+		Vector<std::pair<const Scope*, const Scope*>> nestedScopes;
+		auto rhsIt = other._table.begin();
+		for (auto lhsIt = _table.begin(); lhsIt != _table.end(); ++lhsIt, ++rhsIt)
+		{
+			const auto& [lhsName, lhsDatum] = *lhsIt;
+			const auto& [rhsName, rhsDatum] = *rhsIt;
+
+			if (lhsName == _thisSymbol)
+			{
+				continue;
+			}
+			if (lhsName != rhsName)
+			{
+				return false;
+			}
+
+			if (lhsDatum.Type() == Datum::DatumType::Table && rhsDatum.Type() == Datum::DatumType::Table && lhsDatum.Size() == rhsDatum.Size())
+			{
+				for (size_t datumIndex = 0_z; datumIndex < lhsDatum.Size(); ++datumIndex)
+				{
+					nestedScopes.PushBack(std::make_pair(&lhsDatum.GetScope(datumIndex), &rhsDatum.GetScope(datumIndex)));
+				}
+			}
+			else if (lhsDatum != rhsDatum)
+			{
+				return false;
+			}
+		}
+
+		std::atomic<bool> areEqual{ true };
+		pool.ParallelFor(nestedScopes.Size(), [&nestedScopes, &areEqual](size_t index)
+		{
+			const auto [lhs, rhs] = nestedScopes[index];
+			if (areEqual.load(std::memory_order_relaxed) && lhs != rhs && !lhs->Equals(rhs))
+			{
+				areEqual.store(false, std::memory_order_relaxed);
+			}
+		});
+		return areEqual.load();
+	}
+
+	void Scope::ClearParallel(ThreadPool& pool)
+	{
+		Orphan();
+
+		// Detached up front, so tearing a child down never reaches back into this Scope
+		Vector<Scope*> nestedScopes;
+		ForEachNestedScopeIn([&nestedScopes](const Scope& parent, Datum& datum, size_t datumIndex)
+		{
+			Scope& scope = datum[datumIndex];
+			assert(scope._parent == &parent);
+
+#ifdef NDEBUG
+			UNREFERENCED(parent);
+#endif // NDEBUG
+			scope._parent = nullptr;
+			scope._parentDatum = nullptr;
+			nestedScopes.PushBack(&scope);
+			return false;
+		});
+
+		pool.ParallelFor(nestedScopes.Size(), [&nestedScopes](size_t index)
+		{
+			DestroyNestedScope(*nestedScopes[index]);
+		});
+
+		_table.Clear();
+		_generation = NextGeneration();
+	}
+
+	std::uint64_t Scope::Generation() const
+	{
+		return _generation;
+	}
+
+	std::uint64_t Scope::NextGeneration()
+	{
+		return ++_lastGeneration;
+	}
+
 	void Scope::Reparent(Scope&& other)
 	{
+		// Both Scopes and the children that move over change, nothing else does
+		_generation = NextGeneration();
+		other._generation = NextGeneration();
+
 		if (other._parent != nullptr)
 		{
 			// Move prev parent's Scope reference to "this"
-			auto [datum, datumIndex] = other._parent->FindContainedScope(other);
+			auto [datum, datumIndex] = other.ParentSlot();
 			assert(datum != nullptr);
 
 			datum->Set(*this, datumIndex);
+			_parentDatum = datum;
+			_parentIndex = datumIndex;
 			other._parent = nullptr;
+			other._parentDatum = nullptr;
 		}
 
 		// Move child Scope parent references to "this"
@@ -396,15 +668,95 @@ namespace FieaGameEngine
 		{
 			Scope& childScope = datum.GetScope(datumIndex);
 			childScope._parent = &(const_cast<Scope&>(parent));
+			childScope._generation = NextGeneration();
 			return false;
 		});
 	}
 
+	Scope::PairType& Scope::Entry(size_t index) const
+	{
+		// Derived types hand out their attributes mutably from const members (e.g. Entity::Children)
+		return const_cast<PairType&>(_table[index]);
+	}
+
+	void Scope::AttachChild(Scope& scope, Datum& datum)
+	{
+		datum.PushBack(scope);
+		scope._parent = this;
+		scope._parentDatum = &datum;
+		scope._parentIndex = datum.Size() - 1_z;
+		scope._generation = NextGeneration();
+	}
+
+	std::pair<Datum*, size_t> Scope::ParentSlot() const
+	{
+		assert(_parent != nullptr);
+
+		if (_parentDatum != nullptr && _parentIndex < _parentDatum->Size() && &_parentDatum->GetScope(_parentIndex) == this)
+		{
+			return std::make_pair(_parentDatum, _parentIndex);
+		}
+
+		// Only reached if the parent's Datum was edited directly (e.g. Datum::RemoveAt), fall back to a scan
+		Datum* foundDatum = nullptr;
+		size_t foundIndex = numeric_limits<size_t>::max();
+		_parent->ForEachNestedScopeIn([this, &foundDatum, &foundIndex](const Scope&, Datum& datum, size_t datumIndex)
+		{
+			if (&datum.GetScope(datumIndex) == this)
+			{
+				foundDatum = &datum;
+				foundIndex = datumIndex;
+				return true;
+			}
+			return false;
+		});
+
+		return std::make_pair(foundDatum, foundIndex);
+	}
+
+	Scope* Scope::CreateNestedScope(const Scope* prototype)
+	{
+		// Only plain Scopes are placed in the arena, derived types are made by their own Clone
+		if (_arena == nullptr || (prototype != nullptr && prototype->TypeIdInstance() != Scope::TypeIdClass()))
+		{
+			return prototype != nullptr ? prototype->Clone() : new Scope;
+		}
+
+		Scope* scope = new (_arena->Allocate(sizeof(Scope), alignof(Scope))) Scope(*_arena);
+		scope->_isInArena = true;
+		if (prototype != nullptr)
+		{
+			try
+			{
+				scope->DeepCopy(*prototype);
+			}
+			catch (...)
+			{
+				DestroyNestedScope(*scope);
+				throw;
+			}
+		}
+		return scope;
+	}
+
+	void Scope::DestroyNestedScope(Scope& scope)
+	{
+		if (scope._isInArena)
+		{
+			// The arena releases the memory itself
+			scope.~Scope();
+		}
+		else
+		{
+			delete &scope;
+		}
+	}
+
 	void Scope::ForEachNestedScopeIn(NestedScopeFunction func) const
 	{
-		for (const auto& pair : _orderVector)
+		for (size_t i = 0_z; i < _table.Size(); ++i)
 		{
-			Datum& datum = pair->second;
+			Datum& datum = Entry(i).second;
 			if (datum.Type() == Datum::DatumType::Table)
 			{
 				assert(!datum.IsExternal());
@@ -1,17 +1,24 @@
 #pragma once
 
+#include <atomic>
 #include <string>
+#include <string_view>
 #include <gsl/gsl>
 
 #include "HashMap.h"
+#include "Symbol.h"
 #include "Vector.h"
 #include "Datum.h"
+#include "ScopeTable.h"
+#include "Arena.h"
 #include "Factory.h"
 #include "RTTI.h"
 #include "SizeLiteral.h"
 
 namespace FieaGameEngine
 {
+	class ThreadPool;
+
 	/// <summary>
 	/// Scope objects are tables that create dictionary of name-value
 	/// pairs where Datum objects are the values. Each entry in a Scope
@@ -22,6 +29,13 @@ namespace FieaGameEngine
 	/// classes form a recursive pair: Scopes are tables of Datum, some of
 	/// which can be other tables (i.e. Scopes). Also, since each Scope has
 	/// a pointer to its parent, this forms a tree of Scopes. 
+	/// Entries are keyed by interned Symbols. Every function taking a name has an overload
+	/// taking a Symbol, which skips hashing and comparing the string; hot paths should
+	/// intern their names once and use those overloads.
+	/// Entries are stored contiguously in insertion order (see ScopeTable) and never move, so
+	/// references to a Scope's Datums stay valid until the Scope is cleared or destroyed.
+	/// A Scope constructed with an Arena allocates its table, its Datum buffers and the Scopes
+	/// appended to it (and their descendants) from the Arena; see Arena.
 	/// </summary>
 	class Scope : public FieaGameEngine::RTTI
 	{
@@ -29,15 +43,24 @@ namespace FieaGameEngine
 
 	public:
 		/// <summary>
-		/// Constructor for Scope. Initializes underlying map and vector.
+		/// Constructor for Scope. Initializes the underlying table.
 		/// If optional capacity passed in it pre allocates the memory for the
-		/// map and vector to that capacity.
+		/// table to that capacity.
 		/// </summary>
-		/// <param name="capacity">pre allocated size of vector</param>
+		/// <param name="capacity">pre allocated number of entries</param>
 		explicit Scope(size_t size = 0);
 		/// <summary>
+		/// Constructs a Scope whose table, Datum buffers and nested Scopes are allocated from the arena.
+		/// Nested Scopes made by AppendScope or by copying are placed in the arena too and must not be
+		/// deleted; they are destroyed by clearing or destroying their parent. The arena must outlive the tree.
+		/// </summary>
+		/// <param name="arena">arena to allocate from</param>
+		/// <param name="capacity">pre allocated number of entries</param>
+		explicit Scope(Arena& arena, size_t size = 0);
+		/// <summary>
 		/// Copy Constructor deep copies the other Scope. It does not
-		/// link to the parent though.
+		/// link to the parent though. Values are shared copy-on-write (see Datum::Share),
+		/// so a copy only allocates for the attributes it goes on to change.
 		/// </summary>
 		/// <param name="other">other Scope to copy</param>
 		Scope(const Scope& other);
@@ -63,7 +86,7 @@ namespace FieaGameEngine
 		/// <returns>moved constructor</returns>
 		Scope& operator=(Scope&& other) noexcept;
 		/// <summary>
-		/// Destructor clears scope and its underlying map and vector.
+		/// Destructor clears scope and its underlying table.
 		/// </summary>
 		virtual ~Scope();
 
@@ -101,7 +124,13 @@ namespace FieaGameEngine
 		/// </summary>
 		/// <param name="name">string to append to</param>
 		/// <returns>datum reference that was appended or found</returns>
-		Datum& operator[](const std::string& name);
+		Datum& operator[](std::string_view name);
+		/// <summary>
+		/// Takes a symbol and which wraps Append, for syntactic convenience.
+		/// </summary>
+		/// <param name="name">symbol to append to</param>
+		/// <returns>datum reference that was appended or found</returns>
+		Datum& operator[](const Symbol& name);
 
 		/// <summary>
 		/// Size of the Scope.
@@ -129,6 +158,11 @@ namespace FieaGameEngine
 		/// </summary>
 		/// <returns>constant address of the Scope which contains this scope</returns>
 		const Scope* GetParent() const;
+		/// <summary>
+		/// Arena the Scope allocates from.
+		/// </summary>
+		/// <returns>the arena, or nullptr if the Scope uses the heap</returns>
+		Arena* GetArena() const;
 
 		/// <summary>
 		/// Takes a constant string and returns a reference to a Datum with the associated name.
@@ -138,7 +172,7 @@ namespace FieaGameEngine
 		/// <param name="name">Given key to append</param>
 		/// <returns>Reference to a Datum with the associated name</returns>
 		/// <exception cref="invalid_argument">Cannot Append an empty string name into Scope</exception>
-		Datum& Append(const std::string& name);
+		Datum& Append(std::string_view name);
 		/// <summary>
 		/// Takes a constant string and an address to a bool. If entry created bool sets to true.
 		/// Returns a reference to a Datum with the associated name.
@@ -149,7 +183,25 @@ namespace FieaGameEngine
 		/// <param name="entryCreated">sets to true if entry was created false otherwise</param>
 		/// <returns>Reference to a Datum with the associated name</returns>
 		/// <exception cref="invalid_argument">Cannot Append an empty string name into Scope</exception>
-		Datum& Append(const std::string& name, bool& entryCreated);
+		Datum& Append(std::string_view name, bool& entryCreated);
+		/// <summary>
+		/// Takes a symbol and returns a reference to a Datum with the associated name.
+		/// If it already exists, return that one, otherwise create one. 
+		/// </summary>
+		/// <param name="name">Given key to append</param>
+		/// <returns>Reference to a Datum with the associated name</returns>
+		/// <exception cref="invalid_argument">Cannot Append an empty symbol into Scope</exception>
+		Datum& Append(const Symbol& name);
+		/// <summary>
+		/// Takes a symbol and an address to a bool. If entry created bool sets to true.
+		/// Returns a reference to a Datum with the associated name.
+		/// If it already exists, return that one, otherwise create one. 
+		/// </summary>
+		/// <param name="name">Given key to append</param>
+		/// <param name="entryCreated">sets to true if entry was created false otherwise</param>
+		/// <returns>Reference to a Datum with the associated name</returns>
+		/// <exception cref="invalid_argument">Cannot Append an empty symbol into Scope</exception>
+		Datum& Append(const Symbol& name, bool& entryCreated);
 		/// <summary>
 		/// Takes a constant string and returns a reference to Scope. Returns a reference to a Scope
 		/// with the associated name. If a Datum already exists at that key it reuses it, otherwise it
@@ -160,11 +212,19 @@ namespace FieaGameEngine
 		/// <returns>Reference to a Scope with the associated name</returns>
 		/// <exception cref="invalid_argument">Cannot Append an empty string name into Scope</exception>
 		/// <exception cref="runtime_error">Cannot Append a Scope to a Datum with invalid type</exception>
-		Scope& AppendScope(const std::string& name);
+		Scope& AppendScope(std::string_view name);
+		/// <summary>
+		/// Takes a symbol and returns a reference to a new Scope appended at that name.
+		/// </summary>
+		/// <param name="name">Given key to append scope to</param>
+		/// <returns>Reference to a Scope with the associated name</returns>
+		/// <exception cref="invalid_argument">Cannot Append an empty symbol into Scope</exception>
+		/// <exception cref="runtime_error">Cannot Append a Scope to a Datum with invalid type</exception>
+		Scope& AppendScope(const Symbol& name);
 
 		/// <summary>
 		/// Takes the constant address of a Scope and returns the Datum pointer and index at which the Scope was found.
-		/// This function looks at all children contained within this scope to find given scope.
+		/// Children remember their slot in the parent, so this is constant time.
 		/// </summary>
 		/// <param name="scope">Scope to be found</param>
 		/// <returns>Datum pointer and index at which the Scope was found or datum as a nullptr if not found</returns>
@@ -176,14 +236,28 @@ namespace FieaGameEngine
 		/// </summary>
 		/// <param name="name">Given key to find in Scope</param>
 		/// <returns>Datum associated with the given name in this Scope, if it exists, and nullptr otherwise.</returns>
-		Datum* Find(const std::string& name);
+		Datum* Find(std::string_view name);
 		/// <summary>
 		/// Takes a constant string and returns the address of a Datum. This should return the address of
 		/// the Datum associated with the given name in this Scope, if it exists, and nullptr otherwise.
 		/// </summary>
 		/// <param name="name">Given key to find in Scope</param>
 		/// <returns>Constant datum associated with the given name in this Scope, if it exists, and nullptr otherwise.</returns>
-		const Datum* Find(const std::string& name) const;
+		const Datum* Find(std::string_view name) const;
+		/// <summary>
+		/// Takes a symbol and returns the address of the Datum associated with it in this Scope,
+		/// if it exists, and nullptr otherwise.
+		/// </summary>
+		/// <param name="name">Given key to find in Scope</param>
+		/// <returns>Datum associated with the given name in this Scope, if it exists, and nullptr otherwise.</returns>
+		Datum* Find(const Symbol& name);
+		/// <summary>
+		/// Takes a symbol and returns the constant address of the Datum associated with it in this Scope,
+		/// if it exists, and nullptr otherwise.
+		/// </summary>
+		/// <param name="name">Given key to find in Scope</param>
+		/// <returns>Constant datum associated with the given name in this Scope, if it exists, and nullptr otherwise.</returns>
+		const Datum* Find(const Symbol& name) const;
 		/// <summary>
 		/// Takes a constant string to search in scope.
 		/// Return the address of the most-closely nested Datum associated with the given
@@ -192,7 +266,7 @@ namespace FieaGameEngine
 		/// <param name="name">Given key to search</param>
 		/// <returns>Address of the most-closely nested Datum associated with the given
 		/// name in this Scope or its ancestors, if it exists, and nullptr otherwise.</returns>
-		Datum* Search(const std::string& name);
+		Datum* Search(std::string_view name);
 		/// <summary>
 		/// Takes a constant string to search in scope.
 		/// Return the const address of the most-closely nested Datum associated with the given
@@ -201,7 +275,7 @@ namespace FieaGameEngine
 		/// <param name="name">Given key to search</param>
 		/// <returns>Constant address of the most-closely nested Datum associated with the given
 		/// name in this Scope or its ancestors, if it exists, and nullptr otherwise.</returns>
-		const Datum* Search(const std::string& name) const;
+		const Datum* Search(std::string_view name) const;
 		/// <summary>
 		/// Takes a constant string and the address of a Scope double pointer variable.
 		/// Return the address of the most-closely nested Datum associated with the given
@@ -211,7 +285,7 @@ namespace FieaGameEngine
 		/// <param name="foundScope">If provided, shall contain the address of the Scope object which contains the match.</param>
 		/// <returns>Address of the most-closely nested Datum associated with the given
 		/// name in this Scope or its ancestors, if it exists, and nullptr otherwise.</returns>
-		Datum* Search(const std::string& name, Scope*& foundScope);
+		Datum* Search(std::string_view name, Scope*& foundScope);
 		/// <summary>
 		/// Takes a constant string and the address of a Scope double pointer variable.
 		/// Return the constant address of the most-closely nested Datum associated with the given
@@ -221,12 +295,50 @@ namespace FieaGameEngine
 		/// <param name="foundScope">If provided, shall contain the address of the Scope object which contains the match.</param>
 		/// <returns>Constant address of the most-closely nested Datum associated with the given
 		/// name in this Scope or its ancestors, if it exists, and nullptr otherwise.</returns>
-		const Datum* Search(const std::string& name, const Scope*& foundScope) const;
+		const Datum* Search(std::string_view name, const Scope*& foundScope) const;
+		/// <summary>
+		/// Takes a symbol to search in scope.
+		/// Return the address of the most-closely nested Datum associated with the given
+		/// name in this Scope or its ancestors, if it exists, and nullptr otherwise.
+		/// </summary>
+		/// <param name="name">Given key to search</param>
+		/// <returns>Address of the most-closely nested Datum, or nullptr.</returns>
+		Datum* Search(const Symbol& name);
+		/// <summary>
+		/// Takes a symbol to search in scope.
+		/// Return the const address of the most-closely nested Datum associated with the given
+		/// name in this Scope or its ancestors, if it exists, and nullptr otherwise.
+		/// </summary>
+		/// <param name="name">Given key to search</param>
+		/// <returns>Constant address of the most-closely nested Datum, or nullptr.</returns>
+		const Datum* Search(const Symbol& name) const;
+		/// <summary>
+		/// Takes a symbol and the address of a Scope double pointer variable.
+		/// Return the address of the most-closely nested Datum associated with the given
+		/// name in this Scope or its ancestors, if it exists, and nullptr otherwise.
+		/// </summary>
+		/// <param name="name">Given key to search</param>
+		/// <param name="foundScope">Shall contain the address of the Scope object which contains the match.</param>
+		/// <returns>Address of the most-closely nested Datum, or nullptr.</returns>
+		Datum* Search(const Symbol& name, Scope*& foundScope);
+		/// <summary>
+		/// Takes a symbol and the address of a Scope double pointer variable.
+		/// Return the constant address of the most-closely nested Datum associated with the given
+		/// name in this Scope or its ancestors, if it exists, and nullptr otherwise.
+		/// </summary>
+		/// <param name="name">Given key to search</param>
+		/// <param name="foundScope">Shall contain the address of the Scope object which contains the match.</param>
+		/// <returns>Constant address of the most-closely nested Datum, or nullptr.</returns>
+		const Datum* Search(const Symbol& name, const Scope*& foundScope) const;
 
 
-		Datum& At(const std::string& name);
+		Datum& At(std::string_view name);
 
-		const Datum& At(const std::string& name) const;
+		const Datum& At(std::string_view name) const;
+
+		Datum& At(const Symbol& name);
+
+		const Datum& At(const Symbol& name) const;
 
 		/// <summary>
 		/// Adopts scope given by parenting it at the given key as a name.
@@ -235,9 +347,19 @@ namespace FieaGameEngine
 		/// <param name="name">name of key for the Datum to use for storing the child</param>
 		/// <exception cref="runtime_error">Cannot self-Adopt</exception>
 		/// <exception cref="runtime_error">Cannot Adopt ancestor Scope</exception>
-		void Adopt(Scope& scope, const std::string& name);
+		void Adopt(Scope& scope, std::string_view name);
+		/// <summary>
+		/// Adopts scope given by parenting it at the given symbol.
+		/// </summary>
+		/// <param name="scope">Child to adopt</param>
+		/// <param name="name">name of key for the Datum to use for storing the child</param>
+		/// <exception cref="runtime_error">Cannot self-Adopt</exception>
+		/// <exception cref="runtime_error">Cannot Adopt ancestor Scope</exception>
+		void Adopt(Scope& scope, const Symbol& name);
 		/// <summary>
 		/// Unparents the scope. Orphaned scope now has no owner so whoever orphaned it must delete it.
+		/// Constant time: the last Scope in the same Datum is moved into the orphaned slot, so the
+		/// order of the remaining siblings in that Datum is not preserved.
 		/// </summary>
 		void Orphan();
 
@@ -274,19 +396,75 @@ namespace FieaGameEngine
 		/// <returns>if this scope is an descendant</returns>
 		bool IsDescendantOf(const Scope& scope) const;
 
+		/// <summary>
+		/// Same result as Clone, but the Scopes nested directly in this one are cloned as separate
+		/// tasks on the pool, each copying its whole subtree. Only that first level is split up, so a
+		/// Scope with few direct children (a deep or narrow hierarchy) is cloned on few threads.
+		/// Nothing may modify this Scope or its descendants while the clone is made.
+		/// </summary>
+		/// <param name="pool">pool to clone the nested Scopes on</param>
+		/// <returns>new Scope</returns>
+		gsl::owner<Scope*> CloneParallel(ThreadPool& pool) const;
+		/// <summary>
+		/// Same result as operator==, but the pairs of Scopes nested directly in the two Scopes are
+		/// compared as separate tasks on the pool.
+		/// </summary>
+		/// <param name="other">other Scope to compare to</param>
+		/// <param name="pool">pool to compare the nested Scopes on</param>
+		/// <returns>bool indicating that the two Scope objects have matching contents</returns>
+		bool EqualsParallel(const Scope& other, ThreadPool& pool) const;
+		/// <summary>
+		/// Same as Clear, but the Scopes nested directly in this one are destroyed as separate tasks on the pool.
+		/// </summary>
+		/// <param name="pool">pool to destroy the nested Scopes on</param>
+		void ClearParallel(ThreadPool& pool);
+
+		/// <summary>
+		/// Structural generation of this Scope. It changes whenever this Scope creates an entry, is cleared
+		/// or gets another parent (adopted, orphaned or moved), the only changes to it that can change the
+		/// result of a Search passing through it. Generations are unique across all Scopes and only grow,
+		/// so a Search result stays valid while no Scope it walked has a newer generation (see CachedSearch).
+		/// </summary>
+		/// <returns>current structural generation of this Scope</returns>
+		std::uint64_t Generation() const;
+
 	protected:
-		using MapType = HashMap<std::string, Datum>;
-		using PairType = MapType::PairType;
+		using PairType = ScopeTable::PairType;
 
 		void Reparent(Scope&& rhs);
 		void DeepCopy(const Scope& other);
+		PairType& Entry(size_t index) const;
+		void AttachChild(Scope& scope, Datum& datum);
+		std::pair<Datum*, size_t> ParentSlot() const;
+		const Datum* SearchId(std::uintptr_t id, const Scope*& foundScope) const;
+		Scope* CreateNestedScope(const Scope* prototype);
+		static void DestroyNestedScope(Scope& scope);
+		static std::uint64_t NextGeneration();
 
 		using NestedScopeFunction = std::function<bool(const Scope&, Datum&, size_t)>;
 		void ForEachNestedScopeIn(NestedScopeFunction func) const;
 
+		inline static const Symbol _thisSymbol{ "this" };
+		inline static std::atomic<std::uint64_t> _lastGeneration{ 0 };
+
+		// A nested Scope that CloneParallel copies on the pool and then appends to the Datum DeepCopy left it for
+		struct DeferredCopy final
+		{
+			Datum* Target;
+			const Scope* Prototype;
+			Scope* Copy;
+		};
+		// Set by CloneParallel for the DeepCopy of the root only, the Scopes below it are copied as usual
+		inline static thread_local Vector<DeferredCopy>* _deferredCopies{ nullptr };
+
 		Scope* _parent{ nullptr };
-		MapType _map;
-		Vector<PairType*> _orderVector;
+		// Slot of this Scope in its parent, Datums of a ScopeTable never move so the pointer stays valid
+		Datum* _parentDatum{ nullptr };
+		size_t _parentIndex{ 0_z };
+		ScopeTable _table;
+		Arena* _arena{ nullptr };
+		bool _isInArena{ false };
+		std::uint64_t _generation{ NextGeneration() };
 	};
 
 	ConcreteFactory(Scope, Scope);
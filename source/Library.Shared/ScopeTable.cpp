@@ -0,0 +1,448 @@
+#include "pch.h"
+
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <tuple>
+
+#include "ScopeTable.h"
+#include "Arena.h"
+
+using namespace std;
+
+namespace FieaGameEngine
+{
+#pragma region Iterator
+	ScopeTable::Iterator::Iterator(const ScopeTable& owner, size_t index) :
+		_owner{ &owner }, _index{ index }
+	{
+		if (_index < _owner->_size)
+		{
+			const size_t block = _owner->BlockOf(_index);
+			_current = _owner->Slot(_index);
+			_blockEnd = _owner->_blocks[block] + _owner->BlockSize(block);
+		}
+	}
+
+	ScopeTable::PairType& ScopeTable::Iterator::operator*() const
+	{
+		if (_owner == nullptr || _index >= _owner->_size)
+		{
+			throw runtime_error("Cannot dereference an end or unowned iterator.");
+		}
+		return *_current;
+	}
+
+	ScopeTable::PairType* ScopeTable::Iterator::operator->() const
+	{
+		return &(operator*());
+	}
+
+	bool ScopeTable::Iterator::operator==(const Iterator& other) const
+	{
+		return _owner == other._owner && _index == other._index;
+	}
+
+	bool ScopeTable::Iterator::operator!=(const Iterator& other) const
+	{
+		return !(operator==(other));
+	}
+
+	ScopeTable::Iterator& ScopeTable::Iterator::operator++()
+	{
+		if (_owner == nullptr)
+		{
+			throw runtime_error("Cannot increment an unowned iterator.");
+		}
+
+		if (_index < _owner->_size)
+		{
+			++_index;
+			++_current;
+			if (_current == _blockEnd && _index < _owner->_size)
+			{
+				// Blocks are contiguous inside, so only crossing into the next block needs a lookup
+				const size_t block = _owner->BlockOf(_index);
+				_current = _owner->_blocks[block];
+				_blockEnd = _current + _owner->BlockSize(block);
+			}
+		}
+		return *this;
+	}
+
+	ScopeTable::Iterator ScopeTable::Iterator::operator++(int)
+	{
+		Iterator it = *this;
+		operator++();
+		return it;
+	}
+#pragma endregion
+
+#pragma region ConstIterator
+	ScopeTable::ConstIterator::ConstIterator(const Iterator& it) :
+		_it{ it }
+	{
+	}
+
+	const ScopeTable::PairType& ScopeTable::ConstIterator::operator*() const
+	{
+		return *_it;
+	}
+
+	const ScopeTable::PairType* ScopeTable::ConstIterator::operator->() const
+	{
+		return &(*_it);
+	}
+
+	bool ScopeTable::ConstIterator::operator==(const ConstIterator& other) const
+	{
+		return _it == other._it;
+	}
+
+	bool ScopeTable::ConstIterator::operator!=(const ConstIterator& other) const
+	{
+		return _it != other._it;
+	}
+
+	ScopeTable::ConstIterator& ScopeTable::ConstIterator::operator++()
+	{
+		++_it;
+		return *this;
+	}
+
+	ScopeTable::ConstIterator ScopeTable::ConstIterator::operator++(int)
+	{
+		ConstIterator it = *this;
+		++_it;
+		return it;
+	}
+#pragma endregion
+
+#pragma region ScopeTable
+	ScopeTable::ScopeTable(size_t capacity, Arena* arena) :
+		_arena{ arena }
+	{
+		Reserve(capacity);
+	}
+
+	ScopeTable::ScopeTable(ScopeTable&& other) noexcept :
+		_blockCount{ other._blockCount }, _firstBlockShift{ other._firstBlockShift }, _size{ other._size },
+		_index{ other._index }, _indexCapacity{ other._indexCapacity }, _arena{ other._arena }
+	{
+		std::memcpy(_blocks, other._blocks, sizeof(_blocks));
+		std::memset(other._blocks, 0, sizeof(other._blocks));
+		other._blockCount = 0_z;
+		other._firstBlockShift = _minFirstBlockShift;
+		other._size = 0_z;
+		other._index = nullptr;
+		other._indexCapacity = 0_z;
+	}
+
+	ScopeTable& ScopeTable::operator=(ScopeTable&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Release();
+
+			std::memcpy(_blocks, other._blocks, sizeof(_blocks));
+			_blockCount = other._blockCount;
+			_firstBlockShift = other._firstBlockShift;
+			_size = other._size;
+			_index = other._index;
+			_indexCapacity = other._indexCapacity;
+			_arena = other._arena;
+
+			std::memset(other._blocks, 0, sizeof(other._blocks));
+			other._blockCount = 0_z;
+			other._firstBlockShift = _minFirstBlockShift;
+			other._size = 0_z;
+			other._index = nullptr;
+			other._indexCapacity = 0_z;
+		}
+		return *this;
+	}
+
+	ScopeTable::~ScopeTable()
+	{
+		Release();
+	}
+
+	ScopeTable::PairType& ScopeTable::operator[](size_t index)
+	{
+		assert(index < _size);
+		return *Slot(index);
+	}
+
+	const ScopeTable::PairType& ScopeTable::operator[](size_t index) const
+	{
+		assert(index < _size);
+		return *Slot(index);
+	}
+
+	size_t ScopeTable::Size() const
+	{
+		return _size;
+	}
+
+	bool ScopeTable::IsEmpty() const
+	{
+		return _size == 0_z;
+	}
+
+	ScopeTable::PairType* ScopeTable::Find(const Symbol& name)
+	{
+		const size_t position = FindPosition(name.Id());
+		return position != _npos ? Slot(position) : nullptr;
+	}
+
+	const ScopeTable::PairType* ScopeTable::Find(const Symbol& name) const
+	{
+		return FindId(name.Id());
+	}
+
+	const ScopeTable::PairType* ScopeTable::FindId(std::uintptr_t id) const
+	{
+		const size_t position = FindPosition(id);
+		return position != _npos ? Slot(position) : nullptr;
+	}
+
+	std::pair<ScopeTable::PairType*, bool> ScopeTable::Insert(const Symbol& name)
+	{
+		assert(!name.IsEmpty());
+
+		const size_t position = FindPosition(name.Id());
+		if (position != _npos)
+		{
+			return make_pair(Slot(position), false);
+		}
+
+		Reserve(_size + 1_z);
+		if (_size + 1_z > _linearSearchLimit && (_size + 1_z) * 2_z > _indexCapacity)
+		{
+			Reindex(std::bit_ceil((_size + 1_z) * 4_z));
+		}
+
+		PairType* entry = new (Slot(_size)) PairType(piecewise_construct, forward_as_tuple(name), forward_as_tuple());
+		entry->second._arena = _arena;
+		if (_index != nullptr)
+		{
+			const size_t mask = _indexCapacity - 1_z;
+			size_t slot = DefaultHash<Symbol>{}(name) & mask;
+			while (_index[slot] != 0)
+			{
+				slot = (slot + 1_z) & mask;
+			}
+			_index[slot] = static_cast<IndexType>(_size + 1_z);
+		}
+		++_size;
+
+		return make_pair(entry, true);
+	}
+
+	void ScopeTable::Reserve(size_t capacity)
+	{
+		if (capacity == 0_z)
+		{
+			return;
+		}
+
+		if (_blockCount == 0_z)
+		{
+			// The first block is sized to the first request so reserved tables fill a single block
+			_firstBlockShift = std::max(_minFirstBlockShift, static_cast<size_t>(std::bit_width(capacity - 1_z)));
+		}
+
+		const size_t lastBlock = BlockOf(capacity - 1_z);
+		if (lastBlock >= _maxBlocks || capacity > std::numeric_limits<IndexType>::max())
+		{
+			throw runtime_error("Table is full.");
+		}
+
+		while (_blockCount <= lastBlock)
+		{
+			AllocateBlock(_blockCount);
+		}
+	}
+
+	void ScopeTable::Clear()
+	{
+		for (size_t block = 0_z, position = 0_z; position < _size; ++block)
+		{
+			PairType* entries = _blocks[block];
+			const size_t count = std::min(BlockSize(block), _size - position);
+			for (size_t i = 0_z; i < count; ++i)
+			{
+				entries[i].~PairType();
+			}
+			position += count;
+		}
+		_size = 0_z;
+
+		if (_index != nullptr)
+		{
+			std::memset(_index, 0, _indexCapacity * sizeof(IndexType));
+		}
+	}
+
+	Arena* ScopeTable::GetArena() const
+	{
+		return _arena;
+	}
+
+	ScopeTable::Iterator ScopeTable::begin()
+	{
+		return Iterator(*this, 0_z);
+	}
+
+	ScopeTable::ConstIterator ScopeTable::begin() const
+	{
+		return Iterator(*this, 0_z);
+	}
+
+	ScopeTable::ConstIterator ScopeTable::cbegin() const
+	{
+		return Iterator(*this, 0_z);
+	}
+
+	ScopeTable::Iterator ScopeTable::end()
+	{
+		return Iterator(*this, _size);
+	}
+
+	ScopeTable::ConstIterator ScopeTable::end() const
+	{
+		return Iterator(*this, _size);
+	}
+
+	ScopeTable::ConstIterator ScopeTable::cend() const
+	{
+		return Iterator(*this, _size);
+	}
+
+	size_t ScopeTable::BlockOf(size_t index) const
+	{
+		// Block b holds positions [first * (2^b - 1), first * (2^(b+1) - 1))
+		return static_cast<size_t>(std::bit_width((index >> _firstBlockShift) + 1_z)) - 1_z;
+	}
+
+	size_t ScopeTable::BlockBegin(size_t block) const
+	{
+		return ((1_z << block) - 1_z) << _firstBlockShift;
+	}
+
+	size_t ScopeTable::BlockSize(size_t block) const
+	{
+		return 1_z << (_firstBlockShift + block);
+	}
+
+	ScopeTable::PairType* ScopeTable::Slot(size_t index) const
+	{
+		const size_t block = BlockOf(index);
+		return _blocks[block] + (index - BlockBegin(block));
+	}
+
+	void ScopeTable::AllocateBlock(size_t block)
+	{
+		assert(block == _blockCount);
+		_blocks[block] = static_cast<PairType*>(Allocate(BlockSize(block) * sizeof(PairType), alignof(PairType)));
+		++_blockCount;
+	}
+
+	void* ScopeTable::Allocate(size_t size, size_t alignment) const
+	{
+		if (_arena != nullptr)
+		{
+			return _arena->Allocate(size, alignment);
+		}
+
+		void* data = malloc(size);
+		if (data == nullptr)
+		{
+			throw bad_alloc();
+		}
+		return data;
+	}
+
+	void ScopeTable::Free(void* data) const
+	{
+		// Arena memory is released all at once by the arena
+		if (_arena == nullptr)
+		{
+			free(data);
+		}
+	}
+
+	size_t ScopeTable::FindPosition(std::uintptr_t id) const
+	{
+		if (_index == nullptr)
+		{
+			// Small tables are a short scan of the first blocks, no index needed
+			for (size_t block = 0_z, position = 0_z; position < _size; ++block)
+			{
+				const PairType* entries = _blocks[block];
+				const size_t count = std::min(BlockSize(block), _size - position);
+				for (size_t i = 0_z; i < count; ++i)
+				{
+					if (entries[i].first.Id() == id)
+					{
+						return position + i;
+					}
+				}
+				position += count;
+			}
+			return _npos;
+		}
+
+		const size_t mask = _indexCapacity - 1_z;
+		for (size_t slot = HashInteger(id) & mask; _index[slot] != 0; slot = (slot + 1_z) & mask)
+		{
+			const size_t position = _index[slot] - 1_z;
+			if (Slot(position)->first.Id() == id)
+			{
+				return position;
+			}
+		}
+		return _npos;
+	}
+
+	void ScopeTable::Reindex(size_t capacity)
+	{
+		assert(std::has_single_bit(capacity));
+		IndexType* index = static_cast<IndexType*>(Allocate(capacity * sizeof(IndexType), alignof(IndexType)));
+		std::memset(index, 0, capacity * sizeof(IndexType));
+
+		const size_t mask = capacity - 1_z;
+		size_t position = 0_z;
+		for (const PairType& entry : *this)
+		{
+			size_t slot = DefaultHash<Symbol>{}(entry.first) & mask;
+			while (index[slot] != 0)
+			{
+				slot = (slot + 1_z) & mask;
+			}
+			index[slot] = static_cast<IndexType>(++position);
+		}
+
+		Free(_index);
+		_index = index;
+		_indexCapacity = capacity;
+	}
+
+	void ScopeTable::Release()
+	{
+		Clear();
+
+		for (size_t block = 0_z; block < _blockCount; ++block)
+		{
+			Free(_blocks[block]);
+			_blocks[block] = nullptr;
+		}
+		_blockCount = 0_z;
+		_firstBlockShift = _minFirstBlockShift;
+
+		Free(_index);
+		_index = nullptr;
+		_indexCapacity = 0_z;
+	}
+#pragma endregion
+}
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+
+#include "Datum.h"
+#include "Symbol.h"
+#include "SizeLiteral.h"
+
+namespace FieaGameEngine
+{
+	class Arena;
+
+	/// <summary>
+	/// ScopeTable is the storage of a Scope: its {name, Datum} entries in insertion order plus an index
+	/// from names to positions. Entries live in a handful of contiguous blocks, each twice the size of the
+	/// one before, so indexed access is one load from the (inline) block table and iteration walks memory
+	/// linearly. Blocks are never reallocated, so entries (and references to their Datums) keep their address
+	/// for as long as the table holds them. The index is an open-addressed array of 32-bit positions and is
+	/// only built once the table outgrows a short linear scan.
+	/// A table given an Arena takes its blocks and index from it, and so do the Datums it creates.
+	/// </summary>
+	class ScopeTable final
+	{
+	public:
+		using PairType = std::pair<const Symbol, Datum>;
+
+		class Iterator final
+		{
+			friend ScopeTable;
+			friend class ConstIterator;
+
+		public:
+			Iterator() = default;
+			Iterator(const Iterator&) = default;
+			Iterator(Iterator&&) noexcept = default;
+			Iterator& operator=(const Iterator& other) = default;
+			Iterator& operator=(Iterator&& other) noexcept = default;
+			~Iterator() = default;
+
+			PairType& operator*() const;
+			PairType* operator->() const;
+
+			bool operator==(const Iterator& other) const;
+			bool operator!=(const Iterator& other) const;
+
+			Iterator& operator++();
+			Iterator operator++(int);
+
+		private:
+			Iterator(const ScopeTable& owner, size_t index);
+
+			const ScopeTable* _owner{ nullptr };
+			size_t _index{ 0_z };
+			PairType* _current{ nullptr };
+			PairType* _blockEnd{ nullptr };
+		};
+
+		class ConstIterator final
+		{
+			friend ScopeTable;
+
+		public:
+			ConstIterator() = default;
+			ConstIterator(const Iterator& it);
+			ConstIterator(const ConstIterator&) = default;
+			ConstIterator(ConstIterator&&) noexcept = default;
+			ConstIterator& operator=(const ConstIterator& other) = default;
+			ConstIterator& operator=(ConstIterator&& other) noexcept = default;
+			~ConstIterator() = default;
+
+			const PairType& operator*() const;
+			const PairType* operator->() const;
+
+			bool operator==(const ConstIterator& other) const;
+			bool operator!=(const ConstIterator& other) const;
+
+			ConstIterator& operator++();
+			ConstIterator operator++(int);
+
+		private:
+			Iterator _it;
+		};
+
+		/// <summary>
+		/// Constructs an empty table.
+		/// </summary>
+		/// <param name="capacity">number of entries to make room for up front</param>
+		/// <param name="arena">arena to allocate from, nullptr to use the heap</param>
+		explicit ScopeTable(size_t capacity = 0_z, Arena* arena = nullptr);
+		ScopeTable(const ScopeTable&) = delete;
+		/// <summary>
+		/// Takes the other table's blocks and index, entries keep their addresses.
+		/// </summary>
+		/// <param name="other">table to move, left empty</param>
+		ScopeTable(ScopeTable&& other) noexcept;
+		ScopeTable& operator=(const ScopeTable&) = delete;
+		/// <summary>
+		/// Destroys this table's entries and takes the other table's blocks and index.
+		/// </summary>
+		/// <param name="other">table to move, left empty</param>
+		/// <returns>this table</returns>
+		ScopeTable& operator=(ScopeTable&& other) noexcept;
+		/// <summary>
+		/// Destroys every entry and frees the blocks and index.
+		/// </summary>
+		~ScopeTable();
+
+		/// <summary>
+		/// Entry at a position, in insertion order. Unchecked (asserted in debug builds).
+		/// </summary>
+		/// <param name="index">position of the entry, must be less than Size()</param>
+		/// <returns>the entry</returns>
+		PairType& operator[](size_t index);
+		/// <summary>
+		/// Entry at a position, in insertion order. Unchecked (asserted in debug builds).
+		/// </summary>
+		/// <param name="index">position of the entry, must be less than Size()</param>
+		/// <returns>the entry</returns>
+		const PairType& operator[](size_t index) const;
+
+		/// <summary>
+		/// Number of entries.
+		/// </summary>
+		/// <returns>number of entries</returns>
+		size_t Size() const;
+		/// <summary>
+		/// Does the table have no entries?
+		/// </summary>
+		/// <returns>true if the table is empty</returns>
+		bool IsEmpty() const;
+
+		/// <summary>
+		/// Finds the entry with the given name.
+		/// </summary>
+		/// <param name="name">name to look for</param>
+		/// <returns>the entry, or nullptr if there is none</returns>
+		PairType* Find(const Symbol& name);
+		/// <summary>
+		/// Finds the entry with the given name.
+		/// </summary>
+		/// <param name="name">name to look for</param>
+		/// <returns>the entry, or nullptr if there is none</returns>
+		const PairType* Find(const Symbol& name) const;
+		/// <summary>
+		/// Finds the entry whose name has the given Id, see SymbolTable::FindId.
+		/// </summary>
+		/// <param name="id">Id of the name to look for</param>
+		/// <returns>the entry, or nullptr if there is none</returns>
+		const PairType* FindId(std::uintptr_t id) const;
+		/// <summary>
+		/// Appends an entry with an empty Datum if the name is not in the table yet.
+		/// </summary>
+		/// <param name="name">name of the entry, must not be empty</param>
+		/// <returns>the entry with the name, and true if it was appended</returns>
+		/// <exception cref="runtime_error">Table is full</exception>
+		std::pair<PairType*, bool> Insert(const Symbol& name);
+
+		/// <summary>
+		/// Makes room for at least capacity entries without allocating again.
+		/// </summary>
+		/// <param name="capacity">number of entries to make room for</param>
+		/// <exception cref="runtime_error">Table is full</exception>
+		void Reserve(size_t capacity);
+		/// <summary>
+		/// Destroys every entry. Blocks are kept for reuse.
+		/// </summary>
+		void Clear();
+		/// <summary>
+		/// Arena the table allocates from.
+		/// </summary>
+		/// <returns>the arena, or nullptr if the table uses the heap</returns>
+		Arena* GetArena() const;
+
+		Iterator begin();
+		ConstIterator begin() const;
+		ConstIterator cbegin() const;
+		Iterator end();
+		ConstIterator end() const;
+		ConstIterator cend() const;
+
+	private:
+		using IndexType = std::uint32_t;
+
+		size_t BlockOf(size_t index) const;
+		size_t BlockBegin(size_t block) const;
+		size_t BlockSize(size_t block) const;
+		PairType* Slot(size_t index) const;
+		void AllocateBlock(size_t block);
+		void* Allocate(size_t size, size_t alignment) const;
+		void Free(void* data) const;
+		size_t FindPosition(std::uintptr_t id) const;
+		void Reindex(size_t capacity);
+		void Release();
+
+		inline static constexpr size_t _maxBlocks{ 20 };
+		inline static constexpr size_t _minFirstBlockShift{ 2 };
+		inline static constexpr size_t _linearSearchLimit{ 8 };
+		inline static constexpr size_t _npos{ static_cast<size_t>(-1) };
+
+		PairType* _blocks[_maxBlocks]{};
+		size_t _blockCount{ 0_z };
+		size_t _firstBlockShift{ _minFirstBlockShift };
+		size_t _size{ 0_z };
+
+		// Open-addressed, 0 marks an empty slot and anything else is the entry's position + 1
+		IndexType* _index{ nullptr };
+		size_t _indexCapacity{ 0_z };
+
+		Arena* _arena{ nullptr };
+	};
+}
@@ -0,0 +1,242 @@
+#include "pch.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define FIEA_SIMDMATH_SSE
+#include <emmintrin.h>
+#include <xmmintrin.h>
+#endif
+
+#include <bit>
+
+#include "SimdMath.h"
+
+namespace FieaGameEngine
+{
+#ifdef FIEA_SIMDMATH_SSE
+	namespace
+	{
+		inline __m128 Load(const glm::vec4& vector)
+		{
+			return _mm_loadu_ps(&vector[0]);
+		}
+
+		inline glm::vec4 Store(__m128 value)
+		{
+			glm::vec4 vector;
+			_mm_storeu_ps(&vector[0], value);
+			return vector;
+		}
+
+		inline __m128 Transform(const glm::mat4& matrix, __m128 vector)
+		{
+			__m128 result = _mm_mul_ps(Load(matrix[0]), _mm_shuffle_ps(vector, vector, _MM_SHUFFLE(0, 0, 0, 0)));
+			result = _mm_add_ps(result, _mm_mul_ps(Load(matrix[1]), _mm_shuffle_ps(vector, vector, _MM_SHUFFLE(1, 1, 1, 1))));
+			result = _mm_add_ps(result, _mm_mul_ps(Load(matrix[2]), _mm_shuffle_ps(vector, vector, _MM_SHUFFLE(2, 2, 2, 2))));
+			return _mm_add_ps(result, _mm_mul_ps(Load(matrix[3]), _mm_shuffle_ps(vector, vector, _MM_SHUFFLE(3, 3, 3, 3))));
+		}
+	}
+#endif
+
+	glm::vec4 SimdMath::Add(const glm::vec4& lhs, const glm::vec4& rhs)
+	{
+#ifdef FIEA_SIMDMATH_SSE
+		return Store(_mm_add_ps(Load(lhs), Load(rhs)));
+#else
+		return lhs + rhs;
+#endif
+	}
+
+	glm::vec4 SimdMath::Subtract(const glm::vec4& lhs, const glm::vec4& rhs)
+	{
+#ifdef FIEA_SIMDMATH_SSE
+		return Store(_mm_sub_ps(Load(lhs), Load(rhs)));
+#else
+		return lhs - rhs;
+#endif
+	}
+
+	glm::vec4 SimdMath::Multiply(const glm::vec4& lhs, const glm::vec4& rhs)
+	{
+#ifdef FIEA_SIMDMATH_SSE
+		return Store(_mm_mul_ps(Load(lhs), Load(rhs)));
+#else
+		return lhs * rhs;
+#endif
+	}
+
+	glm::vec4 SimdMath::Divide(const glm::vec4& lhs, const glm::vec4& rhs)
+	{
+#ifdef FIEA_SIMDMATH_SSE
+		return Store(_mm_div_ps(Load(lhs), Load(rhs)));
+#else
+		return lhs / rhs;
+#endif
+	}
+
+	glm::vec4 SimdMath::Scale(const glm::vec4& vector, float scalar)
+	{
+#ifdef FIEA_SIMDMATH_SSE
+		return Store(_mm_mul_ps(Load(vector), _mm_set1_ps(scalar)));
+#else
+		return vector * scalar;
+#endif
+	}
+
+	glm::mat4 SimdMath::Add(const glm::mat4& lhs, const glm::mat4& rhs)
+	{
+		glm::mat4 result;
+		for (int column = 0; column < 4; ++column)
+		{
+			result[column] = Add(lhs[column], rhs[column]);
+		}
+		return result;
+	}
+
+	glm::mat4 SimdMath::Subtract(const glm::mat4& lhs, const glm::mat4& rhs)
+	{
+		glm::mat4 result;
+		for (int column = 0; column < 4; ++column)
+		{
+			result[column] = Subtract(lhs[column], rhs[column]);
+		}
+		return result;
+	}
+
+	glm::mat4 SimdMath::Multiply(const glm::mat4& lhs, const glm::mat4& rhs)
+	{
+		glm::mat4 result;
+		for (int column = 0; column < 4; ++column)
+		{
+#ifdef FIEA_SIMDMATH_SSE
+			result[column] = Store(Transform(lhs, Load(rhs[column])));
+#else
+			result[column] = lhs * rhs[column];
+#endif
+		}
+		return result;
+	}
+
+	glm::vec4 SimdMath::Multiply(const glm::mat4& matrix, const glm::vec4& vector)
+	{
+#ifdef FIEA_SIMDMATH_SSE
+		return Store(Transform(matrix, Load(vector)));
+#else
+		return matrix * vector;
+#endif
+	}
+
+	glm::mat4 SimdMath::Scale(const glm::mat4& matrix, float scalar)
+	{
+		glm::mat4 result;
+		for (int column = 0; column < 4; ++column)
+		{
+			result[column] = Scale(matrix[column], scalar);
+		}
+		return result;
+	}
+
+#ifdef FIEA_SIMDMATH_SSE
+#define FIEA_SIMDMATH_ARRAY_KERNEL(Operation, Intrinsic, Operator)										\
+	void SimdMath::Operation(float* result, const float* lhs, const float* rhs, size_t count)			\
+	{																									\
+		size_t i = 0;																					\
+		for (; i + 4 <= count; i += 4)																	\
+		{																								\
+			_mm_storeu_ps(result + i, Intrinsic(_mm_loadu_ps(lhs + i), _mm_loadu_ps(rhs + i)));			\
+		}																								\
+		for (; i < count; ++i)																			\
+		{																								\
+			result[i] = lhs[i] Operator rhs[i];															\
+		}																								\
+	}
+#else
+#define FIEA_SIMDMATH_ARRAY_KERNEL(Operation, Intrinsic, Operator)										\
+	void SimdMath::Operation(float* result, const float* lhs, const float* rhs, size_t count)			\
+	{																									\
+		for (size_t i = 0; i < count; ++i)																\
+		{																								\
+			result[i] = lhs[i] Operator rhs[i];															\
+		}																								\
+	}
+#endif
+
+	FIEA_SIMDMATH_ARRAY_KERNEL(Add, _mm_add_ps, +)
+	FIEA_SIMDMATH_ARRAY_KERNEL(Subtract, _mm_sub_ps, -)
+	FIEA_SIMDMATH_ARRAY_KERNEL(Multiply, _mm_mul_ps, *)
+	FIEA_SIMDMATH_ARRAY_KERNEL(Divide, _mm_div_ps, /)
+
+#undef FIEA_SIMDMATH_ARRAY_KERNEL
+
+	size_t SimdMath::Find(const int* data, size_t count, int value)
+	{
+		size_t i = 0;
+#ifdef FIEA_SIMDMATH_SSE
+		const __m128i target = _mm_set1_epi32(value);
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128i matches = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), target);
+			const int mask = _mm_movemask_ps(_mm_castsi128_ps(matches));
+			if (mask != 0)
+			{
+				return i + std::countr_zero(static_cast<unsigned int>(mask));
+			}
+		}
+#endif
+		for (; i < count; ++i)
+		{
+			if (data[i] == value)
+			{
+				break;
+			}
+		}
+		return i;
+	}
+
+	size_t SimdMath::Find(const float* data, size_t count, float value)
+	{
+		size_t i = 0;
+#ifdef FIEA_SIMDMATH_SSE
+		const __m128 target = _mm_set1_ps(value);
+		for (; i + 4 <= count; i += 4)
+		{
+			const int mask = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(data + i), target));
+			if (mask != 0)
+			{
+				return i + std::countr_zero(static_cast<unsigned int>(mask));
+			}
+		}
+#endif
+		for (; i < count; ++i)
+		{
+			if (data[i] == value)
+			{
+				break;
+			}
+		}
+		return i;
+	}
+
+	size_t SimdMath::Find(const glm::vec4* data, size_t count, const glm::vec4& value)
+	{
+		size_t i = 0;
+#ifdef FIEA_SIMDMATH_SSE
+		const __m128 target = Load(value);
+		for (; i < count; ++i)
+		{
+			if (_mm_movemask_ps(_mm_cmpeq_ps(Load(data[i]), target)) == 0xF)
+			{
+				break;
+			}
+		}
+#else
+		for (; i < count; ++i)
+		{
+			if (data[i] == value)
+			{
+				break;
+			}
+		}
+#endif
+		return i;
+	}
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace FieaGameEngine
+{
+	/// <summary>
+	/// Vector and matrix kernels used by scripted expressions. Each glm::vec4 and each column
+	/// of a glm::mat4 is processed as one SSE register when SSE is available, with a scalar
+	/// fallback otherwise. Matrices are column major, as in glm.
+	/// </summary>
+	class SimdMath final
+	{
+	public:
+		SimdMath() = delete;
+		SimdMath(const SimdMath&) = delete;
+		SimdMath(SimdMath&&) = delete;
+		SimdMath& operator=(const SimdMath&) = delete;
+		SimdMath& operator=(SimdMath&&) = delete;
+		~SimdMath() = default;
+
+		/// <summary>
+		/// Component-wise lhs + rhs.
+		/// </summary>
+		static glm::vec4 Add(const glm::vec4& lhs, const glm::vec4& rhs);
+		/// <summary>
+		/// Component-wise lhs - rhs.
+		/// </summary>
+		static glm::vec4 Subtract(const glm::vec4& lhs, const glm::vec4& rhs);
+		/// <summary>
+		/// Component-wise lhs * rhs.
+		/// </summary>
+		static glm::vec4 Multiply(const glm::vec4& lhs, const glm::vec4& rhs);
+		/// <summary>
+		/// Component-wise lhs / rhs.
+		/// </summary>
+		static glm::vec4 Divide(const glm::vec4& lhs, const glm::vec4& rhs);
+		/// <summary>
+		/// Every component of the vector multiplied by the scalar.
+		/// </summary>
+		static glm::vec4 Scale(const glm::vec4& vector, float scalar);
+
+		/// <summary>
+		/// Component-wise lhs + rhs.
+		/// </summary>
+		static glm::mat4 Add(const glm::mat4& lhs, const glm::mat4& rhs);
+		/// <summary>
+		/// Component-wise lhs - rhs.
+		/// </summary>
+		static glm::mat4 Subtract(const glm::mat4& lhs, const glm::mat4& rhs);
+		/// <summary>
+		/// Matrix product lhs * rhs.
+		/// </summary>
+		static glm::mat4 Multiply(const glm::mat4& lhs, const glm::mat4& rhs);
+		/// <summary>
+		/// Vector transformed by the matrix, matrix * vector.
+		/// </summary>
+		static glm::vec4 Multiply(const glm::mat4& matrix, const glm::vec4& vector);
+		/// <summary>
+		/// Every component of the matrix multiplied by the scalar.
+		/// </summary>
+		static glm::mat4 Scale(const glm::mat4& matrix, float scalar);
+
+		/// <summary>
+		/// Element-wise result[i] = lhs[i] + rhs[i] over arrays of count floats. The result may alias either input.
+		/// </summary>
+		static void Add(float* result, const float* lhs, const float* rhs, size_t count);
+		/// <summary>
+		/// Element-wise result[i] = lhs[i] - rhs[i] over arrays of count floats. The result may alias either input.
+		/// </summary>
+		static void Subtract(float* result, const float* lhs, const float* rhs, size_t count);
+		/// <summary>
+		/// Element-wise result[i] = lhs[i] * rhs[i] over arrays of count floats. The result may alias either input.
+		/// </summary>
+		static void Multiply(float* result, const float* lhs, const float* rhs, size_t count);
+		/// <summary>
+		/// Element-wise result[i] = lhs[i] / rhs[i] over arrays of count floats. The result may alias either input.
+		/// </summary>
+		static void Divide(float* result, const float* lhs, const float* rhs, size_t count);
+
+		/// <summary>
+		/// Index of the first of count ints equal to value, comparing four at a time.
+		/// </summary>
+		/// <returns>index of the first match, or count if there is none</returns>
+		static size_t Find(const int* data, size_t count, int value);
+		/// <summary>
+		/// Index of the first of count floats equal (operator==) to value, comparing four at a time.
+		/// </summary>
+		/// <returns>index of the first match, or count if there is none</returns>
+		static size_t Find(const float* data, size_t count, float value);
+		/// <summary>
+		/// Index of the first of count vectors equal (operator==) to value.
+		/// </summary>
+		/// <returns>index of the first match, or count if there is none</returns>
+		static size_t Find(const glm::vec4* data, size_t count, const glm::vec4& value);
+	};
+}
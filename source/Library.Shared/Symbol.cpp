@@ -0,0 +1,186 @@
+#include "pch.h"
+
+#include "Symbol.h"
+
+using namespace std;
+
+namespace FieaGameEngine
+{
+#pragma region Symbol
+	Symbol::Symbol(std::string_view name) :
+		_entry{ name.empty() ? nullptr : SymbolTable::Acquire(name) }
+	{
+	}
+
+	Symbol::Symbol(Entry* entry) :
+		_entry{ entry }
+	{
+		if (_entry != nullptr)
+		{
+			_entry->ReferenceCount.fetch_add(1_z, std::memory_order_relaxed);
+		}
+	}
+
+	Symbol::Symbol(const Symbol& other) :
+		Symbol(other._entry)
+	{
+	}
+
+	Symbol::Symbol(Symbol&& other) noexcept :
+		_entry{ other._entry }
+	{
+		other._entry = nullptr;
+	}
+
+	Symbol& Symbol::operator=(const Symbol& other)
+	{
+		if (_entry != other._entry)
+		{
+			Symbol copy(other);
+			std::swap(_entry, copy._entry);
+		}
+		return *this;
+	}
+
+	Symbol& Symbol::operator=(Symbol&& other) noexcept
+	{
+		if (this != &other)
+		{
+			SymbolTable::Release(_entry);
+			_entry = other._entry;
+			other._entry = nullptr;
+		}
+		return *this;
+	}
+
+	Symbol::~Symbol()
+	{
+		SymbolTable::Release(_entry);
+	}
+
+	const std::string& Symbol::Name() const
+	{
+		static const std::string emptyName;
+		return _entry != nullptr ? _entry->Name : emptyName;
+	}
+
+	bool Symbol::IsEmpty() const
+	{
+		return _entry == nullptr;
+	}
+
+	std::uintptr_t Symbol::Id() const
+	{
+		return reinterpret_cast<std::uintptr_t>(_entry);
+	}
+
+	bool Symbol::operator==(const Symbol& other) const
+	{
+		return _entry == other._entry;
+	}
+
+	bool Symbol::operator!=(const Symbol& other) const
+	{
+		return _entry != other._entry;
+	}
+#pragma endregion
+
+#pragma region SymbolTable
+	Symbol SymbolTable::Intern(std::string_view name)
+	{
+		return Symbol(name);
+	}
+
+	Symbol SymbolTable::Find(std::string_view name)
+	{
+		Symbol symbol;
+		const Key key{ DefaultHash<std::string_view>{}(name), name };
+		Shard& shard = ShardFor(key.Hash);
+		lock_guard<mutex> lock(shard.Mutex);
+		auto it = shard.Symbols.Find(key);
+		if (it != shard.Symbols.end() && TryRetain(it->second))
+		{
+			symbol._entry = it->second;
+		}
+		return symbol;
+	}
+
+	std::uintptr_t SymbolTable::FindId(std::string_view name)
+	{
+		// The entry is only compared by address, so it is not retained. An entry being released here
+		// cannot be the key of any Scope, so returning its Id finds nothing, as it should.
+		const Key key{ DefaultHash<std::string_view>{}(name), name };
+		Shard& shard = ShardFor(key.Hash);
+		lock_guard<mutex> lock(shard.Mutex);
+		auto it = shard.Symbols.Find(key);
+		return it != shard.Symbols.end() ? reinterpret_cast<std::uintptr_t>(it->second) : 0;
+	}
+
+	size_t SymbolTable::Size()
+	{
+		size_t size = 0_z;
+		for (Shard& shard : _shards)
+		{
+			lock_guard<mutex> lock(shard.Mutex);
+			size += shard.Symbols.Size();
+		}
+		return size;
+	}
+
+	SymbolTable::Shard& SymbolTable::ShardFor(size_t hash)
+	{
+		return _shards[hash % _shardCount];
+	}
+
+	Symbol::Entry* SymbolTable::Acquire(std::string_view name)
+	{
+		const Key key{ DefaultHash<std::string_view>{}(name), name };
+		Shard& shard = ShardFor(key.Hash);
+		lock_guard<mutex> lock(shard.Mutex);
+		auto it = shard.Symbols.Find(key);
+		if (it != shard.Symbols.end())
+		{
+			if (TryRetain(it->second))
+			{
+				return it->second;
+			}
+
+			// The entry is being released on another thread, which deletes it once it gets the lock
+			shard.Symbols.Remove(key);
+		}
+
+		// The key views the entry's own copy of the name, so the name is stored once.
+		Symbol::Entry* entry = new Symbol::Entry{ std::string(name), key.Hash, 1_z };
+		shard.Symbols.Insert(std::make_pair(Key{ key.Hash, entry->Name }, entry));
+		return entry;
+	}
+
+	void SymbolTable::Release(Symbol::Entry* entry)
+	{
+		if (entry != nullptr && entry->ReferenceCount.fetch_sub(1_z, std::memory_order_acq_rel) == 1_z)
+		{
+			{
+				const Key key{ entry->Hash, entry->Name };
+				Shard& shard = ShardFor(key.Hash);
+				lock_guard<mutex> lock(shard.Mutex);
+				auto it = shard.Symbols.Find(key);
+				if (it != shard.Symbols.end() && it->second == entry)
+				{
+					shard.Symbols.Remove(key);
+				}
+			}
+			delete entry;
+		}
+	}
+
+	bool SymbolTable::TryRetain(Symbol::Entry* entry)
+	{
+		// A count of 0 means the entry is on its way out and must not be handed out again
+		size_t count = entry->ReferenceCount.load(std::memory_order_relaxed);
+		while (count != 0_z && !entry->ReferenceCount.compare_exchange_weak(count, count + 1_z, std::memory_order_relaxed))
+		{
+		}
+		return count != 0_z;
+	}
+#pragma endregion
+}
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "HashMap.h"
+#include "DefaultHash.h"
+#include "SizeLiteral.h"
+
+namespace FieaGameEngine
+{
+	/// <summary>
+	/// Symbol is a handle to a name interned in the SymbolTable. Two symbols made from equal
+	/// strings share the same table entry, so comparing or hashing symbols is a single pointer
+	/// operation instead of a string compare or hash. Entries are reference counted and leave
+	/// the table once the last Symbol using them is destroyed.
+	/// Symbols may be created, copied and destroyed from several threads at once.
+	/// </summary>
+	class Symbol final
+	{
+		friend class SymbolTable;
+
+	public:
+		/// <summary>
+		/// Constructs an empty symbol that refers to no name.
+		/// </summary>
+		Symbol() = default;
+		/// <summary>
+		/// Interns the given name and constructs a symbol referring to it.
+		/// An empty name makes an empty symbol.
+		/// </summary>
+		/// <param name="name">name to intern</param>
+		explicit Symbol(std::string_view name);
+		/// <summary>
+		/// Copies the symbol, sharing the same table entry.
+		/// </summary>
+		/// <param name="other">symbol to copy</param>
+		Symbol(const Symbol& other);
+		/// <summary>
+		/// Moves the symbol, leaving the other symbol empty.
+		/// </summary>
+		/// <param name="other">symbol to move</param>
+		Symbol(Symbol&& other) noexcept;
+		/// <summary>
+		/// Copy assignment, releases the current entry and shares the other one.
+		/// </summary>
+		/// <param name="other">symbol to copy</param>
+		/// <returns>this symbol</returns>
+		Symbol& operator=(const Symbol& other);
+		/// <summary>
+		/// Move assignment, releases the current entry and takes the other one.
+		/// </summary>
+		/// <param name="other">symbol to move</param>
+		/// <returns>this symbol</returns>
+		Symbol& operator=(Symbol&& other) noexcept;
+		/// <summary>
+		/// Releases the table entry, removing it from the table if this was the last reference.
+		/// </summary>
+		~Symbol();
+
+		/// <summary>
+		/// Name the symbol was interned from.
+		/// </summary>
+		/// <returns>the interned name, or an empty string for an empty symbol</returns>
+		const std::string& Name() const;
+		/// <summary>
+		/// Does the symbol refer to no name?
+		/// </summary>
+		/// <returns>true if the symbol is empty</returns>
+		bool IsEmpty() const;
+		/// <summary>
+		/// Integer handle of the symbol, unique among live symbols. Empty symbols are 0.
+		/// </summary>
+		/// <returns>handle of the symbol</returns>
+		std::uintptr_t Id() const;
+
+		/// <summary>
+		/// Symbols are equal if they refer to the same table entry (and so the same name).
+		/// </summary>
+		/// <param name="other">symbol to compare to</param>
+		/// <returns>true if both symbols refer to the same name</returns>
+		bool operator==(const Symbol& other) const;
+		/// <summary>
+		/// !(operator==(other))
+		/// </summary>
+		/// <param name="other">symbol to compare to</param>
+		/// <returns>true if the symbols refer to different names</returns>
+		bool operator!=(const Symbol& other) const;
+
+	private:
+		struct Entry final
+		{
+			std::string Name;
+			size_t Hash;
+			std::atomic<size_t> ReferenceCount;
+		};
+
+		explicit Symbol(Entry* entry);
+
+		Entry* _entry{ nullptr };
+	};
+
+	/// <summary>
+	/// Global table of interned names. Names are interned once (when a Signature is registered,
+	/// when JSON is loaded or when an attribute is appended) and every later lookup uses the Symbol.
+	/// Names are spread over shards by hash, each with its own lock, so threads interning or looking up
+	/// different names rarely wait on each other.
+	/// </summary>
+	class SymbolTable final
+	{
+		friend class Symbol;
+
+	public:
+		SymbolTable() = delete;
+		SymbolTable(const SymbolTable&) = delete;
+		SymbolTable(SymbolTable&&) = delete;
+		SymbolTable& operator=(const SymbolTable&) = delete;
+		SymbolTable& operator=(SymbolTable&&) = delete;
+		~SymbolTable() = default;
+
+		/// <summary>
+		/// Interns the name, creating its entry if needed. Same as constructing a Symbol.
+		/// </summary>
+		/// <param name="name">name to intern</param>
+		/// <returns>symbol referring to the name</returns>
+		static Symbol Intern(std::string_view name);
+		/// <summary>
+		/// Looks up a name without interning it.
+		/// </summary>
+		/// <param name="name">name to look up</param>
+		/// <returns>symbol referring to the name, or an empty symbol if the name was never interned</returns>
+		static Symbol Find(std::string_view name);
+		/// <summary>
+		/// Looks up the Id of a name without interning it or taking a reference to it, for lookups that
+		/// only compare it against symbols they already hold (e.g. Scope::Find with a string).
+		/// </summary>
+		/// <param name="name">name to look up</param>
+		/// <returns>Id of the symbols for the name, or 0 if the name is not interned</returns>
+		static std::uintptr_t FindId(std::string_view name);
+		/// <summary>
+		/// Number of names currently interned.
+		/// </summary>
+		/// <returns>number of entries in the table</returns>
+		static size_t Size();
+
+	private:
+		// The name is hashed once and the hash picks both the shard and the bucket
+		struct Key final
+		{
+			size_t Hash;
+			std::string_view Name;
+		};
+
+		struct KeyHash final
+		{
+			size_t operator()(const Key& key) const { return key.Hash; }
+		};
+
+		struct KeyEquality final
+		{
+			bool operator()(const Key& lhs, const Key& rhs) const { return lhs.Hash == rhs.Hash && lhs.Name == rhs.Name; }
+		};
+
+		// Copying a Symbol only touches its entry's count and never takes a shard lock.
+		struct alignas(64) Shard final
+		{
+			std::mutex Mutex;
+			HashMap<Key, Symbol::Entry*, KeyHash, KeyEquality> Symbols;
+		};
+
+		static Shard& ShardFor(size_t hash);
+		static Symbol::Entry* Acquire(std::string_view name);
+		static void Release(Symbol::Entry* entry);
+		static bool TryRetain(Symbol::Entry* entry);
+
+		inline static constexpr size_t _shardCount{ 16 };
+		inline static Shard _shards[_shardCount];
+	};
+
+	template <>
+	struct DefaultHash<Symbol>
+	{
+		inline size_t operator()(const Symbol& key) const
+		{
+			return HashInteger(key.Id());
+		}
+	};
+
+	template <>
+	struct DefaultHash<const Symbol>
+	{
+		inline size_t operator()(const Symbol& key) const
+		{
+			return HashInteger(key.Id());
+		}
+	};
+}
@@ -0,0 +1,153 @@
+#include "pch.h"
+
+#include <atomic>
+#include <exception>
+#include <memory>
+
+#include "ThreadPool.h"
+
+using namespace std;
+
+namespace FieaGameEngine
+{
+	namespace
+	{
+		// State of one ParallelFor, shared with the tasks that help with it. Helpers that only start
+		// after the loop is done find no index left and return without touching the caller's body.
+		struct ParallelForBatch final
+		{
+			ParallelForBatch(size_t count, const std::function<void(size_t)>& body) :
+				Count{ count }, Body{ &body }
+			{
+			}
+
+			void Run()
+			{
+				for (size_t index = Next.fetch_add(1_z); index < Count; index = Next.fetch_add(1_z))
+				{
+					try
+					{
+						(*Body)(index);
+					}
+					catch (...)
+					{
+						lock_guard<mutex> lock(Mutex);
+						if (Error == nullptr)
+						{
+							Error = current_exception();
+						}
+					}
+
+					if (Done.fetch_add(1_z) + 1_z == Count)
+					{
+						lock_guard<mutex> lock(Mutex);
+						Finished.notify_all();
+					}
+				}
+			}
+
+			void Wait()
+			{
+				unique_lock<mutex> lock(Mutex);
+				Finished.wait(lock, [this] { return Done.load() == Count; });
+			}
+
+			const size_t Count;
+			const std::function<void(size_t)>* Body;
+			atomic<size_t> Next{ 0 };
+			atomic<size_t> Done{ 0 };
+			mutex Mutex;
+			condition_variable Finished;
+			exception_ptr Error;
+		};
+	}
+
+	ThreadPool::ThreadPool(size_t threadCount)
+	{
+		if (threadCount == 0_z)
+		{
+			throw invalid_argument("Thread count must be greater than 0.");
+		}
+
+		_threads.Reserve(threadCount);
+		for (size_t i = 0_z; i < threadCount; ++i)
+		{
+			_threads.EmplaceBack([this] { Run(); });
+		}
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			lock_guard<mutex> lock(_mutex);
+			_isStopping = true;
+		}
+		_condition.notify_all();
+
+		for (std::thread& thread : _threads)
+		{
+			thread.join();
+		}
+	}
+
+	size_t ThreadPool::ThreadCount() const
+	{
+		return _threads.Size();
+	}
+
+	void ThreadPool::Enqueue(Task task)
+	{
+		{
+			lock_guard<mutex> lock(_mutex);
+			_tasks.PushBack(std::move(task));
+		}
+		_condition.notify_one();
+	}
+
+	void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t)>& body)
+	{
+		if (count == 0_z)
+		{
+			return;
+		}
+
+		auto batch = make_shared<ParallelForBatch>(count, body);
+		const size_t helperCount = std::min(count - 1_z, _threads.Size());
+		for (size_t i = 0_z; i < helperCount; ++i)
+		{
+			Enqueue([batch] { batch->Run(); });
+		}
+
+		batch->Run();
+		batch->Wait();
+
+		if (batch->Error != nullptr)
+		{
+			rethrow_exception(batch->Error);
+		}
+	}
+
+	size_t ThreadPool::DefaultThreadCount()
+	{
+		return std::max(1_z, static_cast<size_t>(std::thread::hardware_concurrency()));
+	}
+
+	void ThreadPool::Run()
+	{
+		while (true)
+		{
+			Task task;
+			{
+				unique_lock<mutex> lock(_mutex);
+				_condition.wait(lock, [this] { return _isStopping || !_tasks.IsEmpty(); });
+				if (_tasks.IsEmpty())
+				{
+					return;
+				}
+				task = std::move(_tasks.Front());
+				_tasks.PopFront();
+			}
+			task();
+		}
+	}
+}
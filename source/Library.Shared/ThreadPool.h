@@ -0,0 +1,74 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "SList.h"
+#include "Vector.h"
+
+namespace FieaGameEngine
+{
+	/// <summary>
+	/// ThreadPool is a fixed set of worker threads that run queued tasks. It is used to split large,
+	/// independent pieces of work (e.g. the subtrees of a Scope, see Scope::CloneParallel) across cores.
+	/// The thread calling ParallelFor works on the loop too and never waits on a queued task, so
+	/// ParallelFor may be called from inside a task without deadlocking the pool.
+	/// </summary>
+	class ThreadPool final
+	{
+	public:
+		using Task = std::function<void()>;
+
+		/// <summary>
+		/// Starts the worker threads.
+		/// </summary>
+		/// <param name="threadCount">number of worker threads, defaults to one per hardware thread</param>
+		/// <exception cref="invalid_argument">Thread count is 0</exception>
+		explicit ThreadPool(size_t threadCount = DefaultThreadCount());
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool(ThreadPool&&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+		ThreadPool& operator=(ThreadPool&&) = delete;
+		/// <summary>
+		/// Runs the tasks still queued, then stops and joins the worker threads.
+		/// </summary>
+		~ThreadPool();
+
+		/// <summary>
+		/// Number of worker threads.
+		/// </summary>
+		/// <returns>number of worker threads</returns>
+		size_t ThreadCount() const;
+
+		/// <summary>
+		/// Queues a task to run on a worker thread.
+		/// </summary>
+		/// <param name="task">task to run</param>
+		void Enqueue(Task task);
+		/// <summary>
+		/// Calls body for every index in [0, count) across the workers and the calling thread, and returns
+		/// once every call has finished. If calls throw, the first exception is rethrown after the rest finish.
+		/// </summary>
+		/// <param name="count">number of indices</param>
+		/// <param name="body">function to call with each index</param>
+		void ParallelFor(size_t count, const std::function<void(size_t)>& body);
+
+		/// <summary>
+		/// One worker per hardware thread, at least one.
+		/// </summary>
+		/// <returns>default number of worker threads</returns>
+		static size_t DefaultThreadCount();
+
+	private:
+		void Run();
+
+		Vector<std::thread> _threads;
+		SList<Task> _tasks;
+		std::mutex _mutex;
+		std::condition_variable _condition;
+		bool _isStopping{ false };
+	};
+}
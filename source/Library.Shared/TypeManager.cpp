@@ -7,24 +7,23 @@ using namespace std;
 
 namespace FieaGameEngine
 {
-	Vector<Signature> TypeManager::GetSignaturesForType(RTTI::IdType typeId)
+	const Vector<Signature>& TypeManager::GetSignaturesForType(RTTI::IdType typeId)
 	{
 		return _signatureMap.At(typeId);
 	}
 
-	const HashMap<RTTI::IdType, Vector<Signature>>& TypeManager::Types()
+	const ConcurrentHashMap<RTTI::IdType, Vector<Signature>>& TypeManager::Types()
 	{
 		return _signatureMap;
 	}
 
 	void TypeManager::AddType(RTTI::IdType typeId, Vector<Signature> signatures)
 	{
-		if (_signatureMap.ContainsKey(typeId))
+		// signatures is only moved from when the type is new
+		if (!_signatureMap.TryEmplace(typeId, std::move(signatures)).second)
 		{
 			throw std::runtime_error("Type already registered");
 		}
-
-		_signatureMap.Insert(make_pair(typeId, std::move(signatures)));
 	}
 
 	void TypeManager::RemoveType(RTTI::IdType typeId)
@@ -34,7 +33,7 @@ namespace FieaGameEngine
 
 	bool TypeManager::ContainsType(RTTI::IdType typeId)
 	{
-		return _signatureMap.Find(typeId) != _signatureMap.end();
+		return _signatureMap.ContainsKey(typeId);
 	}
 
 	void TypeManager::Clear()
@@ -1,22 +1,28 @@
 #pragma once
 
 #include "Attributed.h"
+#include "ConcurrentHashMap.h"
 
 namespace FieaGameEngine
 {
 	/// <summary>
 	/// Signature Struct for FieaGameEngine
+	/// The name is interned when the signature is made, so populating an Attributed never hashes strings.
 	/// </summary>
 	struct Signature final
 	{
-		std::string Name;
+		Signature(std::string_view name, Datum::DatumType type, size_t size, size_t offset) :
+			Name(name), Type(type), Size(size), Offset(offset) { };
+
+		Symbol Name;
 		Datum::DatumType Type;
 		size_t Size;
 		size_t Offset;
 	};
 
 	/// <summary>
-	/// FieaGameEngine's Type Manager, manages all types in the engine at runtime
+	/// FieaGameEngine's Type Manager, manages all types in the engine at runtime.
+	/// Types can be looked up from any thread while others are being added.
 	/// </summary>
 	class TypeManager final
 	{
@@ -33,13 +39,13 @@ namespace FieaGameEngine
 		/// </summary>
 		/// <param name="typeId">typeId to get signatures of</param>
 		/// <returns>Vector of Signatures of type given</returns>
-		static Vector<Signature> GetSignaturesForType(RTTI::IdType typeId);
+		static const Vector<Signature>& GetSignaturesForType(RTTI::IdType typeId);
 
 		/// <summary>
 		/// Returns map of all types in the manager
 		/// </summary>
 		/// <returns>map of types</returns>
-		static const HashMap<RTTI::IdType, Vector<Signature>>& Types();
+		static const ConcurrentHashMap<RTTI::IdType, Vector<Signature>>& Types();
 
 		/// <summary>
 		/// Adds the type to the manager
@@ -49,7 +55,7 @@ namespace FieaGameEngine
 		static void AddType(RTTI::IdType typeId, Vector<Signature> signatures);
 
 		/// <summary>
-		/// Removes type in the manager
+		/// Removes type in the manager. Its signatures stay valid until the next Clear.
 		/// </summary>
 		/// <param name="typeId">typeId to remove from manager</param>
 		static void RemoveType(RTTI::IdType typeId);
@@ -62,12 +68,12 @@ namespace FieaGameEngine
 		static bool ContainsType(RTTI::IdType typeId);
 
 		/// <summary>
-		/// Clears the Manager of all it's types
+		/// Clears the Manager of all it's types. Must not run while another thread is using the manager.
 		/// </summary>
 		static void Clear();
 
 	private:
-		inline static HashMap<RTTI::IdType, Vector<Signature>> _signatureMap;
+		inline static ConcurrentHashMap<RTTI::IdType, Vector<Signature>> _signatureMap;
 	};
 }
 
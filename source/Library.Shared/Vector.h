@@ -4,6 +4,7 @@
 #include "DefaultEquality.h"
 #include "SizeLiteral.h"
 #include <initializer_list>
+#include <utility>
 
 namespace FieaGameEngine
 {
@@ -423,6 +424,14 @@ namespace FieaGameEngine
 		template<typename IncrementFunctor = DefaultIncrement>
 		Iterator PushBack(T&& value, IncrementFunctor incrementFunctor = IncrementFunctor{});
 		/// <summary>
+		/// Constructs an element in place at the back of the vector from the arguments passed in,
+		/// growing with the default increment if there is not enough capacity.
+		/// </summary>
+		/// <param name="args">arguments forwarded to the constructor of T</param>
+		/// <returns>Iterator pointing to the new element</returns>
+		template<typename... Args>
+		Iterator EmplaceBack(Args&&... args);
+		/// <summary>
 		/// removes the last item in the container [vector], but does not reduce the capacity of the container.
 		/// </summary>
 		void PopBack();
@@ -565,6 +574,8 @@ namespace FieaGameEngine
 
 
 	private:
+		void Reallocate(size_t capacity);
+
 		T* _data{ nullptr };
 		size_t _size{ 0_z };
 		size_t _capacity{ 0_z };
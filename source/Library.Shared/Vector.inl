@@ -2,6 +2,7 @@
 
 #include "Vector.h"
 #include <cassert>
+#include <type_traits>
 
 namespace FieaGameEngine
 {
@@ -484,6 +485,21 @@ namespace FieaGameEngine
 		return Iterator(*this, _size++);
 	}
 
+	template<typename T>
+	template<typename... Args>
+	typename Vector<T>::Iterator Vector<T>::EmplaceBack(Args&&... args)
+	{
+		if (_size == _capacity)
+		{
+			size_t capacity = _capacity + std::max(1_z, DefaultIncrement{}(_size, _capacity));
+			Reserve(capacity);
+		}
+
+		new(_data + _size)T(std::forward<Args>(args)...);
+
+		return Iterator(*this, _size++);
+	}
+
 	template<typename T>
 	inline void Vector<T>::PopBack()
 	{
@@ -586,9 +602,7 @@ namespace FieaGameEngine
 	{
 		if (capacity > _capacity)
 		{
-			T* data = reinterpret_cast<T*>(realloc(_data, sizeof(T)* capacity));
-			assert(data != nullptr);
-			_data = data;
+			Reallocate(capacity);
 			_capacity = capacity;
 		}
 	}
@@ -637,14 +651,36 @@ namespace FieaGameEngine
 			}
 			else
 			{
-				T* data = reinterpret_cast<T*>(realloc(_data, sizeof(T) * _size));
-				assert(data != nullptr);
-				_data = data;
+				Reallocate(_size);
 			}
 			_capacity = _size;
 		}
 	}
 
+	template<typename T>
+	inline void Vector<T>::Reallocate(size_t capacity)
+	{
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			T* data = reinterpret_cast<T*>(realloc(_data, sizeof(T) * capacity));
+			assert(data != nullptr);
+			_data = data;
+		}
+		else
+		{
+			// Elements that are not trivially copyable (strings, Datums) are moved, not copied bitwise
+			T* data = reinterpret_cast<T*>(malloc(sizeof(T) * capacity));
+			assert(data != nullptr);
+			for (size_t i = 0_z; i < _size; ++i)
+			{
+				new (data + i)T(std::move(_data[i]));
+				_data[i].~T();
+			}
+			free(_data);
+			_data = data;
+		}
+	}
+
 	template<typename T>
 	template<typename EqualityFunctor>
 	inline typename Vector<T>::Iterator Vector<T>::Find(const T& value, EqualityFunctor equalityFunctor)
@@ -688,7 +724,18 @@ namespace FieaGameEngine
 		if (it != end())
 		{
 			_data[it._index].~T();
-			memmove(_data + it._index, _data + it._index + 1, sizeof(T) * (_size - it._index - 1));
+			if constexpr (std::is_trivially_copyable_v<T>)
+			{
+				memmove(_data + it._index, _data + it._index + 1, sizeof(T) * (_size - it._index - 1));
+			}
+			else
+			{
+				for (size_t i = it._index + 1_z; i < _size; ++i)
+				{
+					new (_data + i - 1)T(std::move(_data[i]));
+					_data[i].~T();
+				}
+			}
 			--_size;
 
 			wasRemoved = true;
@@ -714,7 +761,19 @@ namespace FieaGameEngine
 				_data[it._index].~T();
 			}
 
-			if (last != end()) memmove(_data + first._index, _data + last._index, sizeof(T) * (_size - last._index));
+			if constexpr (std::is_trivially_copyable_v<T>)
+			{
+				if (last != end()) memmove(_data + first._index, _data + last._index, sizeof(T) * (_size - last._index));
+			}
+			else
+			{
+				const size_t count = last._index - first._index;
+				for (size_t i = last._index; i < _size; ++i)
+				{
+					new (_data + i - count)T(std::move(_data[i]));
+					_data[i].~T();
+				}
+			}
 			_size -= last._index - first._index;
 
 			wasRemoved = true;
@@ -19,5 +19,6 @@ namespace FieaGameEngine
 
 	Entity* WorldState::Entity = nullptr;
 	IAction* WorldState::Action = nullptr;
+	ExpressionBatch* WorldState::ExpressionBatch = nullptr;
 	GameTime WorldState::_gameTime;
 }
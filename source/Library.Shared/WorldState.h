@@ -32,6 +32,7 @@ namespace FieaGameEngine
 		
 		static class Entity* Entity; ///< address of Entity currently being processed
 		static class IAction* Action; ///< address of Action currently being processed
+		static class ExpressionBatch* ExpressionBatch; ///< when set, Entities queue their ActionExpressions here instead of updating them, and update it before any other action
 
 		static Vector<IAction*> CreateQueue;
 		static Vector<IAction*> DestroyQueue;
@@ -16,6 +16,7 @@
 #include "ActionList.h"
 #include "ActionIf.h"
 #include "ActionExpression.h"
+#include "ExpressionBatch.h"
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using namespace UnitTests;
@@ -153,6 +154,60 @@ namespace UnitTestLibraryDesktop
 			Assert::ExpectException<exception>([&increment, &worldState] { increment.Update(worldState); });
 		}
 
+		TEST_METHOD(TestActionIncrementCachedTarget)
+		{
+			GameTime gameTime;
+			WorldState worldState(gameTime);
+			Scope root;
+			Datum& rootA = root.Append("A"s);
+			rootA = 0;
+
+			ActionIncrement* increment = new ActionIncrement;
+			root.Adopt(*increment, "Actions"s);
+			increment->SetTarget("A"s);
+
+			// Repeated updates reuse the cached target without changing the generations it was found with
+			const auto rootGeneration = root.Generation();
+			const auto incrementGeneration = increment->Generation();
+			increment->Update(worldState);
+			increment->Update(worldState);
+			Assert::AreEqual(2, rootA.GetInteger());
+			Assert::IsTrue(rootGeneration == root.Generation());
+			Assert::IsTrue(incrementGeneration == increment->Generation());
+
+			// Creating and destroying unrelated Scopes leaves the cached target valid
+			{
+				Scope unrelated;
+				unrelated.Append("A"s) = 100;
+			}
+			increment->Update(worldState);
+			Assert::AreEqual(3, rootA.GetInteger());
+			Assert::IsTrue(rootGeneration == root.Generation());
+			Assert::IsTrue(incrementGeneration == increment->Generation());
+
+			// Appending a closer "A" invalidates the cached target
+			Datum& localA = increment->AppendAuxiliaryAttribute("A"s);
+			localA = 10;
+			increment->Update(worldState);
+			Assert::AreEqual(11, localA.GetInteger());
+			Assert::AreEqual(3, rootA.GetInteger());
+
+			// Copies search from their own scope
+			ActionIncrement copy(*increment);
+			copy.Update(worldState);
+			Assert::AreEqual(12, copy["A"s].GetInteger());
+			Assert::AreEqual(11, localA.GetInteger());
+
+			// Orphaning invalidates the cached target
+			increment->SetTarget("B"s);
+			root.Append("B"s) = 0;
+			increment->Update(worldState);
+			Assert::AreEqual(1, root["B"s].GetInteger());
+			increment->Orphan();
+			Assert::ExpectException<exception>([&increment, &worldState] { increment->Update(worldState); });
+			delete increment;
+		}
+
 		TEST_METHOD(TestActionIf)
 		{
 			GameTime gameTime;
@@ -307,6 +362,252 @@ namespace UnitTestLibraryDesktop
 			}
 		}
 
+		TEST_METHOD(TestActionExpressionCompile)
+		{
+			GameTime gameTime;
+			WorldState worldState(gameTime);
+
+			ActionExpression actionExpression;
+			actionExpression.Append("A"s) = 7;
+			actionExpression.Append("B"s) = 5;
+
+			// Malformed expressions are rejected when they are set
+			Assert::ExpectException<runtime_error>([&actionExpression] { actionExpression.SetExpression("( A + B"s); });
+			Assert::ExpectException<runtime_error>([&actionExpression] { actionExpression.SetExpression("A + B )"s); });
+			Assert::ExpectException<runtime_error>([&actionExpression] { actionExpression.SetExpression("A +"s); });
+
+			// Unknown attributes are only known when updating
+			actionExpression.SetExpression("A + C"s);
+			Assert::ExpectException<runtime_error>([&actionExpression, &worldState] { actionExpression.Update(worldState); });
+
+			actionExpression.SetExpression("A - B - B"s);
+			actionExpression.Update(worldState);
+			Assert::AreEqual(-3, actionExpression.Result());
+			actionExpression.Update(worldState);
+			Assert::AreEqual(-3, actionExpression.Result());
+
+			// Expressions written through the Datum (e.g. loaded from Json) are compiled by the first Update
+			ActionExpression loaded;
+			loaded.Append("A"s) = 7;
+			loaded.Append("B"s) = 5;
+			loaded["Expression"s] = "A + B * B"s;
+			loaded.Update(worldState);
+			Assert::AreEqual(32, loaded.Result());
+
+			actionExpression.SetExpression("A + B * B"s);
+			actionExpression.Update(worldState);
+			Assert::AreEqual(32, actionExpression.Result());
+
+			// Copies evaluate against their own attributes
+			ActionExpression copy(actionExpression);
+			copy["B"s] = 1;
+			copy.Update(worldState);
+			Assert::AreEqual(8, copy.Result());
+			actionExpression.Update(worldState);
+			Assert::AreEqual(32, actionExpression.Result());
+		}
+
+		TEST_METHOD(TestActionExpressionTypes)
+		{
+			GameTime gameTime;
+			WorldState worldState(gameTime);
+
+			ActionExpression actionExpression;
+			actionExpression.Append("I"s) = 3;
+			Datum& f = actionExpression.Append("F"s);
+			f = 1.5f;
+			Datum& v = actionExpression.Append("V"s);
+			v = vec4(1.0f, 2.0f, 3.0f, 4.0f);
+			actionExpression.Append("W"s) = vec4(2.0f);
+			mat4 translation(2.0f);
+			translation[3] = vec4(10.0f, 20.0f, 30.0f, 1.0f);
+			actionExpression.Append("M"s) = translation;
+			actionExpression.Append("Identity"s) = mat4(1.0f);
+			actionExpression.Append("S"s) = "Not a number"s;
+
+			// Integers mixed with floats are promoted
+			actionExpression.SetExpression("I + F"s);
+			actionExpression.Update(worldState);
+			Assert::IsTrue(Datum::DatumType::Float == actionExpression.ResultType());
+			Assert::AreEqual(4.5f, actionExpression.FloatResult());
+			Assert::ExpectException<runtime_error>([&actionExpression] { actionExpression.Result(); });
+
+			actionExpression.SetExpression("V + W * I"s);
+			actionExpression.Update(worldState);
+			Assert::IsTrue(vec4(7.0f, 8.0f, 9.0f, 10.0f) == actionExpression.VectorResult());
+
+			actionExpression.SetExpression("V / W"s);
+			actionExpression.Update(worldState);
+			Assert::IsTrue(vec4(0.5f, 1.0f, 1.5f, 2.0f) == actionExpression.VectorResult());
+
+			actionExpression.SetExpression("M * V"s);
+			actionExpression.Update(worldState);
+			Assert::IsTrue(translation * vec4(1.0f, 2.0f, 3.0f, 4.0f) == actionExpression.VectorResult());
+
+			actionExpression.SetExpression("M * Identity * F"s);
+			actionExpression.Update(worldState);
+			Assert::IsTrue(translation * 1.5f == actionExpression.MatrixResult());
+
+			actionExpression.SetExpression("V == V"s);
+			actionExpression.Update(worldState);
+			Assert::AreEqual(1, actionExpression.Result());
+
+			actionExpression.SetExpression("F += I"s);
+			actionExpression.Update(worldState);
+			Assert::AreEqual(4.5f, f.GetFloat());
+
+			actionExpression.SetExpression("V *= I"s);
+			actionExpression.Update(worldState);
+			Assert::IsTrue(vec4(3.0f, 6.0f, 9.0f, 12.0f) == v.GetVector());
+
+			// Operand types are checked when updating
+			actionExpression.SetExpression("I = F"s);
+			Assert::ExpectException<runtime_error>([&actionExpression, &worldState] { actionExpression.Update(worldState); });
+			actionExpression.SetExpression("V + M"s);
+			Assert::ExpectException<runtime_error>([&actionExpression, &worldState] { actionExpression.Update(worldState); });
+			actionExpression.SetExpression("I + S"s);
+			Assert::ExpectException<runtime_error>([&actionExpression, &worldState] { actionExpression.Update(worldState); });
+		}
+
+		TEST_METHOD(TestExpressionBatch)
+		{
+			GameTime gameTime;
+			WorldState worldState(gameTime);
+			Entity entity;
+			entity.Append("Scale"s) = 0.5f;
+			entity.Append("Total"s) = 0;
+
+			const int count = 10;
+			for (int i = 0; i < count; ++i)
+			{
+				ActionExpression* action = new ActionExpression;
+				entity.Adopt(*action, "Actions"s);
+				action->Append("A"s) = static_cast<float>(i);
+				action->Append("B"s) = i;
+				action->SetExpression("A += B * Scale"s);
+			}
+
+			// These share their target, so they are updated one at a time
+			for (int i = 1; i <= 3; ++i)
+			{
+				ActionExpression* action = new ActionExpression;
+				entity.Adopt(*action, "Actions"s);
+				action->Append("B"s) = i;
+				action->SetExpression("Total += B"s);
+			}
+
+			// Same program as "A += B * Scale", with other attributes
+			for (int i = 1; i <= 2; ++i)
+			{
+				ActionExpression* action = new ActionExpression;
+				entity.Adopt(*action, "Actions"s);
+				action->Append("C"s) = 1.0f;
+				action->Append("D"s) = i;
+				action->SetExpression("C += D * Scale"s);
+			}
+
+			ExpressionBatch batch;
+			worldState.ExpressionBatch = &batch;
+			entity.Update(worldState);
+			Assert::AreEqual(static_cast<size_t>(count + 5), batch.Size());
+			Assert::AreEqual(1.0f, entity.Actions()[1]["A"s].GetFloat());
+
+			batch.Update(worldState);
+			Assert::IsTrue(batch.IsEmpty());
+			Assert::AreEqual(6, entity["Total"s].GetInteger());
+			Assert::AreEqual(1.5f, entity.Actions()[count + 3]["C"s].GetFloat());
+			Assert::AreEqual(2.0f, entity.Actions()[count + 4]["C"s].GetFloat());
+			for (int i = 0; i < count; ++i)
+			{
+				ActionExpression* action = entity.Actions()[i].As<ActionExpression>();
+				Assert::AreEqual(i * 1.5f, (*action)["A"s].GetFloat());
+				Assert::AreEqual(i * 1.5f, action->FloatResult());
+			}
+
+			// Updating one at a time gives the same results
+			worldState.ExpressionBatch = nullptr;
+			entity.Update(worldState);
+			Assert::AreEqual(12, entity["Total"s].GetInteger());
+			for (int i = 0; i < count; ++i)
+			{
+				Assert::AreEqual(i * 2.0f, entity.Actions()[i]["A"s].GetFloat());
+			}
+
+			// Type errors are reported as if the actions were updated one at a time
+			ActionExpression first;
+			first.Append("I"s) = 1;
+			first.Append("F"s) = 1.0f;
+			first.SetExpression("I = F"s);
+			ActionExpression second(first);
+			batch.Add(first);
+			batch.Add(second);
+			Assert::ExpectException<runtime_error>([&batch, &worldState] { batch.Update(worldState); });
+			Assert::IsTrue(batch.IsEmpty());
+
+			ActionExpression empty;
+			Assert::ExpectException<runtime_error>([&batch, &empty] { batch.Add(empty); });
+		}
+
+		TEST_METHOD(TestExpressionBatchOrder)
+		{
+			GameTime gameTime;
+			WorldState worldState(gameTime);
+			ExpressionBatch batch;
+			worldState.ExpressionBatch = &batch;
+
+			// The increment reads what the expression before it assigns
+			Entity entity;
+			entity.Append("Health"s) = 10;
+			entity.Append("Damage"s) = 3;
+			ActionExpression* damage = new ActionExpression;
+			entity.Adopt(*damage, "Actions"s);
+			damage->SetExpression("Health = Damage"s);
+			ActionIncrement* increment = new ActionIncrement;
+			entity.Adopt(*increment, "Actions"s);
+			increment->SetTarget("Health"s);
+			for (int i = 0; i < 2; ++i)
+			{
+				ActionExpression* action = new ActionExpression;
+				entity.Adopt(*action, "Actions"s);
+				action->Append("A"s) = 1.0f;
+				action->Append("B"s) = 2.0f;
+				action->SetExpression("A += B"s);
+			}
+
+			entity.Update(worldState);
+			Assert::AreEqual(4, entity["Health"s].GetInteger());
+			Assert::AreEqual(3, damage->Result());
+			Assert::IsTrue(worldState.Action == increment);
+			Assert::AreEqual(2_z, batch.Size());
+
+			batch.Update(worldState);
+			Assert::IsTrue(worldState.Action == entity.Actions()[3].As<IAction>());
+			Assert::AreEqual(3.0f, entity.Actions()[2]["A"s].GetFloat());
+			Assert::AreEqual(3.0f, entity.Actions()[3]["A"s].GetFloat());
+
+			// One group reads what another assigns, so they are updated in the order queued
+			Entity other;
+			other.Append("X"s) = 0;
+			other.Append("Y"s) = -1;
+			other.Append("One"s) = 1;
+			const char* expressions[] = { "X += One", "Y = X", "X += One" };
+			for (const char* expression : expressions)
+			{
+				ActionExpression* action = new ActionExpression;
+				other.Adopt(*action, "Actions"s);
+				action->SetExpression(expression);
+			}
+
+			other.Update(worldState);
+			Assert::AreEqual(3_z, batch.Size());
+			batch.Update(worldState);
+			Assert::AreEqual(2, other["X"s].GetInteger());
+			Assert::AreEqual(1, other["Y"s].GetInteger());
+			Assert::IsTrue(worldState.Action == other.Actions()[2].As<IAction>());
+
+			worldState.ExpressionBatch = nullptr;
+		}
+
 		TEST_METHOD(TestJsonDeserialization)
 		{
 			ActionIncrementFactory actionIncrementFactory;
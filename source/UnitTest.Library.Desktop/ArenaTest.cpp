@@ -0,0 +1,98 @@
+#include "pch.h"
+
+#include <CppUnitTest.h>
+#include <crtdbg.h>
+#include <cstdint>
+#include <exception>
+#include <string>
+
+#include "Arena.h"
+#include "Scope.h"
+#include "ToStringSpecialization.h"
+#include "SizeLiteral.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace UnitTests;
+using namespace FieaGameEngine;
+using namespace std;
+using namespace std::string_literals;
+
+namespace UnitTestLibraryDesktop
+{
+	TEST_CLASS(ArenaTest)
+	{
+	public:
+
+		TEST_METHOD_INITIALIZE(Initialize)
+		{
+#ifdef _DEBUG
+			_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF);
+			_CrtMemCheckpoint(&_startMemState);
+#endif
+		}
+
+		TEST_METHOD_CLEANUP(CleanUp)
+		{
+#ifdef _DEBUG
+			_CrtMemState endMemState, diffMemState;
+			_CrtMemCheckpoint(&endMemState);
+			if (_CrtMemDifference(&diffMemState, &_startMemState, &endMemState)) {
+				_CrtMemDumpStatistics(&diffMemState);
+				Assert::Fail(L"Memory Leaks!");
+			}
+#endif
+		}
+
+		TEST_METHOD(TestArenaScopes)
+		{
+			Arena arena(1024_z);
+			Assert::AreEqual(0_z, arena.Capacity());
+			Assert::ExpectException<runtime_error>([] { Arena empty(0_z); }, L"Expected an exception but none was thrown");
+
+			void* small = arena.Allocate(10_z);
+			void* aligned = arena.Allocate(32_z, 64_z);
+			Assert::IsNotNull(small);
+			Assert::AreEqual(0_z, reinterpret_cast<std::uintptr_t>(aligned) % 64_z);
+			arena.Allocate(4096_z);
+			Assert::IsTrue(arena.Capacity() >= 4096_z + 1024_z);
+			arena.Reset();
+			Assert::AreEqual(0_z, arena.Size());
+
+			{
+				Scope root(arena);
+				Assert::IsTrue(root.GetArena() == &arena);
+				for (int i = 0; i < 100; ++i)
+				{
+					Scope& child = root.AppendScope("Children"s);
+					child["Name"s] = "A name long enough to need its own buffer "s + to_string(i);
+					child["Values"s] = Datum{ 1, 2, 3, 4, 5, 6, 7, 8 };
+					child.AppendScope("Inventory"s)["Gold"s] = i;
+					Assert::IsTrue(child.GetArena() == &arena);
+				}
+				Assert::IsTrue(arena.Size() > 0_z);
+
+				// Copies of arena scopes are heap scopes unless assigned into an arena scope
+				Scope copy(root);
+				Assert::IsNull(copy.GetArena());
+				Assert::IsTrue(copy == root);
+
+				Scope arenaCopy(arena);
+				arenaCopy = copy;
+				Assert::IsTrue(arenaCopy == root);
+				Assert::IsTrue(arenaCopy["Children"s].GetScope(50).GetArena() == &arena);
+
+				// Heap scopes can be adopted and are deleted as usual
+				Scope* adopted = new Scope;
+				root.Adopt(*adopted, "Adopted"s);
+				Assert::AreEqual(2_z, root.Size());
+			}
+			arena.Reset();
+			Assert::AreEqual(0_z, arena.Size());
+		}
+
+	private:
+		static _CrtMemState _startMemState;
+	};
+
+	_CrtMemState ArenaTest::_startMemState;
+}
@@ -0,0 +1,147 @@
+#include "pch.h"
+
+#include <CppUnitTest.h>
+#include <atomic>
+#include <crtdbg.h>
+#include <exception>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "ConcurrentHashMap.h"
+#include "Vector.h"
+#include "ToStringSpecialization.h"
+#include "SizeLiteral.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace UnitTests;
+using namespace FieaGameEngine;
+using namespace std;
+using namespace std::string_literals;
+
+namespace UnitTestLibraryDesktop
+{
+	TEST_CLASS(ConcurrentHashMapTest)
+	{
+	public:
+
+		TEST_METHOD_INITIALIZE(Initialize)
+		{
+#ifdef _DEBUG
+			_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF);
+			_CrtMemCheckpoint(&_startMemState);
+#endif
+		}
+
+		TEST_METHOD_CLEANUP(CleanUp)
+		{
+#ifdef _DEBUG
+			_CrtMemState endMemState, diffMemState;
+			_CrtMemCheckpoint(&endMemState);
+			if (_CrtMemDifference(&diffMemState, &_startMemState, &endMemState)) {
+				_CrtMemDumpStatistics(&diffMemState);
+				Assert::Fail(L"Memory Leaks!");
+			}
+#endif
+		}
+
+		TEST_METHOD(TestConcurrentInsertAndFind)
+		{
+			Assert::ExpectException<runtime_error>([] { ConcurrentHashMap<int, int> empty(0_z); }, L"Expected an exception but none was thrown");
+
+			ConcurrentHashMap<int, int> map;
+			const size_t startBucketSize = map.BucketSize();
+			auto [first, wasInserted] = map.TryEmplace(-1, 10);
+			Assert::IsTrue(wasInserted);
+			Assert::IsFalse(map.TryEmplace(-1, 20).second);
+			Assert::AreEqual(10, map.At(-1));
+
+			// Writers grow their shards while readers keep finding what was already published
+			constexpr int writerCount = 4;
+			constexpr int keysPerWriter = 2000;
+			atomic<bool> done{ false };
+			atomic<size_t> misses{ 0_z };
+			Vector<thread> threads;
+			threads.Reserve(writerCount + 2_z);
+			for (int reader = 0; reader < 2; ++reader)
+			{
+				threads.EmplaceBack([&map, &done, &misses]
+				{
+					while (!done.load())
+					{
+						const auto* entry = map.Find(-1);
+						if (entry == nullptr || entry->second != 10)
+						{
+							++misses;
+						}
+						for (int key = 0; key < writerCount * keysPerWriter; key += 97)
+						{
+							entry = map.Find(key);
+							if (entry != nullptr && entry->second != key * 2)
+							{
+								++misses;
+							}
+						}
+					}
+				});
+			}
+			for (int writer = 0; writer < writerCount; ++writer)
+			{
+				threads.EmplaceBack([&map, writer]
+				{
+					for (int key = writer; key < writerCount * keysPerWriter; key += writerCount)
+					{
+						map.Insert(make_pair(key, key * 2));
+					}
+				});
+			}
+			for (size_t i = 2_z; i < threads.Size(); ++i)
+			{
+				threads[i].join();
+			}
+			done = true;
+			threads[0].join();
+			threads[1].join();
+
+			Assert::AreEqual(0_z, misses.load());
+			Assert::AreEqual(static_cast<size_t>(writerCount * keysPerWriter + 1), map.Size());
+			Assert::IsTrue(map.BucketSize() > startBucketSize);
+			Assert::IsTrue(first == map.Find(-1));
+			for (int key = 0; key < writerCount * keysPerWriter; ++key)
+			{
+				Assert::AreEqual(key * 2, map.At(key));
+			}
+
+			// Removed entries stay readable until reclaimed
+			const auto* removed = map.Find(7);
+			map.Remove(7);
+			Assert::IsFalse(map.ContainsKey(7));
+			Assert::AreEqual(14, removed->second);
+			map.Reclaim();
+			Assert::ExpectException<runtime_error>([&map] { map.At(7); }, L"Expected an exception but none was thrown");
+
+			map.Resize(64_z);
+			Assert::AreEqual(64_z, map.BucketSize());
+			Assert::IsTrue(first == map.Find(-1));
+			size_t count = 0_z;
+			map.ForEach([&count](const auto&) { ++count; });
+			Assert::AreEqual(map.Size(), count);
+
+			map.Clear();
+			Assert::IsTrue(map.IsEmpty());
+			Assert::IsNull(map.Find(-1));
+			map[3] = 9;
+			Assert::AreEqual(9, map.At(3));
+
+			ConcurrentHashMap<string, int> names = { { "Alpha"s, 1 }, { "Beta"s, 2 } };
+			Assert::AreEqual(2, names.Find("Beta"sv)->second);
+			Assert::IsTrue(names.ContainsKey("Alpha"));
+			Assert::IsNull(names.Find("Gamma"sv));
+		}
+
+	private:
+		static _CrtMemState _startMemState;
+	};
+
+	_CrtMemState ConcurrentHashMapTest::_startMemState;
+}
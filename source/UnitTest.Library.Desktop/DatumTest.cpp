@@ -4,6 +4,10 @@
 #include <crtdbg.h>
 #include <exception>
 #include <initializer_list>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
 #include <glm/gtx/string_cast.hpp>
 
 #include "Foo.h"
@@ -1688,6 +1692,352 @@ namespace UnitTestLibraryDesktop
 			}
 		}
 
+		TEST_METHOD(TestBulkAccess)
+		{
+			{
+				Datum datum;
+				const vector<int> values{ 1, 2, 3 };
+				datum.Append(values);
+				Assert::IsTrue(Datum::DatumType::Integer == datum.Type());
+				Assert::AreEqual(3_z, datum.Size());
+
+				// Ranges may view the datum itself
+				datum.Append(datum.Integers());
+				Assert::AreEqual(6_z, datum.Size());
+				Assert::AreEqual(3, datum.GetInteger(5));
+
+				int sum = 0;
+				for (int value : datum.Integers())
+				{
+					sum += value;
+				}
+				Assert::AreEqual(12, sum);
+
+				datum.Fill(7);
+				for (int value : std::as_const(datum).Integers())
+				{
+					Assert::AreEqual(7, value);
+				}
+
+				datum.Assign(datum.Integers().subspan(0, 2));
+				Assert::AreEqual(2_z, datum.Size());
+				datum.Assign(values);
+				Assert::AreEqual(3_z, datum.Size());
+				Assert::AreEqual(3, datum.BackInteger());
+
+				Assert::ExpectException<runtime_error>([&datum] { datum.Floats(); }, L"Expected an exception but none was thrown");
+				Assert::ExpectException<runtime_error>([&datum] { datum.Append(span<const float>()); }, L"Expected an exception but none was thrown");
+				Assert::ExpectException<runtime_error>([&datum] { datum.Assign(span<const float>()); }, L"Expected an exception but none was thrown");
+				Assert::AreEqual(3_z, datum.Size());
+			}
+
+			{
+				Datum datum;
+				const vector<string> values{ "a"s, "b"s };
+				datum.Append(values);
+				datum.Append(datum.Strings());
+				Assert::AreEqual(4_z, datum.Size());
+				Assert::AreEqual("b"s, datum.GetString(3));
+				datum.Assign(datum.Strings().subspan(2, 1));
+				Assert::AreEqual(1_z, datum.Size());
+				Assert::AreEqual("a"s, datum.GetString());
+				datum.Fill("c"s);
+				Assert::AreEqual("c"s, datum.GetString());
+			}
+
+			{
+				float storage[4]{};
+				Datum datum;
+				datum.SetStorage(storage, 4);
+				datum.Fill(2.0f);
+				Assert::AreEqual(2.0f, storage[3]);
+				Assert::ExpectException<runtime_error>([&datum, &storage] { datum.Append(span<const float>(storage, 1)); }, L"Expected an exception but none was thrown");
+			}
+		}
+
+		TEST_METHOD(TestRemoveAll)
+		{
+			Datum integers = { 1, 2, 3, 2, 4, 2, 5, 6, 2 };
+			Assert::AreEqual(1_z, integers.IndexOf(2));
+			Assert::AreEqual(integers.Size(), integers.IndexOf(2, [](const int&, const int&) { return false; }));
+			Assert::AreEqual(7_z, integers.IndexOf(6));
+			Assert::AreEqual(4_z, integers.RemoveAll(2));
+			Assert::AreEqual(5_z, integers.Size());
+			Assert::IsTrue(integers == Datum{ 1, 3, 4, 5, 6 });
+			Assert::AreEqual(0_z, integers.RemoveAll(2));
+			Assert::AreEqual(5_z, integers.IndexOf(2));
+
+			Datum floats = { 0.5f, 1.5f, 0.5f, 2.5f, 3.5f };
+			Assert::AreEqual(3_z, floats.IndexOf(2.5f));
+			Assert::AreEqual(2_z, floats.RemoveAll(0.5f));
+			Assert::IsTrue(floats == Datum{ 1.5f, 2.5f, 3.5f });
+
+			Datum vectors = { vec4(1.0f), vec4(2.0f), vec4(1.0f) };
+			Assert::AreEqual(1_z, vectors.IndexOf(vec4(2.0f)));
+			Assert::AreEqual(2_z, vectors.RemoveAll(vec4(1.0f)));
+			Assert::IsTrue(vectors == vec4(2.0f));
+
+			Assert::ExpectException<runtime_error>([&integers] { integers.RemoveAll(1.0f); }, L"Expected an exception but none was thrown");
+			int storage[2]{};
+			Datum external;
+			external.SetStorage(storage, 2);
+			Assert::ExpectException<runtime_error>([&external] { external.RemoveAll(0); }, L"Expected an exception but none was thrown");
+		}
+
+		TEST_METHOD(TestGrowthAndShrinkToFit)
+		{
+			{
+				Datum datum(Datum::DatumType::String);
+				for (int i = 0; i < 50; ++i)
+				{
+					datum.PushBack(to_string(i));
+				}
+				Assert::AreEqual("0"s, datum.FrontString());
+				Assert::AreEqual("49"s, datum.BackString());
+
+				datum.Resize(2);
+				datum.ShrinkToFit();
+				Assert::AreEqual(2_z, datum.Capacity());
+				Assert::AreEqual("1"s, datum.BackString());
+
+				datum.Resize(1);
+				datum.ShrinkToFit();
+				Assert::AreEqual(1_z, datum.Capacity());
+				Assert::AreEqual("0"s, datum.GetString());
+
+				datum.Clear();
+				datum.ShrinkToFit();
+				Assert::AreEqual(0_z, datum.Capacity());
+				datum.PushBack("again"s);
+				Assert::AreEqual("again"s, datum.GetString());
+			}
+
+			{
+				Datum datum = 1;
+				datum.Reserve(100);
+				Assert::AreEqual(100_z, datum.Capacity());
+				datum.ShrinkToFit();
+				Assert::AreEqual(1_z, datum.Capacity());
+				Assert::AreEqual(1, datum.GetInteger());
+
+				int storage[2]{};
+				Datum external;
+				external.SetStorage(storage, 2);
+				Assert::ExpectException<runtime_error>([&external] { external.ShrinkToFit(); }, L"Expected an exception but none was thrown");
+			}
+
+			// Removing from a Vector moves the Datums after the gap, so inline ones keep their own buffer
+			{
+				Vector<Datum> datums;
+				for (int i = 0; i < 6; ++i)
+				{
+					datums.PushBack(Datum(i));
+				}
+				datums.PushBack(Datum("inline"s));
+
+				Assert::IsTrue(datums.Remove(datums.begin()));
+				Assert::IsTrue(datums.Remove(datums.begin() + 1, datums.begin() + 3));
+				Assert::AreEqual(4_z, datums.Size());
+				Assert::AreEqual(1, datums[0].GetInteger());
+				Assert::AreEqual(4, datums[1].GetInteger());
+				Assert::AreEqual(5, datums[2].GetInteger());
+				Assert::AreEqual("inline"s, datums[3].GetString());
+
+				datums[1].PushBack(40);
+				datums[3].Set("changed"s);
+				Assert::AreEqual(5, datums[2].GetInteger());
+				Assert::AreEqual(40, datums[1].BackInteger());
+				Assert::AreEqual("changed"s, datums[3].GetString());
+			}
+		}
+
+		TEST_METHOD(TestInlineStorage)
+		{
+			// Scalars live inside the Datum and survive moves
+			{
+				Datum datum = 5;
+				Datum moved(std::move(datum));
+				Assert::AreEqual(5, moved.GetInteger());
+				Assert::AreEqual(0_z, datum.Size());
+
+				for (int i = 0; i < 32; ++i)
+				{
+					moved.PushBack(i);
+				}
+				Assert::AreEqual(33_z, moved.Size());
+				Assert::AreEqual(5, moved.GetInteger());
+				Assert::AreEqual(31, moved.BackInteger());
+
+				Datum assigned;
+				assigned = std::move(moved);
+				Assert::AreEqual(5, assigned.FrontInteger());
+				Assert::AreEqual(31, assigned.BackInteger());
+			}
+
+			{
+				const string longString(64, 'a');
+				Datum datum = "short"s;
+				Datum copy(datum);
+				Datum moved(std::move(datum));
+				Assert::AreEqual("short"s, moved.GetString());
+				Assert::IsTrue(copy == moved);
+
+				moved.PushBack(longString);
+				moved.PushBack("third"s);
+				Assert::AreEqual("short"s, moved.GetString(0));
+				Assert::AreEqual(longString, moved.GetString(1));
+				Assert::AreEqual("third"s, moved.GetString(2));
+
+				Datum assigned;
+				assigned = std::move(copy);
+				Assert::AreEqual("short"s, assigned.GetString());
+				assigned.RemoveAt(0);
+				assigned.PushBack(longString);
+				Assert::AreEqual(longString, assigned.GetString());
+			}
+
+			{
+				Datum datum = vec4(1.0f);
+				datum.PushBack(vec4(2.0f));
+				datum.PushBack(vec4(3.0f));
+				Assert::IsTrue(vec4(1.0f) == datum.FrontVector());
+				Assert::IsTrue(vec4(3.0f) == datum.BackVector());
+
+				Datum matrix = mat4(1.0f);
+				Datum moved(std::move(matrix));
+				Assert::IsTrue(mat4(1.0f) == moved.GetMatrix());
+			}
+		}
+
+		TEST_METHOD(TestToCharsAndFromChars)
+		{
+			char buffer[256];
+			{
+				Datum datum = -42;
+				Assert::AreEqual(datum.ToString(), string(buffer, datum.ToChars(buffer, sizeof(buffer))));
+				datum.FromChars(" +17 ");
+				Assert::AreEqual(17, datum.GetInteger());
+				datum.PushBackFromChars("-3");
+				Assert::AreEqual(-3, datum.BackInteger());
+				Assert::ExpectException<runtime_error>([&datum] { datum.FromChars(""); }, L"Expected an exception but none was thrown");
+				Assert::ExpectException<runtime_error>([&datum] { datum.FromChars("abc"); }, L"Expected an exception but none was thrown");
+				Assert::ExpectException<runtime_error>([&datum] { datum.FromChars("--1"); }, L"Expected an exception but none was thrown");
+
+				// Same input as sscanf's "%i": base prefixes, and reading stops after the number
+				datum.FromChars("12abc");
+				Assert::AreEqual(12, datum.GetInteger());
+				datum.FromChars("0x10");
+				Assert::AreEqual(16, datum.GetInteger());
+				datum.FromChars("-0X1f");
+				Assert::AreEqual(-31, datum.GetInteger());
+				datum.FromChars("010");
+				Assert::AreEqual(8, datum.GetInteger());
+				datum.FromChars("0x");
+				Assert::AreEqual(0, datum.GetInteger());
+				datum.SetFromString("-2147483648"s);
+				Assert::AreEqual(numeric_limits<int>::min(), datum.GetInteger());
+				Assert::ExpectException<runtime_error>([&datum, &buffer] { datum.ToChars(buffer, 1_z, 1_z); }, L"Expected an exception but none was thrown");
+			}
+
+			{
+				Datum datum = 2.5f;
+				Assert::AreEqual("2.500000"s, string(buffer, datum.ToChars(buffer, sizeof(buffer))));
+				datum.FromChars("0.125");
+				Assert::AreEqual(0.125f, datum.GetFloat());
+				datum.FromChars(" -1.5f");
+				Assert::AreEqual(-1.5f, datum.GetFloat());
+				datum.FromChars("0x1p3");
+				Assert::AreEqual(8.0f, datum.GetFloat());
+				Assert::ExpectException<runtime_error>([&datum] { datum.FromChars("f"); }, L"Expected an exception but none was thrown");
+			}
+
+			{
+				Datum datum = vec4(1.0f, -2.5f, 3.0f, 0.25f);
+				const string text(buffer, datum.ToChars(buffer, sizeof(buffer)));
+				Assert::AreEqual(glm::to_string(datum.GetVector()), text);
+				datum.PushBackFromChars(text);
+				Assert::IsTrue(datum.FrontVector() == datum.BackVector());
+				Assert::ExpectException<runtime_error>([&datum] { datum.FromChars("vec4(1, 2, 3)"); }, L"Expected an exception but none was thrown");
+			}
+
+			{
+				mat4 matrix(1.0f);
+				matrix[3] = vec4(5.0f, 6.0f, 7.0f, 1.0f);
+				Datum datum = matrix;
+				const string text(buffer, datum.ToChars(buffer, sizeof(buffer)));
+				Assert::AreEqual(glm::to_string(matrix), text);
+				datum.Set(mat4(0.0f));
+				datum.FromChars(text);
+				Assert::IsTrue(matrix == datum.GetMatrix());
+			}
+
+			{
+				Datum datum = "Hello"s;
+				Assert::AreEqual(5_z, datum.ToChars(buffer, sizeof(buffer)));
+				datum.FromChars("World");
+				Assert::AreEqual("World"s, datum.GetString());
+
+				Foo foo;
+				Datum pointers = &foo;
+				Assert::ExpectException<runtime_error>([&pointers] { pointers.FromChars("Foo"); }, L"Expected an exception but none was thrown");
+				Datum unknown;
+				Assert::ExpectException<runtime_error>([&unknown, &buffer] { unknown.ToChars(buffer, sizeof(buffer)); }, L"Expected an exception but none was thrown");
+			}
+		}
+
+		TEST_METHOD(TestTypedRef)
+		{
+			{
+				Datum datum = { 1, 2, 3 };
+				TypedDatumRef<int> integers = datum.TypedRef<int>();
+				Assert::AreEqual(3_z, integers.Size());
+				Assert::IsFalse(integers.IsEmpty());
+				Assert::IsTrue(&datum == &integers.GetDatum());
+				Assert::AreEqual(1, integers.Front());
+				Assert::AreEqual(3, integers.Back());
+
+				integers[1] = 20;
+				Assert::AreEqual(20, datum.GetInteger(1));
+
+				// The handle follows the datum when it reallocates
+				for (int i = 0; i < 20; ++i)
+				{
+					datum.PushBack(i);
+				}
+				Assert::AreEqual(23_z, integers.Size());
+				Assert::AreEqual(19, integers.Back());
+
+				int sum = 0;
+				for (int value : integers)
+				{
+					sum += value;
+				}
+				Assert::AreEqual(1 + 20 + 3 + 190, sum);
+
+				const Datum& constDatum = datum;
+				TypedDatumRef<const int> constIntegers = constDatum.TypedRef<int>();
+				Assert::AreEqual(20, constIntegers[1]);
+
+				Assert::ExpectException<runtime_error>([&datum] { datum.TypedRef<float>(); }, L"Expected an exception but none was thrown");
+				Datum unknown;
+				Assert::ExpectException<runtime_error>([&unknown] { unknown.TypedRef<int>(); }, L"Expected an exception but none was thrown");
+			}
+
+			{
+				Datum datum = "Hello"s;
+				TypedDatumRef<string> strings = datum.TypedRef<string>();
+				strings.Front() += " World"s;
+				Assert::AreEqual("Hello World"s, datum.GetString());
+
+				Foo foo;
+				Datum pointers = &foo;
+				Assert::IsTrue(&foo == pointers.TypedRef<RTTI*>().Front());
+
+				Datum vectors = vec4(1.0f);
+				vectors.TypedRef<vec4>()[0].x = 5.0f;
+				Assert::IsTrue(vec4(5.0f, 1.0f, 1.0f, 1.0f) == vectors.GetVector());
+			}
+		}
 
 	private:
 		static _CrtMemState _startMemState; // or static inline and no extra declaration
@@ -4,10 +4,13 @@
 #include <crtdbg.h>
 #include <exception>
 #include <string>
+#include <string_view>
 #include <string.h>
 
 #include "Foo.h"
 #include "DefaultHash.h"
+#include "HashMap.h"
+#include "RTTI.h"
 #include "ToStringSpecialization.h"
 #include "SizeLiteral.h"
 
@@ -121,6 +124,68 @@ namespace UnitTestLibraryDesktop
 			Assert::AreEqual(hashFunctor(a), hashFunctor(c));
 		}
 
+		TEST_METHOD(TestStringViewHash)
+		{
+			string a = "Hello"s;
+			string_view b = "World"sv;
+			string_view c(a);
+			DefaultHash<string_view> hashFunctor;
+			DefaultHash<string> stringHashFunctor;
+
+			Assert::AreEqual(hashFunctor(a), hashFunctor(c));
+			Assert::AreNotEqual(hashFunctor(a), hashFunctor(b));
+			Assert::AreEqual(stringHashFunctor(a), hashFunctor(c));
+			Assert::AreEqual(stringHashFunctor("World"s), hashFunctor(b));
+		}
+
+		TEST_METHOD(TestPointerHash)
+		{
+			Foo foos[2]{ Foo(10), Foo(20) };
+			DefaultHash<Foo*> hashFunctor;
+			DefaultHash<RTTI::IdType> idHashFunctor;
+
+			Assert::AreEqual(hashFunctor(&foos[0]), hashFunctor(&foos[0]));
+			Assert::AreNotEqual(hashFunctor(&foos[0]), hashFunctor(&foos[1]));
+			Assert::AreNotEqual(idHashFunctor(1_z), idHashFunctor(2_z));
+			Assert::AreNotEqual(idHashFunctor(1_z) % 16_z, idHashFunctor(17_z) % 16_z);
+		}
+
+		TEST_METHOD(TestAnagramHash)
+		{
+			DefaultHash<string> hashFunctor;
+
+			Assert::AreNotEqual(hashFunctor("Health"s), hashFunctor("Htlaeh"s));
+			Assert::AreNotEqual(hashFunctor("Then"s), hashFunctor("Hent"s));
+			Assert::AreNotEqual(hashFunctor("AB"s), hashFunctor("BA"s));
+			Assert::AreNotEqual(hashFunctor(""s), hashFunctor(string(1, '\0')));
+		}
+
+		TEST_METHOD(TestAttributeNameCollisions)
+		{
+			const string names[] = { "this"s, "Name"s, "Children"s, "Actions"s, "Target"s, "Step"s, "Condition"s, "Then"s, "Else"s,
+				"Expression"s, "Delay"s, "SubType"s, "HitPoints"s, "Health"s, "Htlaeh"s, "NestedScope"s, "NestedScopeArray"s,
+				"ExternalInteger"s, "ExternalIntegerArray"s, "ExternalFloat"s, "ExternalFloatArray"s, "ExternalString"s,
+				"ExternalStringArray"s, "ExternalVector"s, "ExternalVectorArray"s, "ExternalMatrix"s, "ExternalMatrixArray"s,
+				"Entity"s, "ActionList"s, "ActionIf"s, "ActionIncrement"s, "ActionExpression"s, "ActionCreateAction"s,
+				"ActionDestroyAction"s, "ActionEvent"s, "ReactionAttributed"s, "EventMessageAttributed"s, "AttributedFoo"s, "Avatar"s };
+			DefaultHash<string> hashFunctor;
+
+			HashMap<size_t, string> hashes;
+			for (const string& name : names)
+			{
+				auto [it, wasInserted] = hashes.Insert(make_pair(hashFunctor(name), name));
+				Assert::IsTrue(wasInserted, ToString(name + " collides with " + it->second).c_str());
+			}
+
+			HashMap<string, size_t> attributes;
+			attributes.Reserve(4096_z);
+			for (size_t i = 0_z; i < 4096_z; ++i)
+			{
+				attributes.Insert(make_pair(names[i % size(names)] + to_string(i), i));
+			}
+			Assert::IsTrue(attributes.MaxBucketLength() <= 10_z);
+		}
+
 	private:
 		static _CrtMemState _startMemState; // or static inline and no extra declaration
 	};
@@ -0,0 +1,187 @@
+#include "pch.h"
+
+#include <CppUnitTest.h>
+#include <crtdbg.h>
+#include <exception>
+#include <string>
+
+#include "Foo.h"
+#include "FlatHashMap.h"
+#include "ToStringSpecialization.h"
+#include "SizeLiteral.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace UnitTests;
+using namespace FieaGameEngine;
+using namespace std;
+using namespace std::string_literals;
+
+namespace UnitTestLibraryDesktop
+{
+	TEST_CLASS(FlatHashMapTest)
+	{
+	public:
+
+		TEST_METHOD_INITIALIZE(Initialize)
+		{
+#ifdef _DEBUG
+			_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF);
+			_CrtMemCheckpoint(&_startMemState);
+#endif
+		}
+
+		TEST_METHOD_CLEANUP(CleanUp)
+		{
+#ifdef _DEBUG
+			_CrtMemState endMemState, diffMemState;
+			_CrtMemCheckpoint(&endMemState);
+			if (_CrtMemDifference(&diffMemState, &_startMemState, &endMemState)) {
+				_CrtMemDumpStatistics(&diffMemState);
+				Assert::Fail(L"Memory Leaks!");
+			}
+#endif
+		}
+
+		TEST_METHOD(TestConstructor)
+		{
+			FlatHashMap<int, string> map;
+			Assert::IsTrue(map.IsEmpty());
+			Assert::AreEqual(0_z, map.Size());
+			Assert::AreEqual(0_z, map.BucketSize() % 16_z);
+			Assert::IsTrue(map.begin() == map.end());
+
+			Assert::ExpectException<exception>([] { FlatHashMap<int, string> zeroMap(0_z); }, L"Expected an exception but none was thrown");
+
+			FlatHashMap<string, int> listMap{ { "A"s, 1 }, { "B"s, 2 }, { "C"s, 3 } };
+			Assert::AreEqual(3_z, listMap.Size());
+			Assert::AreEqual(2, listMap.At("B"s));
+		}
+
+		TEST_METHOD(TestInsertFindRemove)
+		{
+			FlatHashMap<int, int> map(4_z);
+			const size_t initialBucketSize = map.BucketSize();
+
+			for (int i = 0; i < 1000; ++i)
+			{
+				auto [it, wasInserted] = map.Insert(make_pair(i, i * 2));
+				Assert::IsTrue(wasInserted);
+				Assert::AreEqual(i, it->first);
+			}
+			Assert::AreEqual(1000_z, map.Size());
+			Assert::IsTrue(map.BucketSize() > initialBucketSize);
+
+			auto [it, wasInserted] = map.Insert(make_pair(10, 0));
+			Assert::IsFalse(wasInserted);
+			Assert::AreEqual(20, it->second);
+
+			for (int i = 0; i < 1000; ++i)
+			{
+				Assert::IsTrue(map.ContainsKey(i));
+				Assert::AreEqual(i * 2, map.Find(i)->second);
+			}
+			Assert::IsTrue(map.Find(1000) == map.end());
+
+			for (int i = 0; i < 1000; i += 2)
+			{
+				map.Remove(i);
+			}
+			map.Remove(1000);
+			Assert::AreEqual(500_z, map.Size());
+
+			for (int i = 0; i < 1000; ++i)
+			{
+				Assert::AreEqual(i % 2 != 0, map.ContainsKey(i));
+			}
+
+			size_t count = 0_z;
+			for (const auto& [key, value] : map)
+			{
+				Assert::AreEqual(key * 2, value);
+				++count;
+			}
+			Assert::AreEqual(map.Size(), count);
+
+			map.Clear();
+			Assert::IsTrue(map.IsEmpty());
+			Assert::IsTrue(map.begin() == map.end());
+		}
+
+		TEST_METHOD(TestReuseOfDeletedSlots)
+		{
+			FlatHashMap<int, int> map(16_z);
+			const size_t bucketSize = map.BucketSize();
+
+			for (int round = 0; round < 100; ++round)
+			{
+				for (int i = 0; i < 8; ++i)
+				{
+					map.Insert(make_pair(round * 8 + i, round));
+				}
+				for (int i = 0; i < 8; ++i)
+				{
+					map.Remove(round * 8 + i);
+				}
+			}
+
+			Assert::IsTrue(map.IsEmpty());
+			Assert::AreEqual(bucketSize, map.BucketSize());
+		}
+
+		TEST_METHOD(TestAccessors)
+		{
+			FlatHashMap<string, Foo> map;
+			map["Hello"s] = Foo(10);
+			Assert::AreEqual(Foo(10), map.At("Hello"s));
+			map["World"s];
+			Assert::IsTrue(map.ContainsKey("World"s));
+			Assert::AreEqual(2_z, map.Size());
+
+			const FlatHashMap<string, Foo>& constMap = map;
+			Assert::AreEqual(Foo(10), constMap.At("Hello"s));
+			Assert::IsTrue(constMap.Find("Missing"s) == constMap.end());
+			Assert::ExpectException<exception>([&map] { map.At("Missing"s); }, L"Expected an exception but none was thrown");
+			Assert::ExpectException<exception>([&constMap] { constMap.At("Missing"s); }, L"Expected an exception but none was thrown");
+
+			FlatHashMap<string, Foo>::Iterator it;
+			Assert::ExpectException<exception>([&it] { *it; }, L"Expected an exception but none was thrown");
+			Assert::ExpectException<exception>([&it] { ++it; }, L"Expected an exception but none was thrown");
+			Assert::ExpectException<exception>([&map] { *map.end(); }, L"Expected an exception but none was thrown");
+		}
+
+		TEST_METHOD(TestCopyMoveResize)
+		{
+			FlatHashMap<string, Foo> map;
+			for (int i = 0; i < 100; ++i)
+			{
+				map.Insert(make_pair(to_string(i), Foo(i)));
+			}
+
+			FlatHashMap<string, Foo> copy(map);
+			Assert::AreEqual(map.Size(), copy.Size());
+			for (int i = 0; i < 100; ++i)
+			{
+				Assert::AreEqual(Foo(i), copy.At(to_string(i)));
+			}
+
+			FlatHashMap<string, Foo> moved(std::move(copy));
+			Assert::AreEqual(100_z, moved.Size());
+			Assert::AreEqual(0_z, copy.Size());
+
+			FlatHashMap<string, Foo> assigned;
+			assigned = moved;
+			assigned.Resize(1000_z);
+			Assert::IsTrue(assigned.BucketSize() >= 1000_z);
+			for (int i = 0; i < 100; ++i)
+			{
+				Assert::AreEqual(Foo(i), assigned.At(to_string(i)));
+			}
+			Assert::ExpectException<exception>([&assigned] { assigned.Resize(0_z); }, L"Expected an exception but none was thrown");
+		}
+
+	private:
+		static _CrtMemState _startMemState;
+	};
+
+	_CrtMemState FlatHashMapTest::_startMemState;
+}
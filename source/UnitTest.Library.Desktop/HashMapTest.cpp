@@ -0,0 +1,348 @@
+#include "pch.h"
+
+#include <CppUnitTest.h>
+#include <algorithm>
+#include <cctype>
+#include <crtdbg.h>
+#include <exception>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+#include "Foo.h"
+#include "FlatHashMap.h"
+#include "HashMap.h"
+#include "ToStringSpecialization.h"
+#include "SizeLiteral.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace UnitTests;
+using namespace FieaGameEngine;
+using namespace std;
+using namespace std::string_literals;
+
+namespace UnitTestLibraryDesktop
+{
+	TEST_CLASS(HashMapTest)
+	{
+	public:
+
+		TEST_METHOD_INITIALIZE(Initialize)
+		{
+#ifdef _DEBUG
+			_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF);
+			_CrtMemCheckpoint(&_startMemState);
+#endif
+		}
+
+		TEST_METHOD_CLEANUP(CleanUp)
+		{
+#ifdef _DEBUG
+			_CrtMemState endMemState, diffMemState;
+			_CrtMemCheckpoint(&endMemState);
+			if (_CrtMemDifference(&diffMemState, &_startMemState, &endMemState)) {
+				_CrtMemDumpStatistics(&diffMemState);
+				Assert::Fail(L"Memory Leaks!");
+			}
+#endif
+		}
+
+		TEST_METHOD(TestLoadFactorGrowth)
+		{
+			HashMap<string, Foo> map;
+			Assert::AreEqual(11_z, map.BucketSize());
+			Assert::AreEqual(1.0f, map.MaxLoadFactor());
+
+			Vector<HashMap<string, Foo>::PairType*> entries;
+			for (int i = 0; i < 1000; ++i)
+			{
+				auto [it, wasInserted] = map.Insert(make_pair(to_string(i), Foo(i)));
+				Assert::IsTrue(wasInserted);
+				entries.PushBack(&*it);
+				Assert::IsTrue(map.LoadFactor() <= map.MaxLoadFactor());
+			}
+
+			Assert::AreEqual(1000_z, map.Size());
+			Assert::IsTrue(map.BucketSize() >= 1000_z);
+			Assert::IsTrue(map.MaxBucketLength() < 10_z);
+
+			for (int i = 0; i < 1000; ++i)
+			{
+				Assert::IsTrue(entries[i] == &*map.Find(to_string(i)));
+				Assert::AreEqual(Foo(i), map.At(to_string(i)));
+			}
+
+			Assert::ExpectException<exception>([&map] { map.SetMaxLoadFactor(0.0f); }, L"Expected an exception but none was thrown");
+			Assert::ExpectException<exception>([&map] { map.Resize(0_z); }, L"Expected an exception but none was thrown");
+		}
+
+		TEST_METHOD(TestGrowthPolicy)
+		{
+			HashMap<int, int> map(4_z);
+			map.SetMaxLoadFactor(2.0f);
+			map.SetIncrementFunctor([](size_t /*size*/, size_t /*bucketSize*/) { return 4_z; });
+
+			for (int i = 0; i < 8; ++i)
+			{
+				map.Insert(make_pair(i, i));
+			}
+			Assert::AreEqual(4_z, map.BucketSize());
+			Assert::AreEqual(2.0f, map.LoadFactor());
+
+			map.Insert(make_pair(8, 8));
+			Assert::AreEqual(8_z, map.BucketSize());
+			Assert::AreEqual(9_z, map.Size());
+		}
+
+		TEST_METHOD(TestReserve)
+		{
+			HashMap<int, int> map;
+			map.Reserve(500_z);
+			const size_t bucketSize = map.BucketSize();
+			Assert::IsTrue(bucketSize >= 500_z);
+
+			for (int i = 0; i < 500; ++i)
+			{
+				map.Insert(make_pair(i, i));
+			}
+			Assert::AreEqual(bucketSize, map.BucketSize());
+
+			map.Reserve(10_z);
+			Assert::AreEqual(bucketSize, map.BucketSize());
+		}
+
+		TEST_METHOD(TestFunctorPolicies)
+		{
+			struct CaseInsensitiveHash final
+			{
+				size_t operator()(const string& key) const
+				{
+					size_t hash = 0_z;
+					for (char c : key)
+					{
+						hash = hash * 31_z + static_cast<size_t>(tolower(static_cast<unsigned char>(c)));
+					}
+					return hash;
+				}
+			};
+			struct CaseInsensitiveEquality final
+			{
+				bool operator()(const string& lhs, const string& rhs) const
+				{
+					return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), [](char a, char b)
+						{
+							return tolower(static_cast<unsigned char>(a)) == tolower(static_cast<unsigned char>(b));
+						});
+				}
+			};
+
+			HashMap<string, int, CaseInsensitiveHash, CaseInsensitiveEquality> map;
+			Assert::IsTrue(map.Insert(make_pair("Health"s, 1)).second);
+			Assert::IsFalse(map.Insert(make_pair("HEALTH"s, 2)).second);
+			Assert::AreEqual(1, map.At("health"s));
+			map.Remove("hEaLtH"s);
+			Assert::IsTrue(map.IsEmpty());
+
+			FlatHashMap<string, int, CaseInsensitiveHash, CaseInsensitiveEquality> flatMap;
+			flatMap["Mana"s] = 5;
+			Assert::IsTrue(flatMap.ContainsKey("MANA"s));
+			Assert::AreEqual(1_z, flatMap.Size());
+
+			// Runtime functors are opt in, and default to DefaultHash and DefaultEquality
+			DynamicHashMap<int, int> dynamicMap;
+			dynamicMap.Insert(make_pair(1, 1));
+			Assert::IsTrue(dynamicMap.ContainsKey(1));
+
+			DynamicHashMap<int, int> parityMap(4_z, [](const int& key) { return static_cast<size_t>(key % 2); }, [](const int& lhs, const int& rhs) { return lhs == rhs; });
+			for (int i = 0; i < 10; ++i)
+			{
+				parityMap.Insert(make_pair(i, i));
+			}
+			Assert::AreEqual(10_z, parityMap.Size());
+			Assert::AreEqual(7, parityMap.At(7));
+
+			DynamicHashMap<int, int> copy(parityMap);
+			Assert::AreEqual(3, copy.At(3));
+
+			Assert::IsTrue(sizeof(HashMap<int, int>) < sizeof(DynamicHashMap<int, int>));
+		}
+
+		TEST_METHOD(TestHeterogeneousLookup)
+		{
+			HashMap<string, int> map{ { "Health"s, 100 }, { "Mana"s, 50 } };
+			const string_view text = "Health Mana Stamina"sv;
+
+			Assert::IsTrue(map.Find(text.substr(0, 6)) != map.end());
+			Assert::AreEqual(50, map.At(text.substr(7, 4)));
+			Assert::IsFalse(map.ContainsKey(text.substr(12)));
+			Assert::IsTrue(map.ContainsKey("Mana"));
+			const HashMap<string, int>& constMap = map;
+			Assert::AreEqual(100, constMap.At("Health"));
+			Assert::IsTrue(constMap.Find("Stamina"sv) == constMap.end());
+			Assert::ExpectException<runtime_error>([&map] { map.At("Stamina"); }, L"Expected an exception but none was thrown");
+			map.Remove("Mana"sv);
+			Assert::AreEqual(1_z, map.Size());
+
+			// string_view keys hash the same way as std::string keys
+			Assert::AreEqual(DefaultHash<string>{}("Health"s), DefaultHash<string>{}("Health"sv));
+
+			FlatHashMap<string, int> flatMap{ { "Health"s, 100 }, { "Mana"s, 50 } };
+			Assert::AreEqual(100, flatMap.Find("Health")->second);
+			Assert::AreEqual(50, flatMap.At(text.substr(7, 4)));
+			Assert::IsFalse(flatMap.ContainsKey("Stamina"sv));
+			flatMap.Remove("Health");
+			Assert::IsFalse(flatMap.ContainsKey("Health"));
+			Assert::AreEqual(1_z, flatMap.Size());
+		}
+
+		TEST_METHOD(TestEmplace)
+		{
+			struct Counted final
+			{
+				Counted(int value, int& copies) : Value(value), Copies(&copies) { }
+				Counted(const Counted& other) : Value(other.Value), Copies(other.Copies) { ++*Copies; }
+				Counted(Counted&&) noexcept = default;
+				Counted& operator=(const Counted&) = default;
+				Counted& operator=(Counted&&) noexcept = default;
+				~Counted() = default;
+
+				int Value;
+				int* Copies;
+			};
+			int copies = 0;
+
+			HashMap<string, Counted> map;
+			auto [it, wasInserted] = map.TryEmplace("A"s, 1, copies);
+			Assert::IsTrue(wasInserted);
+			Assert::AreEqual(1, it->second.Value);
+
+			// A key that is already there is not moved from
+			string key = "A"s;
+			Assert::IsFalse(map.TryEmplace(std::move(key), 2, copies).second);
+			Assert::AreEqual("A"s, key);
+			Assert::AreEqual(1, map.At("A"s).Value);
+
+			Assert::IsTrue(map.Emplace(piecewise_construct, forward_as_tuple("B"s), forward_as_tuple(2, copies)).second);
+			Assert::IsFalse(map.Emplace("B"s, Counted(5, copies)).second);
+			Assert::AreEqual(2, map.At("B"s).Value);
+
+			for (int i = 0; i < 100; ++i)
+			{
+				map.TryEmplace(to_string(i), i, copies);
+			}
+			Assert::AreEqual(102_z, map.Size());
+			Assert::AreEqual(42, map.At("42"s).Value);
+
+			HashMap<string, int> counts;
+			++counts["A"s];
+			++counts["A"s];
+			Assert::AreEqual(2, counts.At("A"s));
+
+			FlatHashMap<string, Counted> flatMap;
+			Assert::IsTrue(flatMap.TryEmplace("A"s, 1, copies).second);
+			Assert::IsTrue(flatMap.Emplace("B"s, Counted(2, copies)).second);
+			Assert::IsFalse(flatMap.TryEmplace("B"s, 3, copies).second);
+			for (int i = 0; i < 100; ++i)
+			{
+				flatMap.TryEmplace(to_string(i), i, copies);
+			}
+			Assert::AreEqual(102_z, flatMap.Size());
+			Assert::AreEqual(2, flatMap.At("B"s).Value);
+
+			Vector<Counted> vector;
+			for (int i = 0; i < 10; ++i)
+			{
+				Assert::AreEqual(i, vector.EmplaceBack(i, copies)->Value);
+			}
+			Assert::AreEqual(10_z, vector.Size());
+
+			SList<Counted> list;
+			list.EmplaceBack(2, copies);
+			list.EmplaceFront(1, copies);
+			list.EmplaceBack(3, copies);
+			Assert::AreEqual(1, list.Front().Value);
+			Assert::AreEqual(3, list.Back().Value);
+
+			// Nothing above copied a value
+			Assert::AreEqual(0, copies);
+		}
+
+		TEST_METHOD(TestIncrementalRehash)
+		{
+			HashMap<int, int> map(8_z);
+			map.SetRehashStep(2_z);
+			Assert::AreEqual(2_z, map.RehashStep());
+			for (int i = 0; i < 8; ++i)
+			{
+				map.Insert(make_pair(i, i * 10));
+			}
+			Assert::IsFalse(map.IsRehashing());
+			int* value = &map.At(3);
+
+			// Growing only allocates the new buckets, the entries follow a few buckets at a time
+			map.Insert(make_pair(8, 80));
+			Assert::AreEqual(16_z, map.BucketSize());
+			Assert::IsTrue(map.IsRehashing());
+			const HashMap<int, int>& constMap = map;
+			for (int i = 0; i <= 8; ++i)
+			{
+				Assert::AreEqual(i * 10, constMap.At(i));
+			}
+			size_t count = 0_z;
+			for (const auto& [key, entry] : constMap)
+			{
+				Assert::AreEqual(key * 10, entry);
+				++count;
+			}
+			Assert::AreEqual(9_z, count);
+
+			map.Remove(5);
+			Assert::IsFalse(map.ContainsKey(5));
+			Assert::IsTrue(map.Find(2) != map.end());
+			Assert::IsTrue(map.Find(9) == map.end());
+			Assert::IsTrue(map.IsRehashing());
+			Assert::AreEqual(80, map.At(8));
+			Assert::IsFalse(map.IsRehashing());
+			Assert::IsTrue(value == &map.At(3));
+			Assert::AreEqual(8_z, map.Size());
+			Assert::AreEqual(1_z, map.MaxBucketLength());
+
+			// Resizing again while rehashing waits for the first rehash, which keeps moving a few buckets at a time
+			map.Resize(32_z);
+			Assert::IsTrue(map.IsRehashing());
+			map.Resize(7_z);
+			Assert::AreEqual(32_z, map.BucketSize());
+			const auto end = map.end();
+			for (int i = 0; i <= 8; ++i)
+			{
+				Assert::AreEqual(i != 5, map.Find(i) != end);
+			}
+			Assert::AreEqual(7_z, map.BucketSize());
+			Assert::IsTrue(map.IsRehashing());
+			Assert::IsTrue(map.Find(9) == end);
+			map.FinishRehash();
+			Assert::IsFalse(map.IsRehashing());
+			for (int i = 0; i <= 8; ++i)
+			{
+				Assert::AreEqual(i != 5, map.ContainsKey(i));
+			}
+
+			HashMap<int, int> moved = std::move(map);
+			moved.Resize(64_z);
+			moved.Clear();
+			Assert::IsFalse(moved.IsRehashing());
+			Assert::IsTrue(moved.begin() == moved.end());
+
+			moved.Resize(16_z);
+			moved[1] = 10;
+			moved.SetRehashStep(0_z);
+			Assert::IsFalse(moved.IsRehashing());
+			Assert::AreEqual(10, moved.At(1));
+		}
+
+	private:
+		static _CrtMemState _startMemState;
+	};
+
+	_CrtMemState HashMapTest::_startMemState;
+}
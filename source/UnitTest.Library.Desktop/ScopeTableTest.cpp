@@ -0,0 +1,126 @@
+#include "pch.h"
+
+#include <CppUnitTest.h>
+#include <crtdbg.h>
+#include <exception>
+#include <string>
+
+#include "ScopeTable.h"
+#include "Scope.h"
+#include "ToStringSpecialization.h"
+#include "SizeLiteral.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace UnitTests;
+using namespace FieaGameEngine;
+using namespace std;
+using namespace std::string_literals;
+
+namespace UnitTestLibraryDesktop
+{
+	TEST_CLASS(ScopeTableTest)
+	{
+	public:
+
+		TEST_METHOD_INITIALIZE(Initialize)
+		{
+#ifdef _DEBUG
+			_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF);
+			_CrtMemCheckpoint(&_startMemState);
+#endif
+		}
+
+		TEST_METHOD_CLEANUP(CleanUp)
+		{
+#ifdef _DEBUG
+			_CrtMemState endMemState, diffMemState;
+			_CrtMemCheckpoint(&endMemState);
+			if (_CrtMemDifference(&diffMemState, &_startMemState, &endMemState)) {
+				_CrtMemDumpStatistics(&diffMemState);
+				Assert::Fail(L"Memory Leaks!");
+			}
+#endif
+		}
+
+		TEST_METHOD(TestInsertFindIterate)
+		{
+			ScopeTable table;
+			Assert::IsTrue(table.IsEmpty());
+			Assert::IsTrue(table.begin() == table.end());
+			Assert::IsNull(table.Find(Symbol("A"s)));
+
+			// Enough entries to span several blocks and to build the index
+			const size_t count = 200_z;
+			for (size_t i = 0_z; i < count; ++i)
+			{
+				auto [entry, wasInserted] = table.Insert(Symbol(to_string(i)));
+				Assert::IsTrue(wasInserted);
+				entry->second = static_cast<int>(i);
+			}
+			Assert::AreEqual(count, table.Size());
+
+			auto [entry, wasInserted] = table.Insert(Symbol("42"s));
+			Assert::IsFalse(wasInserted);
+			Assert::IsTrue(entry == &table[42]);
+
+			size_t position = 0_z;
+			for (const auto& [name, datum] : table)
+			{
+				Assert::AreEqual(to_string(position), name.Name());
+				Assert::AreEqual(static_cast<int>(position), datum.GetInteger());
+				Assert::IsTrue(table.Find(name) == &table[position]);
+				++position;
+			}
+			Assert::AreEqual(count, position);
+			Assert::IsNull(table.Find(Symbol("Missing"s)));
+
+			table.Clear();
+			Assert::IsTrue(table.IsEmpty());
+			Assert::IsNull(table.Find(Symbol("42"s)));
+			table.Insert(Symbol("42"s));
+			Assert::AreEqual(1_z, table.Size());
+
+			auto it = table.end();
+			Assert::ExpectException<exception>([&it] { *it; }, L"Expected an exception but none was thrown");
+		}
+
+		TEST_METHOD(TestStableEntries)
+		{
+			ScopeTable table(3_z);
+			ScopeTable::PairType* first = table.Insert(Symbol("First"s)).first;
+			Datum* firstDatum = &first->second;
+			for (size_t i = 0_z; i < 100_z; ++i)
+			{
+				table.Insert(Symbol(to_string(i)));
+			}
+			Assert::IsTrue(first == table.Find(Symbol("First"s)));
+			Assert::IsTrue(firstDatum == &table[0].second);
+
+			// Moving keeps the entries where they are
+			ScopeTable moved(std::move(table));
+			Assert::AreEqual(0_z, table.Size());
+			Assert::AreEqual(101_z, moved.Size());
+			Assert::IsTrue(firstDatum == &moved.Find(Symbol("First"s))->second);
+
+			table = std::move(moved);
+			Assert::AreEqual(101_z, table.Size());
+
+			// Scopes keep handing out the same Datums while they grow
+			Scope scope;
+			Datum& a = scope.Append("A"s);
+			for (size_t i = 0_z; i < 100_z; ++i)
+			{
+				scope.Append(to_string(i)) = static_cast<int>(i);
+			}
+			Assert::IsTrue(&a == scope.Find("A"s));
+			Assert::IsTrue(&a == &scope[0]);
+			Assert::AreEqual(99, scope[100].GetInteger());
+			Assert::ExpectException<out_of_range>([&scope] { scope[101]; }, L"Expected an exception but none was thrown");
+		}
+
+	private:
+		static _CrtMemState _startMemState;
+	};
+
+	_CrtMemState ScopeTableTest::_startMemState;
+}
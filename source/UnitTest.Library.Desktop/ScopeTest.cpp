@@ -0,0 +1,303 @@
+#include "pch.h"
+
+#include <CppUnitTest.h>
+#include <crtdbg.h>
+#include <exception>
+#include <string>
+
+#include "Scope.h"
+#include "ThreadPool.h"
+#include "Vector.h"
+#include "ToStringSpecialization.h"
+#include "SizeLiteral.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace UnitTests;
+using namespace FieaGameEngine;
+using namespace std;
+using namespace std::string_literals;
+
+namespace UnitTestLibraryDesktop
+{
+	TEST_CLASS(ScopeTest)
+	{
+	public:
+
+		TEST_METHOD_INITIALIZE(Initialize)
+		{
+#ifdef _DEBUG
+			_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF);
+			_CrtMemCheckpoint(&_startMemState);
+#endif
+		}
+
+		TEST_METHOD_CLEANUP(CleanUp)
+		{
+#ifdef _DEBUG
+			_CrtMemState endMemState, diffMemState;
+			_CrtMemCheckpoint(&endMemState);
+			if (_CrtMemDifference(&diffMemState, &_startMemState, &endMemState)) {
+				_CrtMemDumpStatistics(&diffMemState);
+				Assert::Fail(L"Memory Leaks!");
+			}
+#endif
+		}
+
+		TEST_METHOD(TestOrphanSwapsLastSibling)
+		{
+			Scope root;
+			Scope& a = root.AppendScope("Children"s);
+			Scope& b = root.AppendScope("Children"s);
+			Scope& c = root.AppendScope("Children"s);
+			Scope& d = root.AppendScope("Children"s);
+			Datum& children = root["Children"s];
+
+			auto [datum, index] = root.FindContainedScope(c);
+			Assert::IsTrue(datum == &children);
+			Assert::AreEqual(2_z, index);
+
+			// The last sibling moves into the orphaned slot
+			b.Orphan();
+			Assert::AreEqual(3_z, children.Size());
+			Assert::IsTrue(&a == &children.GetScope(0));
+			Assert::IsTrue(&d == &children.GetScope(1));
+			Assert::IsTrue(&c == &children.GetScope(2));
+			Assert::IsNull(b.GetParent());
+			Assert::IsNull(root.FindContainedScope(b).first);
+			Assert::AreEqual(1_z, root.FindContainedScope(d).second);
+
+			// Moving a child keeps its slot
+			Scope* moved = new Scope(std::move(d));
+			delete &d;
+			Assert::IsTrue(moved == &children.GetScope(1));
+			Assert::AreEqual(1_z, root.FindContainedScope(*moved).second);
+			Scope& e = moved->AppendScope("Children"s);
+			Assert::IsTrue(root.FindContainedScope(e).first == nullptr);
+			Assert::AreEqual(0_z, moved->FindContainedScope(e).second);
+
+			// Re-adopting appends at the end
+			root.Adopt(b, "Children"s);
+			Assert::AreEqual(3_z, root.FindContainedScope(b).second);
+			a.Orphan();
+			Assert::IsTrue(&b == &children.GetScope(0));
+			Assert::AreEqual(0_z, root.FindContainedScope(b).second);
+			delete &a;
+
+			// Orphaning the last sibling moves nothing
+			c.Orphan();
+			Assert::AreEqual(2_z, children.Size());
+			Assert::AreEqual(1_z, root.FindContainedScope(*moved).second);
+			delete &c;
+			delete moved;
+			Assert::AreEqual(1_z, children.Size());
+			Assert::IsTrue(&b == &children.GetScope(0));
+
+			Datum strings = { "A"s, "B"s, "C"s };
+			strings.RemoveAtSwap(0);
+			Assert::AreEqual("C"s, strings.GetString(0));
+			Assert::AreEqual("B"s, strings.GetString(1));
+			Assert::ExpectException<out_of_range>([&strings] { strings.RemoveAtSwap(2); }, L"Expected an exception but none was thrown");
+		}
+
+		TEST_METHOD(TestCopyOnWriteCopies)
+		{
+			Scope prefab;
+			prefab["Tags"s] = Datum{ "Enemy"s, "Flying"s, "Boss"s };
+			prefab["Health"s] = Datum{ 100, 90, 80, 70, 60, 50, 40, 30, 20, 10 };
+			prefab["Name"s] = "Dragon"s;
+			const Datum& prefabTags = *prefab.Find("Tags"s);
+
+			Scope first(prefab);
+			Scope second(prefab);
+			Assert::IsTrue(first == prefab);
+			Assert::IsTrue(second == prefab);
+			const Datum& firstTags = *first.Find("Tags"s);
+			const Datum& secondTags = *second.Find("Tags"s);
+			Assert::IsTrue(firstTags.IsShared());
+			Assert::IsTrue(prefabTags.IsShared());
+			Assert::IsTrue(&prefabTags.GetString(0) == &firstTags.GetString(0));
+			Assert::IsTrue(&prefabTags.GetString(0) == &secondTags.GetString(0));
+			Assert::IsTrue(first.Find("Health"s)->IsShared());
+
+			// Writing materializes only the datum written, and only for the writer
+			first["Tags"s].Set("Ghost"s, 1);
+			Assert::IsFalse(firstTags.IsShared());
+			Assert::IsTrue(secondTags.IsShared());
+			Assert::AreEqual("Ghost"s, firstTags.GetString(1));
+			Assert::AreEqual("Flying"s, prefabTags.GetString(1));
+			Assert::AreEqual("Flying"s, secondTags.GetString(1));
+			Assert::IsTrue(first.Find("Health"s)->IsShared());
+			Assert::IsTrue(first != prefab);
+
+			second["Tags"s].PushBack("Minion"s);
+			Assert::AreEqual(4_z, secondTags.Size());
+			Assert::AreEqual(3_z, prefabTags.Size());
+			Assert::IsFalse(prefabTags.IsShared());
+
+			// Values outlive the prototype they were shared from
+			Scope* temporary = new Scope(prefab);
+			Scope third(*temporary);
+			delete temporary;
+			Assert::IsTrue(third == prefab);
+
+			// A buffer a mutable reference was handed out from is copied instead of shared
+			int& health = prefab["Health"s].GetInteger(0);
+			Scope fourth(prefab);
+			Assert::IsFalse(fourth.Find("Health"s)->IsShared());
+			health = 99;
+			Assert::AreEqual(100, fourth["Health"s].GetInteger(0));
+		}
+
+		TEST_METHOD(TestConcurrentCopiesOfOnePrototype)
+		{
+			Scope prefab;
+			prefab["Tags"s] = Datum{ "Enemy"s, "Flying"s, "Boss"s };
+			prefab["Health"s] = Datum{ 100, 90, 80, 70, 60, 50, 40, 30, 20, 10 };
+			prefab.AppendScope("Components"s)["Speeds"s] = Datum{ 1.0f, 2.0f, 3.0f, 4.0f };
+
+			// Every copy races to share the prototype's buffers, which have no shared header yet
+			ThreadPool pool(4_z);
+			Vector<Scope*> copies;
+			copies.Resize(64_z);
+			pool.ParallelFor(copies.Size(), [&prefab, &copies](size_t index)
+			{
+				copies[index] = prefab.Clone();
+			});
+
+			const Datum& prefabTags = *prefab.Find("Tags"s);
+			Assert::IsTrue(prefabTags.IsShared());
+			for (const Scope* copy : copies)
+			{
+				Assert::IsTrue(*copy == prefab);
+				Assert::IsTrue(&copy->Find("Tags"s)->GetString(0) == &prefabTags.GetString(0));
+			}
+
+			// Releasing the copies from several threads leaves the prototype's values intact
+			pool.ParallelFor(copies.Size(), [&copies](size_t index)
+			{
+				if (index % 2_z == 0_z)
+				{
+					(*copies[index])["Tags"s].Set("Ghost"s, 0);
+				}
+				delete copies[index];
+			});
+			Assert::IsFalse(prefabTags.IsShared());
+			Assert::AreEqual("Enemy"s, prefabTags.GetString(0));
+			Assert::AreEqual(3.0f, prefab["Components"s].GetScope()["Speeds"s].GetFloat(2));
+		}
+
+		TEST_METHOD(TestParallelCloneEqualsClear)
+		{
+			ThreadPool pool(4_z);
+			Assert::AreEqual(4_z, pool.ThreadCount());
+			Assert::ExpectException<invalid_argument>([] { ThreadPool empty(0_z); }, L"Expected an exception but none was thrown");
+
+			Scope world;
+			world["Name"s] = "World"s;
+			for (size_t i = 0_z; i < 64_z; ++i)
+			{
+				Scope& entity = world.AppendScope("Entities"s);
+				entity["Id"s] = static_cast<int>(i);
+				entity["Tags"s] = Datum{ "A"s, "B"s, to_string(i) };
+				Scope& component = entity.AppendScope("Components"s);
+				component["Health"s] = static_cast<float>(i);
+			}
+			world.AppendScope("Settings"s)["Gravity"s] = 9.8f;
+
+			gsl::owner<Scope*> clone = world.CloneParallel(pool);
+			Assert::IsTrue(*clone == world);
+			Assert::IsTrue(world.EqualsParallel(*clone, pool));
+			Assert::IsTrue(clone->EqualsParallel(world, pool));
+			Assert::IsTrue(world.EqualsParallel(world, pool));
+
+			Datum& entities = (*clone)["Entities"s];
+			Assert::AreEqual(64_z, entities.Size());
+			for (size_t i = 0_z; i < entities.Size(); ++i)
+			{
+				Scope& entity = entities.GetScope(i);
+				Assert::IsTrue(entity.GetParent() == clone);
+				Assert::IsTrue(&entity != &world["Entities"s].GetScope(i));
+				Assert::AreEqual(i, clone->FindContainedScope(entity).second);
+				Assert::AreEqual(static_cast<int>(i), entity["Id"s].GetInteger());
+			}
+
+			// A difference deep in one subtree is found
+			entities.GetScope(40)["Components"s].GetScope()["Health"s] = -1.0f;
+			Assert::IsFalse(world.EqualsParallel(*clone, pool));
+			Assert::IsFalse(*clone == world);
+
+			(*clone)["Name"s] = "Copy"s;
+			Assert::IsFalse(world.EqualsParallel(*clone, pool));
+
+			pool.ParallelFor(0_z, [](size_t) { Assert::Fail(); });
+			Assert::ExpectException<runtime_error>([&pool] { pool.ParallelFor(8_z, [](size_t index) { if (index == 5_z) throw runtime_error("Failed"); }); }, L"Expected an exception but none was thrown");
+
+			clone->ClearParallel(pool);
+			Assert::IsTrue(clone->IsEmpty());
+			delete clone;
+
+			world.ClearParallel(pool);
+			Assert::IsTrue(world.IsEmpty());
+			Assert::IsNull(world.Find("Settings"s));
+		}
+
+		TEST_METHOD(TestParallelCloneThrows)
+		{
+			// Fails after the Scope part of it has been copied
+			class ThrowingScope final : public Scope
+			{
+			public:
+				ThrowingScope() = default;
+				ThrowingScope(const ThrowingScope& other) :
+					Scope(other)
+				{
+					throw runtime_error("Copy failed");
+				}
+
+				gsl::owner<Scope*> Clone() const override
+				{
+					return new ThrowingScope(*this);
+				}
+			};
+
+			ThreadPool pool(4_z);
+
+			ThrowingScope root;
+			for (size_t i = 0_z; i < 8_z; ++i)
+			{
+				root.AppendScope("Children"s)["Id"s] = static_cast<int>(i);
+			}
+			Assert::ExpectException<runtime_error>([&root, &pool] { gsl::owner<Scope*> clone = root.CloneParallel(pool); delete clone; }, L"Expected an exception but none was thrown");
+
+			Scope world;
+			for (size_t i = 0_z; i < 8_z; ++i)
+			{
+				world.AppendScope("Children"s)["Id"s] = static_cast<int>(i);
+			}
+			gsl::owner<ThrowingScope*> child = new ThrowingScope;
+			(*child)["Id"s] = 8;
+			world.Adopt(*child, "Children"s);
+			Assert::ExpectException<runtime_error>([&world, &pool] { gsl::owner<Scope*> clone = world.CloneParallel(pool); delete clone; }, L"Expected an exception but none was thrown");
+
+			// The failed attempts left the prototype untouched
+			Datum& children = world["Children"s];
+			Assert::AreEqual(9_z, children.Size());
+			Assert::IsTrue(&children.GetScope(8) == child);
+			child->Orphan();
+			delete child;
+
+			gsl::owner<Scope*> clone = world.CloneParallel(pool);
+			Assert::IsTrue(*clone == world);
+			for (size_t i = 0_z; i < 8_z; ++i)
+			{
+				Assert::AreEqual(static_cast<int>(i), (*clone)["Children"s].GetScope(i)["Id"s].GetInteger());
+			}
+			delete clone;
+		}
+
+	private:
+		static _CrtMemState _startMemState;
+	};
+
+	_CrtMemState ScopeTest::_startMemState;
+}
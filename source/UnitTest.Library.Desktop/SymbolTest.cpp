@@ -0,0 +1,113 @@
+#include "pch.h"
+
+#include <CppUnitTest.h>
+#include <crtdbg.h>
+#include <exception>
+#include <string>
+
+#include "Symbol.h"
+#include "Scope.h"
+#include "ToStringSpecialization.h"
+#include "SizeLiteral.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace UnitTests;
+using namespace FieaGameEngine;
+using namespace std;
+using namespace std::string_literals;
+
+namespace UnitTestLibraryDesktop
+{
+	TEST_CLASS(SymbolTest)
+	{
+	public:
+
+		TEST_METHOD_INITIALIZE(Initialize)
+		{
+#ifdef _DEBUG
+			_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF);
+			_CrtMemCheckpoint(&_startMemState);
+#endif
+		}
+
+		TEST_METHOD_CLEANUP(CleanUp)
+		{
+#ifdef _DEBUG
+			_CrtMemState endMemState, diffMemState;
+			_CrtMemCheckpoint(&endMemState);
+			if (_CrtMemDifference(&diffMemState, &_startMemState, &endMemState)) {
+				_CrtMemDumpStatistics(&diffMemState);
+				Assert::Fail(L"Memory Leaks!");
+			}
+#endif
+		}
+
+		TEST_METHOD(TestInterning)
+		{
+			const size_t initialSize = SymbolTable::Size();
+			{
+				Symbol empty;
+				Assert::IsTrue(empty.IsEmpty());
+				Assert::AreEqual(""s, empty.Name());
+				Assert::IsTrue(Symbol(""s).IsEmpty());
+
+				Symbol a("Health"s);
+				Symbol b = SymbolTable::Intern("Health");
+				Symbol c("Mana"s);
+				Assert::IsTrue(a == b);
+				Assert::IsTrue(a != c);
+				Assert::AreEqual(a.Id(), b.Id());
+				Assert::AreEqual("Health"s, a.Name());
+				Assert::AreEqual(initialSize + 2_z, SymbolTable::Size());
+
+				Assert::IsTrue(SymbolTable::Find("Stamina").IsEmpty());
+				Assert::AreEqual(initialSize + 2_z, SymbolTable::Size());
+				Assert::IsTrue(SymbolTable::Find("Mana") == c);
+
+				// Looking up an Id takes no reference
+				Assert::IsTrue(SymbolTable::FindId("Health") == a.Id());
+				Assert::IsTrue(SymbolTable::FindId("Stamina") == 0);
+				Assert::AreEqual(initialSize + 2_z, SymbolTable::Size());
+
+				Symbol copy(a);
+				copy = c;
+				Assert::IsTrue(copy == c);
+				Symbol moved(std::move(copy));
+				Assert::IsTrue(copy.IsEmpty());
+				Assert::IsTrue(moved == c);
+			}
+			Assert::AreEqual(initialSize, SymbolTable::Size());
+		}
+
+		TEST_METHOD(TestScopeLookups)
+		{
+			const size_t initialSize = SymbolTable::Size();
+			{
+				Scope scope;
+				scope["A"s] = 1;
+				Scope& child = scope.AppendScope("Child"s);
+
+				const Symbol a("A"s);
+				Assert::IsTrue(&scope.At(a) == scope.Find("A"s));
+				Assert::IsTrue(child.Search(a) == &scope.At(a));
+				Assert::IsNull(child.Search("Missing"s));
+				Assert::IsNull(child.Find(Symbol()));
+				Assert::ExpectException<invalid_argument>([&scope] { scope.Append(Symbol()); }, L"Expected an exception but none was thrown");
+
+				Scope* foundScope = nullptr;
+				Assert::IsNotNull(child.Search(a, foundScope));
+				Assert::IsTrue(foundScope == &scope);
+				Assert::IsTrue(child.Search("A"s, foundScope) == &scope.At(a));
+				Assert::IsTrue(foundScope == &scope);
+				Assert::IsNull(child.Search("Missing"s, foundScope));
+				Assert::IsNull(foundScope);
+			}
+			Assert::AreEqual(initialSize, SymbolTable::Size());
+		}
+
+	private:
+		static _CrtMemState _startMemState;
+	};
+
+	_CrtMemState SymbolTest::_startMemState;
+}